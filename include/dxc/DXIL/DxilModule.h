@@ -239,6 +239,16 @@ public:
   ShaderFlags m_ShaderFlags;
   void CollectShaderFlagsForModule(ShaderFlags &Flags);
 
+  // Shader flags of a single function. They are collected on first use and
+  // kept until the function is removed, the module state or entry properties
+  // they depend on (validator version, precision and optimization options,
+  // UAVs, subobjects, shader kind, signature elements) change, or they are
+  // invalidated.
+  ShaderFlags GetFunctionShaderFlags(const llvm::Function *F) const;
+  // Passes that change a function body after its flags may have been
+  // collected, that is after DXIL finalization, must call this.
+  void InvalidateFunctionShaderFlags(const llvm::Function *F);
+
   // Check if DxilModule contains multi component UAV Loads.
   // This funciton must be called after unused resources are removed from DxilModule
   bool ModuleHasMulticomponentUAVLoads();
@@ -369,6 +379,10 @@ private:
   // Serialized ViewId state.
   std::vector<unsigned> m_SerializedState;
 
+  // Per-function shader flags.
+  struct FunctionShaderFlagsCache;
+  mutable std::unique_ptr<FunctionShaderFlagsCache> m_pFunctionShaderFlags;
+
   // DXIL metadata serialization/deserialization.
   llvm::MDTuple *EmitDxilResources();
   void LoadDxilResources(const llvm::MDOperand &MDO);
@@ -97,6 +97,7 @@ enum DxilFourCC {
   DFCC_ShaderHash               = DXIL_FOURCC('H', 'A', 'S', 'H'),
   DFCC_ShaderSourceInfo         = DXIL_FOURCC('S', 'R', 'C', 'I'),
   DFCC_CompilerVersion          = DXIL_FOURCC('V', 'E', 'R', 'S'),
+  DFCC_ReflectionTables         = DXIL_FOURCC('R', 'F', 'L', '0'),
 };
 
 #undef DXIL_FOURCC
@@ -13,6 +13,7 @@
 
 #include <functional>
 #include "dxc/DxilContainer/DxilContainer.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
 
 struct IStream;
@@ -30,6 +31,14 @@ class ShaderModel;
 namespace DXIL {
 enum class SignatureKind;
 }
+namespace RDAT {
+struct ReflectionShaderInfo;
+struct ReflectionResourceInfo;
+struct ReflectionCBufferInfo;
+struct ReflectionVariableInfo;
+struct ReflectionTypeInfo;
+struct ReflectionSignatureElement;
+}
 
 class DxilPartWriter {
 public:
@@ -51,6 +60,30 @@ DxilPartWriter *NewFeatureInfoWriter(const DxilModule &M);
 DxilPartWriter *NewPSVWriter(const DxilModule &M, uint32_t PSVVersion = UINT_MAX);
 DxilPartWriter *NewRDATWriter(const DxilModule &M);
 
+// Writes the shader reflection tables (RFL0) part.  Strings and index arrays
+// are pooled; Insert* return the string offset, index array offset or row
+// index that other records use to refer to the inserted value.
+class DxilReflectionTablesWriter : public DxilPartWriter {
+public:
+  virtual ~DxilReflectionTablesWriter() {}
+  virtual uint32_t InsertString(llvm::StringRef Str) = 0;
+  virtual uint32_t InsertIndexArray(llvm::ArrayRef<uint32_t> Indices) = 0;
+  virtual void SetShaderInfo(const RDAT::ReflectionShaderInfo &Info) = 0;
+  virtual uint32_t InsertResource(const RDAT::ReflectionResourceInfo &Info) = 0;
+  virtual uint32_t InsertCBuffer(const RDAT::ReflectionCBufferInfo &Info) = 0;
+  virtual uint32_t InsertVariable(const RDAT::ReflectionVariableInfo &Info) = 0;
+  virtual uint32_t InsertType(const RDAT::ReflectionTypeInfo &Info) = 0;
+  virtual uint32_t InsertSignatureElement(const RDAT::ReflectionSignatureElement &Info) = 0;
+};
+
+DxilReflectionTablesWriter *NewReflectionTablesWriter();
+
+// Fills reflection tables from a reflection module (see
+// StripAndCreateReflectionStream).  Implemented with shader reflection in the
+// HLSL library; returns nullptr for libraries or if reflection fails.
+DxilPartWriter *NewReflectionTablesWriterForModule(llvm::Module *pReflectionM);
+typedef DxilPartWriter *(*ReflectionTablesWriterFactory)(llvm::Module *pReflectionM);
+
 DxilContainerWriter *NewDxilContainerWriter();
 
 // Set validator version to 0,0 (not validated) then re-emit as much reflection metadata as possible.
@@ -70,7 +103,8 @@ void SerializeDxilContainerForModule(hlsl::DxilModule *pModule,
                                      SerializeDxilFlags Flags,
                                      DxilShaderHash *pShaderHashOut = nullptr,
                                      AbstractMemoryStream *pReflectionStreamOut = nullptr,
-                                     AbstractMemoryStream *pRootSigStreamOut = nullptr);
+                                     AbstractMemoryStream *pRootSigStreamOut = nullptr,
+                                     ReflectionTablesWriterFactory pfnReflectionTables = nullptr);
 void SerializeDxilContainerForRootSignature(hlsl::RootSignatureHandle *pRootSigHandle,
                                      AbstractMemoryStream *pStream);
 
@@ -38,6 +38,15 @@ enum class RuntimeDataPartType : uint32_t {
   FunctionTable   = 4,
   RawBytes        = 5,
   SubobjectTable  = 6,
+
+  // Shader reflection tables, only used in the DFCC_ReflectionTables part.
+  // That part shares the RDAT layout, string buffer and index arrays.
+  ReflectionShaderInfo      = 0x100,
+  ReflectionResourceTable   = 0x101,
+  ReflectionCBufferTable    = 0x102,
+  ReflectionVariableTable   = 0x103,
+  ReflectionTypeTable       = 0x104,
+  ReflectionSignatureTable  = 0x105,
 };
 
 enum RuntimeDataVersion {
@@ -609,6 +618,163 @@ public:
   SubobjectTableReader *GetSubobjectTableReader();
 };
 
+//////////////////////////////////
+/// shader reflection tables
+//
+// Records mirror the D3D12 shader reflection descriptions, with strings as
+// string table offsets and references to other records as row indices, so
+// ID3D12ShaderReflection can be served without parsing any bitcode.
+
+// Single row.  Parameter counts give the number of input, output and patch
+// constant rows in the signature table, in that order.
+struct ReflectionShaderInfo {
+  uint32_t Version;
+  uint32_t Creator;                 // offset for string table
+  uint32_t Flags;
+  uint32_t ConstantBuffers;
+  uint32_t BoundResources;
+  uint32_t InputParameters;
+  uint32_t OutputParameters;
+  uint32_t InstructionCount;
+  uint32_t TempRegisterCount;
+  uint32_t TempArrayCount;
+  uint32_t DefCount;
+  uint32_t DclCount;
+  uint32_t TextureNormalInstructions;
+  uint32_t TextureLoadInstructions;
+  uint32_t TextureCompInstructions;
+  uint32_t TextureBiasInstructions;
+  uint32_t TextureGradientInstructions;
+  uint32_t FloatInstructionCount;
+  uint32_t IntInstructionCount;
+  uint32_t UintInstructionCount;
+  uint32_t StaticFlowControlCount;
+  uint32_t DynamicFlowControlCount;
+  uint32_t MacroInstructionCount;
+  uint32_t ArrayInstructionCount;
+  uint32_t CutInstructionCount;
+  uint32_t EmitInstructionCount;
+  uint32_t GSOutputTopology;
+  uint32_t GSMaxOutputVertexCount;
+  uint32_t InputPrimitive;
+  uint32_t PatchConstantParameters;
+  uint32_t GSInstanceCount;
+  uint32_t ControlPoints;
+  uint32_t HSOutputPrimitive;
+  uint32_t HSPartitioning;
+  uint32_t TessellatorDomain;
+  uint32_t BarrierInstructions;
+  uint32_t InterlockedInstructions;
+  uint32_t TextureStoreInstructions;
+  uint32_t GSInputPrimitive;
+  uint32_t NumThreads[3];
+  uint32_t RequiresFlags[2];        // low and high 32 bits
+};
+
+struct ReflectionResourceInfo {
+  uint32_t Name;                    // offset for string table
+  uint32_t Type;                    // D3D_SHADER_INPUT_TYPE
+  uint32_t BindPoint;
+  uint32_t BindCount;
+  uint32_t Flags;
+  uint32_t ReturnType;              // D3D_RESOURCE_RETURN_TYPE
+  uint32_t Dimension;               // D3D_SRV_DIMENSION
+  uint32_t NumSamples;
+  uint32_t Space;
+  uint32_t ID;
+};
+
+struct ReflectionCBufferInfo {
+  uint32_t Name;                    // offset for string table
+  uint32_t Type;                    // D3D_CBUFFER_TYPE
+  uint32_t Variables;
+  uint32_t Size;
+  uint32_t Flags;
+  uint32_t FirstVariable;           // index into variable table
+  uint32_t VariableCount;
+};
+
+struct ReflectionVariableInfo {
+  uint32_t Name;                    // offset for string table
+  uint32_t StartOffset;
+  uint32_t Size;
+  uint32_t Flags;
+  uint32_t StartTexture;
+  uint32_t TextureSize;
+  uint32_t StartSampler;
+  uint32_t SamplerSize;
+  uint32_t Type;                    // index into type table
+};
+
+struct ReflectionTypeInfo {
+  uint32_t Class;                   // D3D_SHADER_VARIABLE_CLASS
+  uint32_t Type;                    // D3D_SHADER_VARIABLE_TYPE
+  uint32_t Rows;
+  uint32_t Columns;
+  uint32_t Elements;
+  uint32_t Members;
+  uint32_t Offset;
+  uint32_t Name;                    // offset for string table
+  uint32_t SizeInCBuffer;
+  uint32_t MemberTypes;             // index to an index table of type indices
+  uint32_t MemberNames;             // index to an index table of string
+                                    // table offsets
+};
+
+struct ReflectionSignatureElement {
+  uint32_t SemanticName;            // offset for string table
+  uint32_t SemanticIndex;
+  uint32_t Register;
+  uint32_t SystemValueType;         // D3D_NAME
+  uint32_t ComponentType;           // D3D_REGISTER_COMPONENT_TYPE
+  uint32_t Mask;
+  uint32_t ReadWriteMask;
+  uint32_t Stream;
+  uint32_t MinPrecision;            // D3D_MIN_PRECISION
+};
+
+// Reads the reflection tables in place; the data must outlive the reader.
+// Accessors return nullptr for out of range rows, strings or index arrays.
+class ReflectionTablesReader {
+private:
+  const char *m_Strings;
+  uint32_t m_StringsSize;
+  const uint32_t *m_Indices;
+  uint32_t m_IndicesCount;
+  TableReader m_ShaderInfo;
+  TableReader m_Resources;
+  TableReader m_CBuffers;
+  TableReader m_Variables;
+  TableReader m_Types;
+  TableReader m_Signature;
+
+public:
+  ReflectionTablesReader();
+  // return true if the data is well formed and has a shader info row.
+  bool InitFromData(const void *pData, size_t size);
+
+  const ReflectionShaderInfo *GetShaderInfo() const {
+    return m_ShaderInfo.Row<ReflectionShaderInfo>(0);
+  }
+  const TableReader &GetResourceTable() const { return m_Resources; }
+  const TableReader &GetCBufferTable() const { return m_CBuffers; }
+  const TableReader &GetVariableTable() const { return m_Variables; }
+  const TableReader &GetTypeTable() const { return m_Types; }
+  const TableReader &GetSignatureTable() const { return m_Signature; }
+
+  const char *GetString(uint32_t offset) const {
+    return offset < m_StringsSize ? m_Strings + offset : nullptr;
+  }
+  // Returns the values of the index array at offset and sets *pCount.
+  const uint32_t *GetIndexArray(uint32_t offset, uint32_t *pCount) const {
+    if (offset >= m_IndicesCount ||
+        m_Indices[offset] > m_IndicesCount - offset - 1)
+      return nullptr;
+    *pCount = m_Indices[offset];
+    return m_Indices + offset + 1;
+  }
+};
+
 //////////////////////////////////
 /// structures for library runtime
 
@@ -183,6 +183,68 @@ SubobjectTableReader *DxilRuntimeData::GetSubobjectTableReader() {
   return &m_SubobjectTableReader;
 }
 
+ReflectionTablesReader::ReflectionTablesReader()
+    : m_Strings(nullptr), m_StringsSize(0), m_Indices(nullptr),
+      m_IndicesCount(0) {}
+
+bool ReflectionTablesReader::InitFromData(const void *pData, size_t size) {
+  if (!pData)
+    return false;
+  try {
+    CheckedReader Reader(pData, size);
+    RuntimeDataHeader Header = Reader.Read<RuntimeDataHeader>();
+    if (Header.Version < RDAT_Version_10)
+      return false;
+    const uint32_t *offsets = Reader.ReadArray<uint32_t>(Header.PartCount);
+    for (uint32_t i = 0; i < Header.PartCount; ++i) {
+      Reader.Advance(offsets[i]);
+      RuntimeDataPartHeader part = Reader.Read<RuntimeDataPartHeader>();
+      CheckedReader PR(Reader.ReadArray<char>(part.Size), part.Size);
+      TableReader *pTable = nullptr;
+      switch (part.Type) {
+      case RuntimeDataPartType::StringBuffer:
+        m_Strings = PR.ReadArray<char>(part.Size);
+        m_StringsSize = part.Size;
+        // Strings must be terminated within the buffer.
+        while (m_StringsSize && m_Strings[m_StringsSize - 1] != '\0')
+          --m_StringsSize;
+        continue;
+      case RuntimeDataPartType::IndexArrays:
+        m_IndicesCount = part.Size / sizeof(uint32_t);
+        m_Indices = PR.ReadArray<uint32_t>(m_IndicesCount);
+        continue;
+      case RuntimeDataPartType::ReflectionShaderInfo:
+        pTable = &m_ShaderInfo;
+        break;
+      case RuntimeDataPartType::ReflectionResourceTable:
+        pTable = &m_Resources;
+        break;
+      case RuntimeDataPartType::ReflectionCBufferTable:
+        pTable = &m_CBuffers;
+        break;
+      case RuntimeDataPartType::ReflectionVariableTable:
+        pTable = &m_Variables;
+        break;
+      case RuntimeDataPartType::ReflectionTypeTable:
+        pTable = &m_Types;
+        break;
+      case RuntimeDataPartType::ReflectionSignatureTable:
+        pTable = &m_Signature;
+        break;
+      default:
+        continue; // Skip unrecognized parts
+      }
+      RuntimeDataTableHeader table = PR.Read<RuntimeDataTableHeader>();
+      size_t tableSize = (size_t)table.RecordCount * table.RecordStride;
+      pTable->Init(PR.ReadArray<char>(tableSize), table.RecordCount,
+                   table.RecordStride);
+    }
+  } catch (CheckedReader::exception e) {
+    return false;
+  }
+  return GetShaderInfo() != nullptr;
+}
+
 }} // hlsl::RDAT
 
 using namespace hlsl;
@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// DxilDebugTrace.h                                                          //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Declares the compact trace encoding written by the PIX debug              //
+// instrumentation pass, and a decoder for it.                               //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace pix_dxil {
+namespace CompactDebugTrace {
+
+// With the "compact" option, the debug instrumentation pass writes one record
+// per executed basic block rather than one per instruction. Instruction
+// numbers, value ordinals and values known at compile time are left out of
+// the trace; the pass lists them per block in its text output instead, and
+// Decode()
+// expands the records back into the steps the per-instruction records hold.
+//
+// Record layout, in dwords:
+//   0: header; Type (bits 8-15) is RecordType and bits 16-31 hold the size
+//      of the record in dwords
+//   1: invocation UID
+//   2: block index
+//   3: index of the first step covered (bits 0-15) and number of steps
+//      covered (bits 16-31)
+//   4 onwards: for each covered step, its value (two dwords for 64-bit
+//      values, none for void steps or constant values), followed by its
+//      value ordinal index if that is only known at run time.
+static constexpr uint32_t RecordType = 250;
+static constexpr uint32_t RecordHeaderDwords = 4;
+// Long blocks are split over several records to keep each one well within
+// the dumping ground at the top of the UAV.
+static constexpr uint32_t MaxRecordDwords = 128;
+// Blocks with more steps than this are split into several table blocks.
+static constexpr uint32_t MaxStepsPerBlock = 0xFFFF;
+
+// These match the types of the per-instruction step records.
+enum StepKind : uint32_t {
+  StepKindVoid = 251,
+  StepKindFloat = 252,
+  StepKindUint32 = 253,
+  StepKindUint64 = 254,
+  StepKindDouble = 255,
+};
+
+inline uint32_t ValueDwords(uint32_t Kind) {
+  switch (Kind) {
+  case StepKindVoid:
+    return 0;
+  case StepKindUint64:
+  case StepKindDouble:
+    return 2;
+  default:
+    return 1;
+  }
+}
+
+struct BlockStep {
+  uint32_t InstNum;
+  uint32_t Kind;
+  // Base in the high 16 bits and index in the low 16 bits, as in the
+  // per-instruction records. Unused for void steps.
+  uint32_t ValueOrdinal;
+  // If set, the index part of ValueOrdinal is read from the trace.
+  bool DynamicOrdinalIndex;
+  // If set, the value is known at compile time and Value holds the bits the
+  // trace would have held; otherwise the value is read from the trace.
+  bool ConstantValue;
+  uint64_t Value;
+};
+typedef std::vector<std::vector<BlockStep>> BlockTable;
+
+// Dwords a step takes up in a record.
+inline uint32_t StepTraceDwords(const BlockStep &S) {
+  return (S.ConstantValue ? 0 : ValueDwords(S.Kind)) +
+         (S.DynamicOrdinalIndex ? 1 : 0);
+}
+
+struct Step {
+  uint32_t UID;
+  uint32_t InstNum;
+  uint32_t Kind;
+  uint64_t Value;
+  uint32_t ValueOrdinal;
+};
+
+// The pass prints the block table between these lines, one step per line as
+// "<block> <instruction number> <kind> <value ordinal> <dynamic index>
+// <constant> <value>".
+static constexpr char BlockTableBegin[] = "Begin - compact debug trace blocks";
+static constexpr char BlockTableEnd[] = "End - compact debug trace blocks";
+
+inline bool ParseBlockTable(const std::string &PassOutput, BlockTable &Blocks) {
+  Blocks.clear();
+  std::istringstream Lines(PassOutput);
+  std::string Line;
+  bool InTable = false;
+  while (std::getline(Lines, Line)) {
+    if (!InTable) {
+      InTable = Line == BlockTableBegin;
+      continue;
+    }
+    if (Line == BlockTableEnd)
+      return true;
+    std::istringstream Fields(Line);
+    uint32_t Block;
+    BlockStep S;
+    unsigned Dynamic, Constant;
+    if (!(Fields >> Block >> S.InstNum >> S.Kind >> S.ValueOrdinal >> Dynamic >>
+          Constant >> S.Value))
+      return false;
+    S.DynamicOrdinalIndex = Dynamic != 0;
+    S.ConstantValue = Constant != 0;
+    if (Block >= Blocks.size())
+      Blocks.resize(Block + 1);
+    Blocks[Block].push_back(S);
+  }
+  return false;
+}
+
+// Expands the compact records in a trace. Invocation start markers and other
+// records are skipped. Returns false if the trace doesn't match the table.
+inline bool Decode(const uint32_t *pTrace, size_t TraceDwords,
+                   const BlockTable &Blocks, std::vector<Step> &Steps) {
+  size_t Pos = 0;
+  while (Pos < TraceDwords) {
+    uint32_t Header = pTrace[Pos];
+    uint32_t Type = (Header >> 8) & 0xFF;
+    if (Type != RecordType) {
+      // Other records size themselves in dwords beyond the header and UID.
+      Pos += 2 + (Header & 0xF);
+      continue;
+    }
+
+    uint32_t SizeDwords = Header >> 16;
+    if (SizeDwords < RecordHeaderDwords || Pos + SizeDwords > TraceDwords)
+      return false;
+    const uint32_t *pRecord = pTrace + Pos;
+    const uint32_t *pEnd = pRecord + SizeDwords;
+    uint32_t UID = pRecord[1];
+    uint32_t Block = pRecord[2];
+    uint32_t FirstStep = pRecord[3] & 0xFFFF;
+    uint32_t StepCount = pRecord[3] >> 16;
+    if (Block >= Blocks.size() ||
+        FirstStep + StepCount > Blocks[Block].size())
+      return false;
+
+    const uint32_t *pValue = pRecord + RecordHeaderDwords;
+    for (uint32_t i = FirstStep; i < FirstStep + StepCount; ++i) {
+      const BlockStep &S = Blocks[Block][i];
+      if (pValue + StepTraceDwords(S) > pEnd)
+        return false;
+      Step Decoded = {UID, S.InstNum, S.Kind, 0, S.ValueOrdinal};
+      if (S.Kind != StepKindVoid) {
+        if (S.ConstantValue) {
+          Decoded.Value = S.Value;
+        } else {
+          Decoded.Value = *pValue++;
+          if (ValueDwords(S.Kind) == 2)
+            Decoded.Value |= (uint64_t)*pValue++ << 32;
+        }
+        if (S.DynamicOrdinalIndex)
+          Decoded.ValueOrdinal =
+              (S.ValueOrdinal & 0xFFFF0000) | (*pValue++ & 0xFFFF);
+      }
+      Steps.push_back(Decoded);
+    }
+    if (pValue != pEnd)
+      return false;
+    Pos += SizeDwords;
+  }
+  return true;
+}
+
+} // namespace CompactDebugTrace
+} // namespace pix_dxil
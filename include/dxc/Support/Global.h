@@ -51,6 +51,13 @@ void DxcCleanupThreadMalloc() throw();
 void DxcSetThreadMallocToDefault() throw();
 void DxcClearThreadMalloc() throw();
 
+// Used by threads the library starts. The C++ runtime frees the state of a
+// std::thread with operator delete after the thread function returns, so the
+// allocator stays set until the thread exits; it must be the allocator that
+// was current when the thread was started. It is not reference counted, and
+// must outlive the thread.
+void DxcSetWorkerThreadMalloc(IMalloc *pMalloc) throw();
+
 // Used to retrieve the current invocation's allocator or perform an alloc/free/realloc.
 IMalloc *DxcGetThreadMallocNoRef() throw();
 
@@ -99,6 +99,14 @@ struct RewriterOpts {
   bool WithLineDirective = false;       // OPT_rw_line_directive
 };
 
+/// Validator to use for validating the compiled container.
+enum class ValidatorSelection : int {
+  Auto,     // Use DXIL.dll if available, otherwise the internal validator.
+  Internal, // Validate the in-memory module with the internal validator.
+  External, // Require DXIL.dll.
+  Invalid = -1
+};
+
 /// Use this class to capture all options.
 class DxcOpts {
 public:
@@ -119,6 +127,7 @@ public:
   llvm::StringRef OutputReflectionFile; // OPT_Fre
   llvm::StringRef OutputRootSigFile; // OPT_Frs
   llvm::StringRef OutputShaderHashFile; // OPT_Fsh
+  llvm::StringRef OutputTimeReportFile; // OPT_Ftr
   llvm::StringRef Preprocess; // OPT_P
   llvm::StringRef TargetProfile; // OPT_target_profile
   llvm::StringRef VariableName; // OPT_Vn
@@ -191,7 +200,13 @@ public:
   bool ExportShadersOnly = false; // OPT_export_shaders_only
   bool ResMayAlias = false; // OPT_res_may_alias
   unsigned long ValVerMajor = UINT_MAX, ValVerMinor = UINT_MAX; // OPT_validator_version
+  ValidatorSelection SelectValidator = ValidatorSelection::Auto; // OPT_select_validator
   unsigned ScanLimit = 0; // OPT_memdep_block_scan_limit
+  llvm::StringRef CacheDir; // OPT_cache_dir
+  unsigned CacheMaxSize = 1024; // OPT_cache_max_size, in megabytes
+  bool TimeReport = false; // OPT_ftime_report
+  bool PreambleCache = false; // OPT_preamble_cache
+  bool ArenaAlloc = false; // OPT_arena_alloc
   bool ForceZeroStoreLifetimes = false; // OPT_force_zero_store_lifetimes
   bool EnableLifetimeMarkers = false; // OPT_enable_lifetime_markers
 
@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// WorkerThreads.h                                                           //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Provides a helper to spread independent work items over threads.         //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "dxc/Support/Global.h"
+#include <cstddef>
+#include <functional>
+
+namespace hlsl {
+
+// Calls Work(Index, ThreadIndex) for every Index in [0, Count), on up to
+// ThreadCount threads (0 for one per hardware thread). The calling thread is
+// one of them. Indices are claimed from a shared counter, so a thread that
+// draws cheap items goes on to take more of the rest. ThreadIndex is below
+// ThreadCount and names the thread making the call, for per-thread state.
+//
+// The threads allocate with pMalloc, which must outlive the call. If pMalloc
+// is null, everything runs on the calling thread.
+//
+// If a thread cannot be created, its share of the work is done by the
+// threads that were, so every index is still processed. If Work throws, no
+// further indices are claimed, and the first exception is rethrown on the
+// calling thread once all threads have finished.
+void RunOnWorkerThreads(
+    size_t Count, unsigned ThreadCount, IMalloc *pMalloc,
+    const std::function<void(size_t Index, unsigned ThreadIndex)> &Work);
+
+} // namespace hlsl
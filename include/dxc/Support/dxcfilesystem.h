@@ -14,6 +14,7 @@
 #include "dxc/dxcapi.h"
 #include "llvm/Support/MSFileSystem.h"
 #include <string>
+#include <vector>
 
 namespace clang {
 class CompilerInstance;
@@ -32,6 +33,13 @@ class MSFileSystem;
 
 namespace dxcutil {
 
+// A file requested from the include handler during a compile. Content is
+// null when the handler could not provide the file.
+struct DxcIncludeDependency {
+  std::wstring Name;
+  CComPtr<IDxcBlobUtf8> Content;
+};
+
 class DxcArgsFileSystem : public ::llvm::sys::fs::MSFileSystem {
 public:
   virtual ~DxcArgsFileSystem(){};
@@ -41,6 +49,7 @@ public:
   virtual void EnableDisplayIncludeProcess() = 0;
   virtual HRESULT CreateStdStreams(_In_ IMalloc *pMalloc) = 0;
   virtual HRESULT RegisterOutputStream(LPCWSTR pName, IStream *pStream) = 0;
+  virtual void GetIncludeDependencies(std::vector<DxcIncludeDependency> &deps) = 0;
 };
 
 DxcArgsFileSystem *
@@ -65,6 +65,7 @@ struct FileRunCommandResult {
   CComPtr<IDxcOperationResult> OpResult; // The operation result, if any.
   std::string StdOut;
   std::string StdErr;
+  std::string Log;          // Text for the test log, e.g. from tee.
   int ExitCode = 0;
   bool AbortPipeline = false; // True to prevent running subsequent commands
 
@@ -139,6 +140,7 @@ void ParseCommandPartsFromFile(LPCWSTR fileName, std::vector<FileRunCommandPart>
 class FileRunTestResult {
 public:
   std::string ErrorMessage;
+  std::string Log; // Text the RUN lines asked to have logged, for the caller.
   int RunResult;
   static FileRunTestResult RunHashTestFromFileCommands(LPCWSTR fileName);
   static FileRunTestResult RunFromFileCommands(LPCWSTR fileName,
@@ -349,6 +349,44 @@ public:
   ) = 0;
 };
 
+// One link in a batch; fields match the IDxcLinker::Link arguments.
+struct DxcLinkJob {
+  _Maybenull_ LPCWSTR pEntryName;
+  LPCWSTR pTargetProfile;
+  _Field_size_(LibCount) const LPCWSTR *pLibNames;
+  UINT32 LibCount;
+  _Field_size_opt_(ArgCount) const LPCWSTR *pArguments;
+  UINT32 ArgCount;
+};
+
+CROSS_PLATFORM_UUIDOF(IDxcLinkBatchCallback, "3D6E0C4A-8F1B-4E2D-9B57-6A0C2F4D8E31")
+struct IDxcLinkBatchCallback : public IUnknown {
+  // Called once per job as soon as it completes, in completion order and
+  // possibly concurrently from several worker threads. pResult is null only
+  // if the linker failed to produce a result, in which case hr says why.
+  // Returning a failure stops the batch from starting further jobs.
+  virtual HRESULT STDMETHODCALLTYPE OnJobCompleted(
+    _In_ UINT32 jobIndex,                         // Index of the job in the batch
+    _In_ HRESULT hr,                              // Return value of the link call
+    _In_opt_ IDxcOperationResult *pResult         // Linker output status, buffer, and errors
+  ) = 0;
+};
+
+CROSS_PLATFORM_UUIDOF(IDxcLinkerBatch, "9A4F7B21-5C3E-4D8A-B6E0-1F2C7D9E4A58")
+struct IDxcLinkerBatch : public IUnknown {
+  // Link a batch of independent jobs against this linker's registered
+  // libraries on a pool of worker threads. Returns once every started job
+  // has been reported to pCallback. Libraries must not be registered while
+  // a batch is running, and a registered container events handler is called
+  // from the worker threads.
+  virtual HRESULT STDMETHODCALLTYPE LinkBatch(
+    _In_count_(jobCount) const DxcLinkJob *pJobs, // Jobs to link
+    _In_ UINT32 jobCount,                         // Number of jobs
+    _In_ UINT32 threadCount,                      // Maximum worker threads; 0 for one per hardware thread
+    _In_ IDxcLinkBatchCallback *pCallback         // Receives each result
+  ) = 0;
+};
+
 /////////////////////////
 // Latest interfaces. Please use these
 ////////////////////////
@@ -444,6 +482,7 @@ typedef enum DXC_OUT_KIND {
   DXC_OUT_REFLECTION = 8,     // IDxcBlob - RDAT part with reflection data
   DXC_OUT_ROOT_SIGNATURE = 9, // IDxcBlob - Serialized root signature output
   DXC_OUT_EXTRA_OUTPUTS  = 10,// IDxcExtraResults - Extra outputs
+  DXC_OUT_TIME_REPORT = 11,   // IDxcBlobUtf8 or IDxcBlobUtf16 - JSON phase and pass timings from -ftime-report
 
   DXC_OUT_FORCE_DWORD = 0xFFFFFFFF
 } DXC_OUT_KIND;
@@ -495,6 +534,43 @@ struct IDxcCompiler3 : public IUnknown {
     ) = 0;
 };
 
+// One compilation in a batch; fields match the IDxcCompiler3::Compile arguments.
+struct DxcCompileJob {
+  DxcBuffer Source;
+  _Field_size_opt_(ArgCount) LPCWSTR *pArguments;
+  UINT32 ArgCount;
+  _Maybenull_ IDxcIncludeHandler *pIncludeHandler; // Must be safe to call from any worker thread.
+};
+
+CROSS_PLATFORM_UUIDOF(IDxcCompileBatchCallback, "76927800-6059-44BA-A3C2-B80940E549E1")
+struct IDxcCompileBatchCallback : public IUnknown {
+  // Called once per job as soon as it completes, in completion order and
+  // possibly concurrently from several worker threads. pResult is null only
+  // if the compiler failed to produce a result, in which case hr says why.
+  // Returning a failure stops the batch from starting further jobs.
+  virtual HRESULT STDMETHODCALLTYPE OnJobCompleted(
+    _In_ UINT32 jobIndex,                         // Index of the job in the batch
+    _In_ HRESULT hr,                              // Return value of the compile call
+    _In_opt_ IDxcResult *pResult                  // IDxcResult: status, buffer, and errors
+  ) = 0;
+};
+
+CROSS_PLATFORM_UUIDOF(IDxcCompilerBatch, "70226BC7-F1A0-460C-988A-227C30CF9F26")
+struct IDxcCompilerBatch : public IUnknown {
+  // Compile a batch of independent jobs on a pool of worker threads. Each
+  // job gets its own compiler instance and validator, but the language
+  // extensions registered with this compiler (intrinsic tables and the
+  // semantic define validator) are shared, and are called from several
+  // threads at once; they must be thread-safe to be used with CompileBatch.
+  // Returns once every started job has been reported to pCallback.
+  virtual HRESULT STDMETHODCALLTYPE CompileBatch(
+    _In_count_(jobCount) const DxcCompileJob *pJobs, // Jobs to compile
+    _In_ UINT32 jobCount,                         // Number of jobs
+    _In_ UINT32 threadCount,                      // Maximum worker threads; 0 for one per hardware thread
+    _In_ IDxcCompileBatchCallback *pCallback      // Receives each result
+  ) = 0;
+};
+
 static const UINT32 DxcValidatorFlags_Default = 0;
 static const UINT32 DxcValidatorFlags_InPlaceEdit = 1;  // Validator is allowed to update shader blob in-place.
 static const UINT32 DxcValidatorFlags_RootSignatureOnly = 2;
@@ -557,6 +633,38 @@ struct IDxcOptimizer : public IUnknown {
     _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) = 0;
 };
 
+CROSS_PLATFORM_UUIDOF(IDxcOptimizerSession, "5B0E3C7A-9D41-4F26-8A1E-C3F7B2D80E64")
+struct IDxcOptimizerSession : public IUnknown {
+  // Builds a pipeline from options in the RunOptimizer syntax and keeps it
+  // under pName, replacing any pipeline of that name. With -opt-stats, each
+  // run of the pipeline records the time and IR size after every pass; this
+  // runs each module-level pass over the whole module before the next.
+  virtual HRESULT STDMETHODCALLTYPE DefinePipeline(_In_z_ LPCWSTR pName,
+    _In_count_(optionCount) LPCWSTR *ppOptions, UINT32 optionCount) = 0;
+  // Runs a defined pipeline on the module of the session, which keeps the
+  // changes for later runs. Text written by the passes, such as the output
+  // of -S and -print-module, is returned in ppOutputText.
+  virtual HRESULT STDMETHODCALLTYPE RunPipeline(_In_z_ LPCWSTR pName,
+    _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) = 0;
+  // Returns the module in its current state as bitcode and/or text.
+  virtual HRESULT STDMETHODCALLTYPE GetModule(
+    _COM_Outptr_opt_ IDxcBlob **ppOutputModule,
+    _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) = 0;
+  // Returns the statistics recorded so far as tab-separated text, one line
+  // per pass run with the pipeline name, pass, milliseconds, and the
+  // function, block and instruction counts of the module after the pass.
+  virtual HRESULT STDMETHODCALLTYPE GetStatistics(
+    _COM_Outptr_ IDxcBlobEncoding **ppStatistics) = 0;
+};
+
+CROSS_PLATFORM_UUIDOF(IDxcOptimizer2, "E1B5A8D3-7C62-4A09-B4F1-2D96C0E375A8")
+struct IDxcOptimizer2 : public IDxcOptimizer {
+  // Loads a module once for any number of pipeline runs. A session may only
+  // be used by one thread at a time.
+  virtual HRESULT STDMETHODCALLTYPE CreateSession(IDxcBlob *pBlob,
+    _COM_Outptr_ IDxcOptimizerSession **ppSession) = 0;
+};
+
 static const UINT32 DxcVersionInfoFlags_None = 0;
 static const UINT32 DxcVersionInfoFlags_Debug = 1; // Matches VS_FF_DEBUG
 static const UINT32 DxcVersionInfoFlags_Internal = 2; // Internal Validator (non-signing)
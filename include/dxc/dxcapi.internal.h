@@ -131,6 +131,20 @@ struct HLSL_INTRINSIC {
   const HLSL_INTRINSIC_ARGUMENT* pArgs; // Pointer to first argument.
 };
 
+// Entries in an intrinsic table that share a name. Generated for the built-in
+// tables in name order, so a name can be found by binary search.
+struct HLSL_INTRINSIC_NAME_RANGE {
+  LPCSTR pName;                         // Name of the intrinsic.
+  UINT uFirst;                          // Index of the first entry with this name.
+  UINT uCount;                          // Count of adjacent entries with this name.
+};
+
+struct HLSL_INTRINSIC_NAME_INDEX {
+  const HLSL_INTRINSIC* pTable;                 // Table being indexed.
+  const HLSL_INTRINSIC_NAME_RANGE* pRanges;     // Ranges sorted by name.
+  UINT uRangeCount;                             // Count of ranges in pRanges.
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Interfaces.
 CROSS_PLATFORM_UUIDOF(IDxcIntrinsicTable, "f0d4da3f-f863-4660-b8b4-dfd94ded6215")
@@ -99,6 +99,15 @@ public:
 /// llvm_shutdown - Deallocate and destroy all ManagedStatic variables.
 void llvm_shutdown();
 
+// HLSL Change Starts
+/// Managed statics live until llvm_shutdown, so a host that switches
+/// allocators per thread can route their creation through this wrapper to
+/// allocate them from a process-lifetime allocator.
+typedef void *(*ManagedStaticCreatorWrapper)(void *(*Creator)());
+void llvm_set_managed_static_creator_wrapper(
+    ManagedStaticCreatorWrapper Wrapper);
+// HLSL Change Ends
+
 /// llvm_shutdown_obj - This is a simple helper class that calls
 /// llvm_shutdown() when it is destroyed.
 struct llvm_shutdown_obj {
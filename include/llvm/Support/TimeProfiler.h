@@ -0,0 +1,82 @@
+//===- llvm/Support/TimeProfiler.h - Per-thread phase profiler --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// HLSL Change - new file. Records nested, named spans of wall time on the
+// current thread, along with the allocations made while each span was open,
+// and writes them as a Chrome trace-event JSON document. Modeled on the
+// time-trace profiler of later LLVM releases, but scoped to a single thread
+// so concurrent compiles each produce their own report.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_TIMEPROFILER_H
+#define LLVM_SUPPORT_TIMEPROFILER_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Compiler.h"
+#include <cstddef>
+
+namespace llvm {
+
+class raw_ostream;
+
+struct TimeTraceProfiler;
+extern LLVM_THREAD_LOCAL TimeTraceProfiler *TimeTraceProfilerInstance;
+
+/// Starts recording on the current thread. When \p TrackLiveBytes is set the
+/// caller also reports frees, and peak live bytes are included in the output.
+/// Spans shorter than \p GranularityUs microseconds are only added to the
+/// totals of their name, so the trace does not grow with the number of
+/// functions and passes of a large shader.
+void timeTraceProfilerInitialize(bool TrackLiveBytes,
+                                 unsigned GranularityUs = 500);
+
+/// Stops recording on the current thread and releases the recorded data.
+void timeTraceProfilerCleanup();
+
+/// Is the time trace profiler enabled on the current thread?
+inline bool timeTraceProfilerEnabled() {
+  return TimeTraceProfilerInstance != nullptr;
+}
+
+/// Writes the spans completed so far as JSON.
+void timeTraceProfilerWrite(raw_ostream &OS);
+
+/// Opens a span. Prefer TimeTraceScope, which is free when disabled.
+void timeTraceProfilerBegin(StringRef Name, StringRef Detail);
+
+/// Closes the most recently opened span.
+void timeTraceProfilerEnd();
+
+/// Allocation accounting, attributed to the innermost open span.
+void timeTraceProfilerRecordAlloc(size_t Size);
+void timeTraceProfilerRecordFree(size_t Size);
+
+/// Records a span for the lifetime of the object if the profiler is enabled
+/// on the current thread when it is constructed.
+struct TimeTraceScope {
+  TimeTraceScope(StringRef Name, StringRef Detail = StringRef())
+      : Active(TimeTraceProfilerInstance != nullptr) {
+    if (Active)
+      timeTraceProfilerBegin(Name, Detail);
+  }
+  ~TimeTraceScope() {
+    if (Active)
+      timeTraceProfilerEnd();
+  }
+
+private:
+  TimeTraceScope(const TimeTraceScope &) = delete;
+  void operator=(const TimeTraceScope &) = delete;
+  bool Active;
+};
+
+} // end namespace llvm
+
+#endif
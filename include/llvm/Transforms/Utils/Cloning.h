@@ -23,6 +23,7 @@
 #include "llvm/IR/ValueHandle.h"
 #include "llvm/IR/ValueMap.h"
 #include "llvm/Transforms/Utils/ValueMapper.h"
+#include <functional> // HLSL Change
 
 namespace llvm {
 
@@ -51,6 +52,13 @@ class DominatorTree;
 ///
 Module *CloneModule(const Module *M);
 Module *CloneModule(const Module *M, ValueToValueMapTy &VMap);
+// HLSL Change Starts - Allow cloning without function bodies.
+/// CloneModule - Return a copy of the specified module, only cloning the
+/// bodies of functions for which ShouldCloneDefinition returns true.  Other
+/// definitions become external declarations in the new module.
+Module *CloneModule(const Module *M, ValueToValueMapTy &VMap,
+                    std::function<bool(const Function *)> ShouldCloneDefinition);
+// HLSL Change Ends
 
 /// ClonedCodeInfo - This struct can be used to capture information about code
 /// being cloned, while it is being cloned.
@@ -25,6 +25,7 @@
 #include "llvm/IR/LegacyPassManagers.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/TimeProfiler.h" // HLSL Change
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 using namespace llvm;
@@ -127,6 +128,11 @@ bool CGPassManager::RunPassOnSCC(Pass *P, CallGraphSCC &CurSCC,
 
     {
       TimeRegion PassTimer(getPassTimer(CGSP));
+      // HLSL Change Starts
+      Optional<TimeTraceScope> TimeScope;
+      if (timeTraceProfilerEnabled())
+        TimeScope.emplace(CGSP->getPassName());
+      // HLSL Change Ends
       Changed = CGSP->runOnSCC(CurSCC);
     }
     
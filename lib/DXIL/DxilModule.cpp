@@ -31,6 +31,8 @@
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/DiagnosticPrinter.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SetVector.h"
 #include <unordered_set>
@@ -100,6 +102,19 @@ void DxilModule_ResetModule(llvm::Module* M) {
 //
 //  DxilModule methods.
 //
+struct DxilModule::FunctionShaderFlagsCache {
+  struct Entry {
+    ShaderFlags Flags;
+    // Hash of the entry properties the flags were collected under.
+    size_t PropsHash;
+  };
+  // Entries are dropped by InvalidateFunctionShaderFlags, which RemoveFunction
+  // calls for every function removed from the module.
+  DenseMap<const Function *, Entry> Flags;
+  // Hash of the module state the flags were collected under.
+  size_t StateHash = 0;
+};
+
 DxilModule::DxilModule(Module *pModule)
 : m_StreamPrimitiveTopology(DXIL::PrimitiveTopology::Undefined)
 , m_ActiveStreamMask(0)
@@ -308,9 +323,72 @@ unsigned DxilModule::GetGlobalFlags() const {
   return Flags;
 }
 
+// Hashes the module state ShaderFlags::CollectShaderFlags reads besides the
+// function body.
+static size_t HashShaderFlagsState(const DxilModule &DM) {
+  unsigned ValMajor, ValMinor;
+  DM.GetValidatorVersion(ValMajor, ValMinor);
+  hash_code Hash = hash_combine(ValMajor, ValMinor, DM.GetUseMinPrecision(),
+                                DM.GetDisableOptimization(),
+                                DM.GetAllResourcesBound(),
+                                DM.GetShaderModel());
+  for (auto &UAV : DM.GetUAVs())
+    Hash = hash_combine(Hash, (unsigned)UAV->GetClass(), UAV->GetSpaceID(),
+                        UAV->GetLowerBound(), UAV->GetUpperBound(),
+                        UAV->GetGlobalSymbol());
+  if (const DxilSubobjects *pSubobjects = DM.GetSubobjects()) {
+    for (const auto &it : pSubobjects->GetSubobjects()) {
+      uint32_t ConfigFlags = 0;
+      it.second->GetStateObjectConfig(ConfigFlags);
+      Hash = hash_combine(Hash, (unsigned)it.second->GetKind(), ConfigFlags);
+    }
+  }
+  return Hash;
+}
+
+// Hashes the entry properties of F that ShaderFlags::CollectShaderFlags reads:
+// the shader kind and the kinds of the signature elements.
+static size_t HashShaderFlagsEntryProps(const DxilModule &DM,
+                                        const Function *F) {
+  if (!DM.HasDxilEntryProps(F))
+    return 0;
+  const DxilEntryProps &entryProps = DM.GetDxilEntryProps(F);
+  hash_code Hash = hash_value((unsigned)entryProps.props.shaderKind);
+  for (auto &&E : entryProps.sig.InputSignature.GetElements())
+    Hash = hash_combine(Hash, (unsigned)E->GetKind());
+  // Keep an element from hashing the same as input or output.
+  Hash = hash_combine(Hash, ~0U);
+  for (auto &&E : entryProps.sig.OutputSignature.GetElements())
+    Hash = hash_combine(Hash, (unsigned)E->GetKind());
+  return Hash;
+}
+
+ShaderFlags DxilModule::GetFunctionShaderFlags(const Function *F) const {
+  size_t StateHash = HashShaderFlagsState(*this);
+  if (!m_pFunctionShaderFlags ||
+      m_pFunctionShaderFlags->StateHash != StateHash) {
+    m_pFunctionShaderFlags = llvm::make_unique<FunctionShaderFlagsCache>();
+    m_pFunctionShaderFlags->StateHash = StateHash;
+  }
+
+  size_t PropsHash = HashShaderFlagsEntryProps(*this, F);
+  auto &Flags = m_pFunctionShaderFlags->Flags;
+  auto It = Flags.find(F);
+  if (It != Flags.end() && It->second.PropsHash == PropsHash)
+    return It->second.Flags;
+  ShaderFlags FuncFlags = ShaderFlags::CollectShaderFlags(F, this);
+  Flags[F] = FunctionShaderFlagsCache::Entry{FuncFlags, PropsHash};
+  return FuncFlags;
+}
+
+void DxilModule::InvalidateFunctionShaderFlags(const Function *F) {
+  if (m_pFunctionShaderFlags)
+    m_pFunctionShaderFlags->Flags.erase(F);
+}
+
 void DxilModule::CollectShaderFlagsForModule(ShaderFlags &Flags) {
   for (Function &F : GetModule()->functions()) {
-    ShaderFlags funcFlags = ShaderFlags::CollectShaderFlags(&F, this);
+    ShaderFlags funcFlags = GetFunctionShaderFlags(&F);
     Flags.CombineShaderFlags(funcFlags);
   };
 
@@ -977,6 +1055,7 @@ static void ConvertUsedResource(std::unordered_set<unsigned> &immResID,
 
 void DxilModule::RemoveFunction(llvm::Function *F) {
   DXASSERT_NOMSG(F != nullptr);
+  InvalidateFunctionShaderFlags(F);
   m_DxilEntryPropsMap.erase(F);
   if (m_pTypeSystem.get()->GetFunctionAnnotation(F))
     m_pTypeSystem.get()->EraseFunctionAnnotation(F);
@@ -1032,10 +1032,11 @@ Function *OP::GetOpFunc(OpCode opCode, Type *pOverloadType) {
   DXASSERT(IsOverloadLegal(opCode, pOverloadType), "otherwise the caller requested illegal operation overload (eg HLSL function with unsupported types for mapped intrinsic function)");
   OpCodeClass opClass = m_OpCodeProps[(unsigned)opCode].opCodeClass;
   Function *&F = m_OpCodeClassCache[(unsigned)opClass].pOverloads[pOverloadType];
-  if (F != nullptr) {
-    UpdateCache(opClass, pOverloadType, F);
+  // Entries are only filled in through UpdateCache, so a hit is already
+  // recorded in m_FunctionToOpClass; lowering asks for the same overloads
+  // for every call, so keep this path to the lookup alone.
+  if (F != nullptr)
     return F;
-  }
 
   vector<Type*> ArgTypes;      // RetType is ArgTypes[0]
   Type *pETy = pOverloadType;
@@ -466,6 +466,7 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
   opts.OutputReflectionFile = Args.getLastArgValue(OPT_Fre);
   opts.OutputRootSigFile = Args.getLastArgValue(OPT_Frs);
   opts.OutputShaderHashFile = Args.getLastArgValue(OPT_Fsh);
+  opts.OutputTimeReportFile = Args.getLastArgValue(OPT_Ftr);
   opts.ShowOptionNames = Args.hasFlag(OPT_fdiagnostics_show_option, OPT_fno_diagnostics_show_option, true);
   opts.UseColor = Args.hasFlag(OPT_Cc, OPT_INVALID, false);
   opts.UseInstructionNumbers = Args.hasFlag(OPT_Ni, OPT_INVALID, false);
@@ -749,6 +750,37 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
     opts.ValVerMinor = (unsigned long)minor64;
   }
 
+  llvm::StringRef selectValidator = Args.getLastArgValue(OPT_select_validator);
+  if (!selectValidator.empty()) {
+    if (selectValidator.equals_lower("auto")) {
+      opts.SelectValidator = ValidatorSelection::Auto;
+    } else if (selectValidator.equals_lower("internal")) {
+      opts.SelectValidator = ValidatorSelection::Internal;
+    } else if (selectValidator.equals_lower("external")) {
+      opts.SelectValidator = ValidatorSelection::External;
+    } else {
+      errors << "Unsupported value '" << selectValidator
+             << "' for -select-validator option.";
+      return 1;
+    }
+  }
+
+  opts.CacheDir = Args.getLastArgValue(OPT_cache_dir);
+  llvm::StringRef cacheMaxSize = Args.getLastArgValue(OPT_cache_max_size);
+  if (!cacheMaxSize.empty()) {
+    if (cacheMaxSize.getAsInteger(10, opts.CacheMaxSize) ||
+        opts.CacheMaxSize == 0) {
+      errors << "Unsupported value '" << cacheMaxSize
+             << "' for -cache-max-size option.";
+      return 1;
+    }
+  }
+
+  opts.TimeReport = Args.hasFlag(OPT_ftime_report, OPT_INVALID, false) ||
+                    !opts.OutputTimeReportFile.empty();
+  opts.PreambleCache = Args.hasFlag(OPT_preamble_cache, OPT_INVALID, false);
+  opts.ArenaAlloc = Args.hasFlag(OPT_arena_alloc, OPT_INVALID, false);
+
   if (opts.IsLibraryProfile() && Minor == 0xF) {
     if (opts.ValVerMajor != UINT_MAX && opts.ValVerMajor != 0) {
       errors << "Offline library profile cannot be used with non-zero -validator-version.";
@@ -804,6 +836,8 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
   opts.SpirvOptions.noWarnEmulatedFeatures = Args.hasFlag(OPT_Wno_vk_emulated_features, OPT_INVALID, false);
   opts.SpirvOptions.flattenResourceArrays =
       Args.hasFlag(OPT_fspv_flatten_resource_arrays, OPT_INVALID, false);
+  opts.SpirvOptions.parallelEntryPoints =
+      Args.hasFlag(OPT_fspv_parallel_entry_points, OPT_INVALID, false);
   opts.SpirvOptions.autoShiftBindings = Args.hasFlag(OPT_fvk_auto_shift_bindings, OPT_INVALID, false);
 
   if (!handleVkShiftArgs(Args, OPT_fvk_b_shift, "b", &opts.SpirvOptions.bShift, errors) ||
@@ -892,6 +926,7 @@ int ReadDxcOpts(const OptTable *optionTable, unsigned flagsToInclude,
       Args.hasFlag(OPT_fvk_use_dx_layout, OPT_INVALID, false) ||
       Args.hasFlag(OPT_fvk_use_scalar_layout, OPT_INVALID, false) ||
       Args.hasFlag(OPT_fspv_flatten_resource_arrays, OPT_INVALID, false) ||
+      Args.hasFlag(OPT_fspv_parallel_entry_points, OPT_INVALID, false) ||
       Args.hasFlag(OPT_fspv_reflect, OPT_INVALID, false) ||
       Args.hasFlag(OPT_Wno_vk_ignored_features, OPT_INVALID, false) ||
       Args.hasFlag(OPT_Wno_vk_emulated_features, OPT_INVALID, false) ||
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// WorkerThreads.cpp                                                         //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Implements the helper to spread independent work items over threads.     //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/Support/WorkerThreads.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+void hlsl::RunOnWorkerThreads(
+    size_t Count, unsigned ThreadCount, IMalloc *pMalloc,
+    const std::function<void(size_t Index, unsigned ThreadIndex)> &Work) {
+  if (ThreadCount == 0)
+    ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+  if (pMalloc == nullptr)
+    ThreadCount = 1;
+  ThreadCount = (unsigned)std::min<size_t>(ThreadCount, Count);
+  if (ThreadCount < 2) {
+    for (size_t i = 0; i < Count; ++i)
+      Work(i, 0);
+    return;
+  }
+
+  std::atomic<size_t> Next(0);
+  std::vector<std::exception_ptr> Errors(ThreadCount);
+  auto Worker = [&](unsigned ThreadIndex) {
+    try {
+      for (size_t i = Next++; i < Count; i = Next++)
+        Work(i, ThreadIndex);
+    } catch (...) {
+      Errors[ThreadIndex] = std::current_exception();
+      Next = Count;
+    }
+  };
+
+  std::vector<std::thread> Threads;
+  {
+    // The thread objects and their start state are allocated here, and the
+    // state is freed on the worker after the thread function returns.
+    DxcThreadMalloc TM(pMalloc);
+    try {
+      Threads.reserve(ThreadCount - 1);
+      for (unsigned i = 1; i < ThreadCount; ++i)
+        Threads.emplace_back(
+            [&](unsigned ThreadIndex) {
+              DxcSetWorkerThreadMalloc(pMalloc);
+              Worker(ThreadIndex);
+            },
+            i);
+    } catch (const std::exception &) {
+      // std::system_error or std::bad_alloc; the threads already running
+      // and this one share the rest of the work.
+    }
+  }
+  Worker(0);
+  for (std::thread &Thread : Threads)
+    Thread.join();
+
+  for (std::exception_ptr &Error : Errors) {
+    if (Error)
+      std::rethrow_exception(Error);
+  }
+}
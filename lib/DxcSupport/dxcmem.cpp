@@ -84,6 +84,11 @@ static IMalloc *DxcSwapThreadMalloc(IMalloc *pMalloc, IMalloc **ppPrior) throw()
   return pMalloc;
 }
 
+void DxcSetWorkerThreadMalloc(IMalloc *pMalloc) throw() {
+  DXASSERT(DxcGetThreadMallocNoRef() == nullptr, "else not a new thread");
+  DxcSwapThreadMalloc(pMalloc, nullptr);
+}
+
 DxcThreadMalloc::DxcThreadMalloc(IMalloc *pMallocOrNull) throw() {
     p = DxcSwapThreadMalloc(pMallocOrNull ? pMallocOrNull : g_pDefaultMalloc, &pPrior);
 }
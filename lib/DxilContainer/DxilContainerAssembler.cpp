@@ -1070,6 +1070,51 @@ public:
 
 using namespace DXIL;
 
+// Size of an RDAT-layout blob holding the given non-empty parts.
+template <typename PartList>
+static uint32_t GetRDATSize(const PartList &parts) {
+  // header + offset array
+  uint32_t total = sizeof(RuntimeDataHeader) + parts.size() * sizeof(uint32_t);
+  // For each part: part header + part size
+  for (auto &part : parts)
+    total += sizeof(RuntimeDataPartHeader) + PSVALIGN4(part->GetPartSize());
+  return total;
+}
+
+// Lays out the parts in buffer, then writes it to pStream.
+template <typename PartList>
+static void WriteRDAT(const PartList &parts, SmallVectorImpl<char> &buffer,
+                      AbstractMemoryStream *pStream) {
+  try {
+    buffer.resize(GetRDATSize(parts), 0);
+    CheckedWriter W(buffer.data(), buffer.size());
+    // write RDAT header
+    RuntimeDataHeader &header = W.Map<RuntimeDataHeader>();
+    header.Version = RDAT_Version_10;
+    header.PartCount = parts.size();
+    // map offsets
+    uint32_t *offsets = W.MapArray<uint32_t>(header.PartCount);
+    // write parts
+    unsigned i = 0;
+    for (auto &part : parts) {
+      offsets[i++] = W.GetOffset();
+      RuntimeDataPartHeader &partHeader = W.Map<RuntimeDataPartHeader>();
+      partHeader.Type = part->GetType();
+      partHeader.Size = PSVALIGN4(part->GetPartSize());
+      DXASSERT(partHeader.Size, "otherwise, failed to remove empty part");
+      char *bytes = W.MapArray<char>(partHeader.Size);
+      part->Write(bytes);
+    }
+  }
+  catch (CheckedWriter::exception e) {
+    throw hlsl::Exception(DXC_E_GENERAL_INTERNAL_ERROR, e.what());
+  }
+
+  ULONG cbWritten;
+  IFT(pStream->Write(buffer.data(), buffer.size(), &cbWritten));
+  DXASSERT_NOMSG(cbWritten == buffer.size());
+}
+
 class DxilRDATWriter : public DxilPartWriter {
 private:
   SmallVector<char, 1024> m_RDATBuffer;
@@ -1271,7 +1316,7 @@ private:
           }
           shaderKind = (uint32_t)props.shaderKind;
         }
-        ShaderFlags flags = ShaderFlags::CollectShaderFlags(&function, &DM);
+        ShaderFlags flags = DM.GetFunctionShaderFlags(&function);
         RuntimeDataFunctionInfo info = {};
         info.Name = mangledIndex;
         info.UnmangledName = unmangledIndex;
@@ -1429,44 +1474,92 @@ public:
     }
   }
 
-  uint32_t size() const override {
-    // header + offset array
-    uint32_t total = sizeof(RuntimeDataHeader) + m_Parts.size() * sizeof(uint32_t);
-    // For each part: part header + part size
-    for (auto &part : m_Parts)
-      total += sizeof(RuntimeDataPartHeader) + PSVALIGN4(part->GetPartSize());
-    return total;
-  }
+  uint32_t size() const override { return GetRDATSize(m_Parts); }
 
   void write(AbstractMemoryStream *pStream) override {
-    try {
-      m_RDATBuffer.resize(size(), 0);
-      CheckedWriter W(m_RDATBuffer.data(), m_RDATBuffer.size());
-      // write RDAT header
-      RuntimeDataHeader &header = W.Map<RuntimeDataHeader>();
-      header.Version = RDAT_Version_10;
-      header.PartCount = m_Parts.size();
-      // map offsets
-      uint32_t *offsets = W.MapArray<uint32_t>(header.PartCount);
-      // write parts
-      unsigned i = 0;
-      for (auto &part : m_Parts) {
-        offsets[i++] = W.GetOffset();
-        RuntimeDataPartHeader &partHeader = W.Map<RuntimeDataPartHeader>();
-        partHeader.Type = part->GetType();
-        partHeader.Size = PSVALIGN4(part->GetPartSize());
-        DXASSERT(partHeader.Size, "otherwise, failed to remove empty part");
-        char *bytes = W.MapArray<char>(partHeader.Size);
-        part->Write(bytes);
-      }
-    }
-    catch (CheckedWriter::exception e) {
-      throw hlsl::Exception(DXC_E_GENERAL_INTERNAL_ERROR, e.what());
+    WriteRDAT(m_Parts, m_RDATBuffer, pStream);
+  }
+};
+
+// Shader reflection tables share the RDAT layout, so ID3D12ShaderReflection
+// can be loaded from them without parsing the reflection bitcode.
+template <class T, RuntimeDataPartType PartType>
+class ReflectionTable : public RDATTable<T> {
+public:
+  RuntimeDataPartType GetType() const { return PartType; }
+  uint32_t Append(const T &data) {
+    uint32_t index = (uint32_t)this->m_rows.size();
+    this->Insert(data);
+    return index;
+  }
+};
+
+class DxilReflectionTablesWriter_impl : public DxilReflectionTablesWriter {
+private:
+  SmallVector<char, 1024> m_Buffer;
+  StringBufferPart m_StringBuffer;
+  IndexArraysPart m_IndexArrays;
+  ReflectionTable<ReflectionShaderInfo,
+                  RuntimeDataPartType::ReflectionShaderInfo> m_ShaderInfo;
+  ReflectionTable<ReflectionResourceInfo,
+                  RuntimeDataPartType::ReflectionResourceTable> m_Resources;
+  ReflectionTable<ReflectionCBufferInfo,
+                  RuntimeDataPartType::ReflectionCBufferTable> m_CBuffers;
+  ReflectionTable<ReflectionVariableInfo,
+                  RuntimeDataPartType::ReflectionVariableTable> m_Variables;
+  ReflectionTable<ReflectionTypeInfo,
+                  RuntimeDataPartType::ReflectionTypeTable> m_Types;
+  ReflectionTable<ReflectionSignatureElement,
+                  RuntimeDataPartType::ReflectionSignatureTable> m_Signature;
+
+  RDATPart *m_AllParts[8];
+
+  // Non-empty parts, in the order they are written.
+  SmallVector<RDATPart *, 8> GetParts() const {
+    SmallVector<RDATPart *, 8> parts;
+    for (RDATPart *part : m_AllParts) {
+      if (part->GetPartSize())
+        parts.push_back(part);
     }
+    return parts;
+  }
 
-    ULONG cbWritten;
-    IFT(pStream->Write(m_RDATBuffer.data(), m_RDATBuffer.size(), &cbWritten));
-    DXASSERT_NOMSG(cbWritten == m_RDATBuffer.size());
+public:
+  DxilReflectionTablesWriter_impl()
+      : m_AllParts{&m_StringBuffer, &m_IndexArrays, &m_ShaderInfo,
+                   &m_Resources,    &m_CBuffers,    &m_Variables,
+                   &m_Types,        &m_Signature} {}
+
+  uint32_t InsertString(StringRef Str) override {
+    return m_StringBuffer.Insert(Str);
+  }
+  uint32_t InsertIndexArray(ArrayRef<uint32_t> Indices) override {
+    return m_IndexArrays.AddIndex(Indices.begin(), Indices.end());
+  }
+  void SetShaderInfo(const ReflectionShaderInfo &Info) override {
+    DXASSERT(m_ShaderInfo.GetPartSize() == 0, "shader info is set once");
+    m_ShaderInfo.Insert(Info);
+  }
+  uint32_t InsertResource(const ReflectionResourceInfo &Info) override {
+    return m_Resources.Append(Info);
+  }
+  uint32_t InsertCBuffer(const ReflectionCBufferInfo &Info) override {
+    return m_CBuffers.Append(Info);
+  }
+  uint32_t InsertVariable(const ReflectionVariableInfo &Info) override {
+    return m_Variables.Append(Info);
+  }
+  uint32_t InsertType(const ReflectionTypeInfo &Info) override {
+    return m_Types.Append(Info);
+  }
+  uint32_t InsertSignatureElement(const ReflectionSignatureElement &Info) override {
+    return m_Signature.Append(Info);
+  }
+
+  uint32_t size() const override { return GetRDATSize(GetParts()); }
+
+  void write(AbstractMemoryStream *pStream) override {
+    WriteRDAT(GetParts(), m_Buffer, pStream);
   }
 };
 
@@ -1478,6 +1571,10 @@ DxilPartWriter *hlsl::NewRDATWriter(const DxilModule &M) {
   return new DxilRDATWriter(M);
 }
 
+DxilReflectionTablesWriter *hlsl::NewReflectionTablesWriter() {
+  return new DxilReflectionTablesWriter_impl();
+}
+
 class DxilContainerWriter_impl : public DxilContainerWriter  {
 private:
   class DxilPart {
@@ -1615,8 +1712,11 @@ static std::unique_ptr<Module> CloneModuleForReflection(Module *pM) {
   // Emit the latest reflection metadata
   hlsl::ReEmitLatestReflectionData(pM);
 
-  // Clone module
-  std::unique_ptr<Module> reflectionModule( llvm::CloneModule(pM) );
+  // Clone module without function bodies; reflection only needs declarations
+  // and metadata, and the bodies would be deleted right after cloning.
+  ValueToValueMapTy VMap;
+  std::unique_ptr<Module> reflectionModule(
+      llvm::CloneModule(pM, VMap, [](const Function *) { return false; }));
 
   // Now restore validator version on main module and re-emit metadata.
   DM.SetValidatorVersion(ValMajor, ValMinor);
@@ -1654,7 +1754,8 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
                                            SerializeDxilFlags Flags,
                                            DxilShaderHash *pShaderHashOut,
                                            AbstractMemoryStream *pReflectionStreamOut,
-                                           AbstractMemoryStream *pRootSigStreamOut) {
+                                           AbstractMemoryStream *pRootSigStreamOut,
+                                           ReflectionTablesWriterFactory pfnReflectionTables) {
   // TODO: add a flag to update the module and remove information that is not part
   // of DXIL proper and is used only to assemble the container.
 
@@ -1797,11 +1898,17 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
 
   uint32_t reflectPartSizeInBytes = 0;
   CComPtr<AbstractMemoryStream> pReflectionBitcodeStream;
+  std::unique_ptr<DxilPartWriter> pReflectionTablesWriter;
 
   if (bEmitReflection) {
     // Clone module for reflection
     std::unique_ptr<Module> reflectionModule = CloneModuleForReflection(pModule->GetModule());
     hlsl::StripAndCreateReflectionStream(reflectionModule.get(), &reflectPartSizeInBytes, &pReflectionBitcodeStream);
+
+    // Build the reflection tables while the reflection module is in memory,
+    // so readers of the reflection output need not parse the bitcode.
+    if (pReflectionStreamOut && pfnReflectionTables)
+      pReflectionTablesWriter.reset(pfnReflectionTables(reflectionModule.get()));
   }
 
   if (pReflectionStreamOut) {
@@ -1819,6 +1926,16 @@ void hlsl::SerializeDxilContainerForModule(DxilModule *pModule,
       IFT(WriteStreamValue(pReflectionStreamOut, partRDAT));
       pRDATWriter->write(pReflectionStreamOut);
     }
+
+    // Reflection tables are only emitted here until validators recognize
+    // the part in a shader container.
+    if (pReflectionTablesWriter) {
+      DxilPartHeader partRFL;
+      partRFL.PartFourCC = DFCC_ReflectionTables;
+      partRFL.PartSize = pReflectionTablesWriter->size();
+      IFT(WriteStreamValue(pReflectionStreamOut, partRFL));
+      pReflectionTablesWriter->write(pReflectionStreamOut);
+    }
   }
 
   if (Flags & SerializeDxilFlags::IncludeReflectionPart) {
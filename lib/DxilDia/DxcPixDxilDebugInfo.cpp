@@ -106,14 +106,14 @@ llvm::Instruction* dxil_debug_info::DxcPixDxilDebugInfo::FindInstruction(
     DWORD InstructionOffset
 ) const
 {
-  const auto Instructions = m_pSession->InstructionsRef();
-  auto it = Instructions.find(InstructionOffset);
-  if (it == Instructions.end())
+  const llvm::Instruction *Inst =
+      m_pSession->FindInstruction(InstructionOffset);
+  if (Inst == nullptr)
   {
     throw hlsl::Exception(E_BOUNDS, "Out-of-bounds: Instruction offset");
   }
 
-  return const_cast<llvm::Instruction *>(it->second);
+  return const_cast<llvm::Instruction *>(Inst);
 }
 
 STDMETHODIMP
@@ -105,8 +105,7 @@ STDMETHODIMP dxil_dia::DataSource::loadDataFromIStream(_In_ IStream *pInputIStre
     m_finder.reset();
 
     m_context = std::make_shared<llvm::LLVMContext>();
-    llvm::MemoryBuffer *pBitcodeBuffer;
-    std::unique_ptr<llvm::MemoryBuffer> pEmbeddedBuffer;
+    std::unique_ptr<llvm::MemoryBuffer> pBitcodeBuffer;
     std::unique_ptr<llvm::MemoryBuffer> pBuffer =
       getMemBufferFromStream(pIStream, "data");
     size_t bufferSize = pBuffer->getBufferSize();
@@ -118,7 +117,7 @@ STDMETHODIMP dxil_dia::DataSource::loadDataFromIStream(_In_ IStream *pInputIStre
     }
     const UINT32 BC_C0DE = ((INT32)(INT8)'B' | (INT32)(INT8)'C' << 8 | (INT32)0xDEC0 << 16); // BC0xc0de in big endian
     if (BC_C0DE == *(const UINT32*)pBuffer->getBufferStart()) {
-      pBitcodeBuffer = pBuffer.get();
+      pBitcodeBuffer = std::move(pBuffer);
     } else {
       if (bufferSize <= sizeof(hlsl::DxilProgramHeader)) {
         return DXC_E_MALFORMED_CONTAINER;
@@ -132,16 +131,18 @@ STDMETHODIMP dxil_dia::DataSource::loadDataFromIStream(_In_ IStream *pInputIStre
       UINT32 BlobSize;
       const char *pBitcode = nullptr;
       hlsl::GetDxilProgramBitcode(pDxilProgramHeader, &pBitcode, &BlobSize);
-      std::unique_ptr<llvm::MemoryBuffer> p = llvm::MemoryBuffer::getMemBuffer(
-        llvm::StringRef(pBitcode, BlobSize), "data", false /* RequiresNullTerminator */);
-      pEmbeddedBuffer.swap(p);
-      pBitcodeBuffer = pEmbeddedBuffer.get();
+      // The lazily loaded module keeps its buffer, so it gets a copy of
+      // just the bitcode.
+      pBitcodeBuffer = llvm::MemoryBuffer::getMemBufferCopy(
+        llvm::StringRef(pBitcode, BlobSize), "data");
     }
 
+    // Function bodies are materialized by the session when first needed;
+    // sources, defines and arguments only need the module metadata.
     std::string DiagStr;
-    std::unique_ptr<llvm::Module> pModule = hlsl::dxilutil::LoadModuleFromBitcode(
-      pBitcodeBuffer, *m_context.get(), DiagStr);
-    if (!pModule.get())
+    std::unique_ptr<llvm::Module> pModule = hlsl::dxilutil::LoadModuleFromBitcodeLazy(
+      std::move(pBitcodeBuffer), *m_context.get(), DiagStr);
+    if (!pModule.get() || pModule->materializeMetadata())
       return E_FAIL;
     m_finder = std::make_shared<llvm::DebugInfoFinder>();
     m_finder->processModule(*pModule.get());
@@ -11,6 +11,8 @@
 
 #include "DxilDiaSession.h"
 
+#include <algorithm>
+
 #include "dxc/DxilPIXPasses/DxilPIXPasses.h"
 #include "dxc/DxilPIXPasses/DxilPIXVirtualRegisters.h"
 #include "llvm/ADT/STLExtras.h"
@@ -18,6 +20,7 @@
 #include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/LegacyPassManager.h"
@@ -41,13 +44,6 @@ void dxil_dia::Session::Init(
   m_finder = finder;
   m_dxilModule = llvm::make_unique<hlsl::DxilModule>(mod.get());
 
-  llvm::legacy::PassManager PM;
-  llvm::initializeDxilDbgValueToDbgDeclarePass(*llvm::PassRegistry::getPassRegistry());
-  llvm::initializeDxilAnnotateWithVirtualRegisterPass(*llvm::PassRegistry::getPassRegistry());
-  PM.add(llvm::createDxilDbgValueToDbgDeclarePass());
-  PM.add(llvm::createDxilAnnotateWithVirtualRegisterPass());
-  PM.run(*m_module);
-
   // Extract HLSL metadata.
   m_dxilModule->LoadDxilMetadata();
 
@@ -72,40 +68,145 @@ void dxil_dia::Session::Init(
   if (!m_arguments)
     m_arguments = m_module->getNamedMetadata("llvm.dbg.args");
 
+  // Function bodies, the instruction index and the symbols are loaded or
+  // built on first use.
+  m_moduleMaterialized = false;
+  m_instructions.clear();
+  m_instructionLines.clear();
+  m_lineToInfoMap.clear();
+  m_instructionsIndexed = false;
+  m_symsMgr = dxil_dia::SymbolManager();
+  m_symsMgrInitialized = false;
+}
+
+namespace {
+// DxilAnnotateWithVirtualRegister numbers every instruction of a function but
+// its dbg.declares, or none at all; functions without numbers are skipped
+// after looking at a single instruction.
+bool FunctionHasRVAs(llvm::Function &fn) {
+  for (llvm::Instruction &i : llvm::inst_range(fn)) {
+    if (llvm::isa<llvm::DbgDeclareInst>(&i))
+      continue;
+    std::uint32_t rva;
+    return pix_dxil::PixDxilInstNum::FromInst(&i, &rva);
+  }
+  return false;
+}
+} // namespace
+
+void dxil_dia::Session::MaterializeModule() {
+  if (m_moduleMaterialized)
+    return;
+
+  // The data source loads the module lazily; this is a no-op when another
+  // session over the same module already materialized it.
+  IFTBOOL(!m_module->materializeAll(), DXC_E_MALFORMED_CONTAINER);
+
+  llvm::legacy::PassManager PM;
+  llvm::initializeDxilDbgValueToDbgDeclarePass(*llvm::PassRegistry::getPassRegistry());
+  llvm::initializeDxilAnnotateWithVirtualRegisterPass(*llvm::PassRegistry::getPassRegistry());
+  PM.add(llvm::createDxilDbgValueToDbgDeclarePass());
+  PM.add(llvm::createDxilAnnotateWithVirtualRegisterPass());
+  PM.run(*m_module);
+  // Set only now, so that a failure is reported again by the next caller
+  // rather than leaving it with unmaterialized bodies.
+  m_moduleMaterialized = true;
+}
+
+void dxil_dia::Session::IndexInstructions() {
+  if (m_instructionsIndexed)
+    return;
+  MaterializeModule();
+  // Drop what an earlier, failed attempt left behind.
+  m_instructions.clear();
+  m_instructionLines.clear();
+  m_lineToInfoMap.clear();
+
+  struct LineRVA {
+    std::uint32_t Line;
+    RVA Rva;
+    std::uint32_t Col;
+  };
+  std::vector<LineRVA> lines;
+
   // Build up a linear list of instructions. The index will be used as the
   // RVA.
   for (llvm::Function &fn : m_module->functions()) {
-    for (llvm::inst_iterator it = inst_begin(fn), end = inst_end(fn); it != end; ++it) {
-      llvm::Instruction &i = *it;
+    if (!FunctionHasRVAs(fn))
+      continue;
+    for (llvm::Instruction &i : llvm::inst_range(fn)) {
       RVA rva;
       if (!pix_dxil::PixDxilInstNum::FromInst(&i, &rva)) {
         continue;
       }
-      m_rvaMap.insert({ &i, rva });
-      m_instructions.insert({ rva, &i});
+      m_instructions.emplace_back(rva, &i);
       if (llvm::DebugLoc DL = i.getDebugLoc()) {
-        auto result = m_lineToInfoMap.emplace(DL.getLine(), LineInfo(DL.getCol(), rva, rva + 1));
-        if (!result.second) {
-          result.first->second.StartCol = std::min(result.first->second.StartCol, DL.getCol());
-          result.first->second.Last = rva + 1;
-        }
+        lines.push_back({DL.getLine(), rva, DL.getCol()});
         m_instructionLines.push_back(&i);
       }
     }
   }
 
-  // Sanity check to make sure rva map is same as instruction index.
-  for (auto It = m_instructions.begin(); It != m_instructions.end(); ++It) {
-    DXASSERT(m_rvaMap.find(It->second) != m_rvaMap.end(), "instruction not mapped to rva");
-    DXASSERT(m_rvaMap[It->second] == It->first, "instruction mapped to wrong rva");
+  // Instructions are numbered in walk order, so this is normally a no-op.
+  if (!std::is_sorted(m_instructions.begin(), m_instructions.end(),
+                      llvm::less_first()))
+    std::sort(m_instructions.begin(), m_instructions.end(),
+              llvm::less_first());
+
+  std::sort(lines.begin(), lines.end(),
+            [](const LineRVA &a, const LineRVA &b) {
+              return a.Line < b.Line || (a.Line == b.Line && a.Rva < b.Rva);
+            });
+  for (const LineRVA &l : lines) {
+    if (m_lineToInfoMap.empty() || m_lineToInfoMap.back().first != l.Line) {
+      m_lineToInfoMap.emplace_back(l.Line, LineInfo(l.Col, l.Rva, l.Rva + 1));
+      continue;
+    }
+    LineInfo &info = m_lineToInfoMap.back().second;
+    info.StartCol = std::min(info.StartCol, l.Col);
+    info.Last = l.Rva + 1;
   }
+  m_instructionsIndexed = true;
+}
 
-  // Initialize symbols
-  try {
+const dxil_dia::SymbolManager &dxil_dia::Session::SymMgr() {
+  if (!m_symsMgrInitialized) {
+    // Set first: building the symbols looks up other symbols through here.
+    m_symsMgrInitialized = true;
+    try {
+      MaterializeModule();
       m_symsMgr.Init(this);
-  } catch (const hlsl::Exception &) {
+    } catch (const hlsl::Exception &) {
       m_symsMgr = std::move(dxil_dia::SymbolManager());
+    }
   }
+  return m_symsMgr;
+}
+
+const llvm::Instruction *dxil_dia::Session::FindInstruction(RVA rva) {
+  const RVAMap &instructions = InstructionsRef();
+  auto It = std::lower_bound(
+      instructions.begin(), instructions.end(), rva,
+      [](const RVAMap::value_type &entry, RVA r) { return entry.first < r; });
+  if (It == instructions.end() || It->first != rva)
+    return nullptr;
+  return It->second;
+}
+
+const dxil_dia::Session::LineInfo *
+dxil_dia::Session::FindLineInfo(std::uint32_t line) {
+  const LineToInfoMap &lineInfo = LineToColumnStartMapRef();
+  auto It = std::lower_bound(lineInfo.begin(), lineInfo.end(), line,
+                             [](const LineToInfoMap::value_type &entry,
+                                std::uint32_t l) { return entry.first < l; });
+  if (It == lineInfo.end() || It->first != line)
+    return nullptr;
+  return &It->second;
+}
+
+bool dxil_dia::Session::FindRVA(const llvm::Instruction *inst, RVA *pRVA) {
+  return pix_dxil::PixDxilInstNum::FromInst(
+      const_cast<llvm::Instruction *>(inst), pRVA);
 }
 
 HRESULT dxil_dia::Session::getSourceFileIdByName(
@@ -141,10 +242,13 @@ STDMETHODIMP dxil_dia::Session::get_globalScope(
   }
   *pRetVal = nullptr;
 
-  Symbol *ret;
-  IFR(m_symsMgr.GetGlobalScope(&ret));
-  *pRetVal = ret;
-  return S_OK;
+  try {
+    Symbol *ret;
+    IFR(SymMgr().GetGlobalScope(&ret));
+    *pRetVal = ret;
+    return S_OK;
+  }
+  CATCH_CPP_RETURN_HRESULT();
 }
 
 STDMETHODIMP dxil_dia::Session::getEnumTables(
@@ -235,28 +339,38 @@ static HRESULT DxcDiaFindLineNumbersByRVA(
   if (!ppResult)
     return E_POINTER;
 
-  std::vector<const llvm::Instruction*> instructions;
-  auto &allInstructions = pSession->InstructionsRef();
+  // Looking up an instruction materializes the module on first use, which
+  // fails on a malformed one.
+  try {
+    std::vector<const llvm::Instruction*> instructions;
+
+    // Gather the list of insructions that map to the given rva range. The
+    // index is sorted by RVA, so the range is found once and walked.
+    const Session::RVAMap &index = pSession->InstructionsRef();
+    auto It = std::lower_bound(
+        index.begin(), index.end(), rva,
+        [](const Session::RVAMap::value_type &entry, Session::RVA r) {
+          return entry.first < r;
+        });
+    for (DWORD i = rva; i < rva + length; ++i, ++It) {
+      if (It == index.end() || It->first != i)
+        return E_INVALIDARG;
+      const llvm::Instruction *inst = It->second;
 
-  // Gather the list of insructions that map to the given rva range.
-  for (DWORD i = rva; i < rva + length; ++i) {
-    auto It = allInstructions.find(i);
-    if (It == allInstructions.end())
-      return E_INVALIDARG;
+      // Only include the instruction if it has debug info for line mappings.
+      if (inst->getDebugLoc())
+        instructions.push_back(inst);
+    }
 
-    // Only include the instruction if it has debug info for line mappings.
-    const llvm::Instruction *inst = It->second;
-    if (inst->getDebugLoc())
-      instructions.push_back(inst);
+    // Create line number table from explicit instruction list.
+    IMalloc *pMalloc = pSession->GetMallocNoRef();
+    *ppResult = CreateOnMalloc<LineNumbersTable>(pMalloc, pSession, std::move(instructions));
+    if (*ppResult == nullptr)
+      return E_OUTOFMEMORY;
+    (*ppResult)->AddRef();
+    return S_OK;
   }
-
-  // Create line number table from explicit instruction list.
-  IMalloc *pMalloc = pSession->GetMallocNoRef();
-  *ppResult = CreateOnMalloc<LineNumbersTable>(pMalloc, pSession, std::move(instructions));
-  if (*ppResult == nullptr)
-    return E_OUTOFMEMORY;
-  (*ppResult)->AddRef();
-  return S_OK;
+  CATCH_CPP_RETURN_HRESULT();
 }
 }  // namespace dxil_dia
 
@@ -380,16 +494,18 @@ STDMETHODIMP dxil_dia::Session::findInlineFramesByAddr(
   *ppResult = nullptr;
 
   DxcThreadMalloc TM(m_pMalloc);
-  auto &allInstructions = InstructionsRef();
-  auto It = allInstructions.find(offset);
-  if (It == allInstructions.end()) {
-    return E_INVALIDARG;
-  }
+  try {
+    const llvm::Instruction *inst = FindInstruction(offset);
+    if (inst == nullptr) {
+      return E_INVALIDARG;
+    }
 
-  HRESULT hr;
-  SymbolChildrenEnumerator *ChildrenEnum;
-  IFR(hr = m_symsMgr.DbgScopeOf(It->second, &ChildrenEnum));
+    HRESULT hr;
+    SymbolChildrenEnumerator *ChildrenEnum;
+    IFR(hr = SymMgr().DbgScopeOf(inst, &ChildrenEnum));
 
-  *ppResult = ChildrenEnum;
-  return hr;
+    *ppResult = ChildrenEnum;
+    return hr;
+  }
+  CATCH_CPP_RETURN_HRESULT();
 }
@@ -13,9 +13,8 @@
 
 #include "dxc/Support/WinIncludes.h"
 
-#include <map>
 #include <memory>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "dia2.h"
@@ -33,7 +32,8 @@ namespace dxil_dia {
 class Session : public IDiaSession, public IDxcPixDxilDebugInfoFactory {
 public:
   using RVA = unsigned;
-  using RVAMap = std::map<RVA, const llvm::Instruction *>;
+  // Instructions sorted by RVA.
+  using RVAMap = std::vector<std::pair<RVA, const llvm::Instruction *>>;
 
   struct LineInfo {
     LineInfo(std::uint32_t start_col, RVA first, RVA last)
@@ -45,7 +45,8 @@ public:
     RVA First = 0;
     RVA Last = 0;
   };
-  using LineToInfoMap = std::unordered_map<std::uint32_t, LineInfo>;
+  // Line info sorted by line number.
+  using LineToInfoMap = std::vector<std::pair<std::uint32_t, LineInfo>>;
 
   DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
   DXC_MICROCOM_TM_CTOR(Session)
@@ -60,14 +61,24 @@ public:
   llvm::NamedMDNode *Defines() { return m_defines; }
   llvm::NamedMDNode *MainFileName() { return m_mainFileName; }
   llvm::NamedMDNode *Arguments() { return m_arguments; }
-  hlsl::DxilModule &DxilModuleRef() { return *m_dxilModule.get(); }
-  llvm::Module &ModuleRef() { return *m_module.get(); }
+  hlsl::DxilModule &DxilModuleRef() { MaterializeModule(); return *m_dxilModule.get(); }
+  llvm::Module &ModuleRef() { MaterializeModule(); return *m_module.get(); }
   llvm::DebugInfoFinder &InfoRef() { return *m_finder.get(); }
-  const SymbolManager &SymMgr() const { return m_symsMgr; }
-  const RVAMap &InstructionsRef() const { return m_instructions; }
-  const std::vector<const llvm::Instruction *> &InstructionLinesRef() const { return m_instructionLines; }
-  const std::unordered_map<const llvm::Instruction *, RVA> &RvaMapRef() const { return m_rvaMap; }
-  const LineToInfoMap &LineToColumnStartMapRef() const { return m_lineToInfoMap; }
+
+  // Function bodies, the instruction index and the symbols are loaded or
+  // built on first use, so that loading a PDB only to read its sources or
+  // arguments stays cheap.
+  const SymbolManager &SymMgr();
+  const RVAMap &InstructionsRef() { IndexInstructions(); return m_instructions; }
+  const std::vector<const llvm::Instruction *> &InstructionLinesRef() { IndexInstructions(); return m_instructionLines; }
+  const LineToInfoMap &LineToColumnStartMapRef() { IndexInstructions(); return m_lineToInfoMap; }
+
+  // Returns the instruction at the given RVA, or nullptr if there is none.
+  const llvm::Instruction *FindInstruction(RVA rva);
+  // Returns the line info for the given line, or nullptr if there is none.
+  const LineInfo *FindLineInfo(std::uint32_t line);
+  // Retrieves the RVA of an instruction; returns false if it has none.
+  static bool FindRVA(const llvm::Instruction *inst, RVA *pRVA);
 
   HRESULT getSourceFileIdByName(llvm::StringRef fileName, DWORD *pRetVal);
 
@@ -394,9 +405,14 @@ private:
   llvm::NamedMDNode *m_arguments;
   RVAMap m_instructions;
   std::vector<const llvm::Instruction *> m_instructionLines; // Instructions with line info.
-  std::unordered_map<const llvm::Instruction *, RVA> m_rvaMap; // Map instruction to its RVA.
   LineToInfoMap m_lineToInfoMap;
   SymbolManager m_symsMgr;
+  bool m_moduleMaterialized = false;
+  bool m_instructionsIndexed = false;
+  bool m_symsMgrInitialized = false;
+
+  void MaterializeModule();
+  void IndexInstructions();
 
 private:
   CComPtr<IDiaEnumTables> m_pEnumTables;
@@ -1945,8 +1945,10 @@ HRESULT dxil_dia::hlsl_symbols::SymbolManagerInit::IsDbgDeclareCall(
         for (llvm::User *user : users) {
           auto *inst = llvm::dyn_cast<llvm::Instruction>(user);
           if (inst != nullptr) {
-            auto rva = m_Session.RvaMapRef().find(inst);
-            usesRVAs.push_back(rva->second);
+            Session::RVA rva;
+            if (Session::FindRVA(inst, &rva)) {
+              usesRVAs.push_back(rva);
+            }
           }
         }
       }
@@ -76,13 +76,12 @@ STDMETHODIMP dxil_dia::LineNumber::get_relativeVirtualAddress(
   }
   *pRetVal = 0;
 
-  const auto &rvaMap = m_pSession->RvaMapRef();
-  auto it = rvaMap.find(m_inst);
-  if (it == rvaMap.end()) {
+  Session::RVA rva;
+  if (!Session::FindRVA(m_inst, &rva)) {
     return E_FAIL;
   }
 
-  *pRetVal = it->second;
+  *pRetVal = rva;
   return S_OK;
 }
 
@@ -94,10 +93,8 @@ STDMETHODIMP dxil_dia::LineNumber::get_length(
   *pRetVal = 1;
 
   if (llvm::DebugLoc DL = m_inst->getDebugLoc()) {
-    const auto &LineToColumn = m_pSession->LineToColumnStartMapRef();
-    auto it = LineToColumn.find(DL.getLine());
-    if (it != LineToColumn.end()) {
-      *pRetVal = it->second.Last - it->second.First;
+    if (const auto *info = m_pSession->FindLineInfo(DL.getLine())) {
+      *pRetVal = info->Last - info->First;
     }
   }
 
@@ -112,10 +109,8 @@ STDMETHODIMP dxil_dia::LineNumber::get_statement(
   *pRetVal = FALSE;
 
   if (llvm::DebugLoc DL = m_inst->getDebugLoc()) {
-    const auto &LineToColumn = m_pSession->LineToColumnStartMapRef();
-    auto it = LineToColumn.find(DL.getLine());
-    if (it != LineToColumn.end()) {
-      *pRetVal = it->second.StartCol == DL.getCol();
+    if (const auto *info = m_pSession->FindLineInfo(DL.getLine())) {
+      *pRetVal = info->StartCol == DL.getCol();
     }
   }
 
@@ -12,6 +12,7 @@
 #include "dxc/DXIL/DxilModule.h"
 #include "dxc/DXIL/DxilOperations.h"
 #include "dxc/DXIL/DxilUtil.h"
+#include "dxc/DxilPIXPasses/DxilDebugTrace.h"
 #include "dxc/DxilPIXPasses/DxilPIXPasses.h"
 #include "dxc/DxilPIXPasses/DxilPIXVirtualRegisters.h"
 #include "dxc/HLSL/DxilGenerationPass.h"
@@ -21,6 +22,7 @@
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "PixPassHelpers.h"
 
@@ -85,6 +87,12 @@ using namespace hlsl;
 // overwritten, the debug session is deemed to have overflowed the UAV. The
 // caller will than allocate a UAV that is twice the size and try again, up to a
 // predefined maximum.
+//
+// With the "compact" option, steps are instead gathered per basic block and
+// written as a single record just before the block's terminator, holding only
+// the values that are not known at compile time. See DxilDebugTrace.h for the
+// record layout and for the block table that the debugger application uses to
+// expand the records back into steps.
 
 // Keep these in sync with the same-named value in the debugger application's
 // WinPixShaderUtils.h
@@ -241,6 +249,18 @@ private:
   uint32_t m_RemainingReservedSpaceInBytes = 0;
   Value *m_CurrentIndex = nullptr;
 
+  bool m_Compact = false;
+
+  // A step gathered for the compact encoding. StepValue is null for void
+  // steps and constant values, and OrdinalIndex is null unless the index is
+  // only known at run time.
+  struct CompactStep {
+    pix_dxil::CompactDebugTrace::BlockStep Desc;
+    Value *StepValue;
+    Value *OrdinalIndex;
+  };
+  pix_dxil::CompactDebugTrace::BlockTable m_CompactBlocks;
+
 public:
   static char ID; // Pass identification, replacement for typeid
   explicit DxilDebugInstrumentation() : ModulePass(ID) {}
@@ -275,6 +295,14 @@ private:
                            BuilderContext &BC, std::uint32_t InstNum, Value *V,
                            std::uint32_t ValueOrdinal,
                            Value *ValueOrdinalIndex);
+  void gatherCompactStep(Instruction *Inst, std::vector<CompactStep> &Steps);
+  void gatherCompactStepValue(std::vector<CompactStep> &Steps,
+                              std::uint32_t InstNum, Value *V,
+                              std::uint32_t ValueOrdinal,
+                              Value *ValueOrdinalIndex);
+  void addCompactBlockEntries(BuilderContext &BC,
+                              const std::vector<CompactStep> &Steps);
+  void printCompactBlockTable();
 };
 
 void DxilDebugInstrumentation::applyOptions(PassOptions O) {
@@ -282,6 +310,7 @@ void DxilDebugInstrumentation::applyOptions(PassOptions O) {
   GetPassOptionUnsigned(O, "parameter1", &m_Parameters.Parameters[1], 0);
   GetPassOptionUnsigned(O, "parameter2", &m_Parameters.Parameters[2], 0);
   GetPassOptionUInt64(O, "UAVSize", &m_UAVSize, 1024 * 1024);
+  GetPassOptionBool(O, "compact", &m_Compact, false);
 }
 
 uint32_t DxilDebugInstrumentation::UAVDumpingGroundOffset() {
@@ -914,6 +943,167 @@ void DxilDebugInstrumentation::addStepDebugEntryValue(
   }
 }
 
+void DxilDebugInstrumentation::gatherCompactStep(
+    Instruction *Inst, std::vector<CompactStep> &Steps) {
+  // These follow the same rules as addStepDebugEntry.
+  if (Inst->getOpcode() == Instruction::OtherOps::PHI) {
+    return;
+  }
+  if (PIXPassHelpers::IsAllocateRayQueryInstruction(Inst)) {
+    return;
+  }
+
+  std::uint32_t InstNum;
+  if (auto *St = llvm::dyn_cast<llvm::StoreInst>(Inst)) {
+    std::uint32_t ValueOrdinalBase;
+    std::uint32_t UnusedValueOrdinalSize;
+    llvm::Value *ValueOrdinalIndex;
+    if (!pix_dxil::PixAllocaRegWrite::FromInst(St, &ValueOrdinalBase,
+                                               &UnusedValueOrdinalSize,
+                                               &ValueOrdinalIndex) ||
+        !pix_dxil::PixDxilInstNum::FromInst(St, &InstNum) ||
+        PIXPassHelpers::IsAllocateRayQueryInstruction(St->getValueOperand())) {
+      return;
+    }
+    gatherCompactStepValue(Steps, InstNum, St->getValueOperand(),
+                           ValueOrdinalBase, ValueOrdinalIndex);
+    return;
+  }
+
+  std::uint32_t RegNum;
+  if (!pix_dxil::PixDxilReg::FromInst(Inst, &RegNum) ||
+      !pix_dxil::PixDxilInstNum::FromInst(Inst, &InstNum)) {
+    return;
+  }
+  gatherCompactStepValue(Steps, InstNum, Inst, RegNum, nullptr);
+}
+
+void DxilDebugInstrumentation::gatherCompactStepValue(
+    std::vector<CompactStep> &Steps, std::uint32_t InstNum, Value *V,
+    std::uint32_t ValueOrdinal, Value *ValueOrdinalIndex) {
+  using namespace pix_dxil::CompactDebugTrace;
+
+  CompactStep Step = {
+      {InstNum, StepKindVoid, ValueOrdinal << 16, false, false, 0}, V, nullptr};
+  switch (V->getType()->getTypeID()) {
+  case Type::TypeID::StructTyID:
+  case Type::TypeID::VoidTyID:
+    Step.StepValue = nullptr;
+    break;
+  case Type::TypeID::FloatTyID:
+  case Type::TypeID::HalfTyID:
+    Step.Desc.Kind = StepKindFloat;
+    break;
+  case Type::TypeID::IntegerTyID:
+    Step.Desc.Kind = V->getType()->getIntegerBitWidth() == 64
+                         ? StepKindUint64
+                         : StepKindUint32;
+    break;
+  case Type::TypeID::DoubleTyID:
+    Step.Desc.Kind = StepKindDouble;
+    break;
+  case Type::TypeID::PointerTyID:
+    // Skipped, as in addStepDebugEntryValue.
+    return;
+  default:
+    assert(false);
+    return;
+  }
+
+  // Ordinal indices that are constant go in the block table rather than the
+  // trace.
+  if (Step.StepValue && ValueOrdinalIndex) {
+    if (auto *C = dyn_cast<ConstantInt>(ValueOrdinalIndex)) {
+      Step.Desc.ValueOrdinal |= C->getZExtValue() & 0xFFFF;
+    } else {
+      Step.Desc.DynamicOrdinalIndex = true;
+      Step.OrdinalIndex = ValueOrdinalIndex;
+    }
+  }
+
+  // So do values that are constant, as the bits addDebugEntryValue would
+  // have written for them.
+  if (auto *CI = dyn_cast<ConstantInt>(V)) {
+    Step.Desc.ConstantValue = true;
+    Step.Desc.Value = CI->getZExtValue();
+    Step.StepValue = nullptr;
+  } else if (auto *CF = dyn_cast<ConstantFP>(V)) {
+    APFloat F = CF->getValueAPF();
+    if (V->getType()->isHalfTy()) {
+      bool LosesInfo;
+      F.convert(APFloat::IEEEsingle, APFloat::rmNearestTiesToEven, &LosesInfo);
+    }
+    Step.Desc.ConstantValue = true;
+    Step.Desc.Value = F.bitcastToAPInt().getZExtValue();
+    Step.StepValue = nullptr;
+  }
+  Steps.push_back(Step);
+}
+
+void DxilDebugInstrumentation::addCompactBlockEntries(
+    BuilderContext &BC, const std::vector<CompactStep> &Steps) {
+  using namespace pix_dxil::CompactDebugTrace;
+
+  auto StepDwords = [](const CompactStep &Step) {
+    return StepTraceDwords(Step.Desc);
+  };
+
+  size_t BlockBegin = 0;
+  while (BlockBegin < Steps.size()) {
+    size_t BlockEnd =
+        std::min<size_t>(Steps.size(), BlockBegin + MaxStepsPerBlock);
+    uint32_t BlockIndex = static_cast<uint32_t>(m_CompactBlocks.size());
+    m_CompactBlocks.emplace_back();
+    for (size_t i = BlockBegin; i < BlockEnd; ++i)
+      m_CompactBlocks.back().push_back(Steps[i].Desc);
+
+    size_t RecordBegin = BlockBegin;
+    while (RecordBegin < BlockEnd) {
+      uint32_t RecordDwords = RecordHeaderDwords;
+      size_t RecordEnd = RecordBegin;
+      while (RecordEnd < BlockEnd &&
+             RecordDwords + StepDwords(Steps[RecordEnd]) <= MaxRecordDwords)
+        RecordDwords += StepDwords(Steps[RecordEnd++]);
+
+      reserveDebugEntrySpace(BC, RecordDwords * sizeof(uint32_t));
+      addDebugEntryValue(
+          BC, BC.HlslOP->GetU32Const(RecordType << 8 | RecordDwords << 16));
+      addDebugEntryValue(BC, m_InvocationId);
+      addDebugEntryValue(BC, BC.HlslOP->GetU32Const(BlockIndex));
+      uint32_t FirstStep = static_cast<uint32_t>(RecordBegin - BlockBegin);
+      uint32_t StepCount = static_cast<uint32_t>(RecordEnd - RecordBegin);
+      addDebugEntryValue(BC, BC.HlslOP->GetU32Const(FirstStep | StepCount << 16));
+      for (size_t i = RecordBegin; i < RecordEnd; ++i) {
+        if (Steps[i].StepValue)
+          addDebugEntryValue(BC, Steps[i].StepValue);
+        if (Steps[i].OrdinalIndex)
+          addDebugEntryValue(
+              BC, BC.Builder.CreateAnd(Steps[i].OrdinalIndex,
+                                       BC.HlslOP->GetU32Const(0xFFFF),
+                                       "ValueOrdinalIndex"));
+      }
+      RecordBegin = RecordEnd;
+    }
+    BlockBegin = BlockEnd;
+  }
+}
+
+void DxilDebugInstrumentation::printCompactBlockTable() {
+  if (OSOverride == nullptr) {
+    return;
+  }
+  *OSOverride << "\n" << pix_dxil::CompactDebugTrace::BlockTableBegin << "\n";
+  for (size_t Block = 0; Block < m_CompactBlocks.size(); ++Block) {
+    for (auto &Step : m_CompactBlocks[Block]) {
+      *OSOverride << Block << " " << Step.InstNum << " " << Step.Kind << " "
+                  << Step.ValueOrdinal << " "
+                  << (Step.DynamicOrdinalIndex ? 1 : 0) << " "
+                  << (Step.ConstantValue ? 1 : 0) << " " << Step.Value << "\n";
+    }
+  }
+  *OSOverride << pix_dxil::CompactDebugTrace::BlockTableEnd << "\n";
+}
+
 bool DxilDebugInstrumentation::runOnModule(Module &M) {
   DxilModule &DM = M.GetOrCreateDxilModule();
   LLVMContext &Ctx = M.getContext();
@@ -939,6 +1129,11 @@ bool DxilDebugInstrumentation::runOnModule(Module &M) {
        I != E; ++I) {
     AllInstructions.push_back(&*I);
   }
+  std::vector<BasicBlock *> AllBlocks;
+  for (BasicBlock &BB : *DM.GetEntryFunction()) {
+    AllBlocks.push_back(&BB);
+  }
+  m_CompactBlocks.clear();
 
   // Branchless instrumentation requires taking care of a few things:
   // -Each invocation of the shader will be either of interest or not of
@@ -1010,6 +1205,7 @@ bool DxilDebugInstrumentation::runOnModule(Module &M) {
       }
 
       // Modify the Phis and add debug instrumentation
+      std::vector<CompactStep> CompactSteps;
       for (auto &ValueNPhi : InsertableEdge.second) {
         // Modify the phi to refer to the new block:
         ValueNPhi.Phi->setIncomingBlock(ValueNPhi.Index, NewBlock);
@@ -1025,17 +1221,43 @@ bool DxilDebugInstrumentation::runOnModule(Module &M) {
           continue;
         }
 
+        if (m_Compact) {
+          gatherCompactStepValue(CompactSteps, InstNum, ValueNPhi.Val, RegNum,
+                                 nullptr);
+          continue;
+        }
+
         BuilderContext BC{M, DM, Ctx, HlslOP, Builder};
         addStepDebugEntryValue(BC, InstNum, ValueNPhi.Val, RegNum,
                                BC.Builder.getInt32(0));
       }
+      if (m_Compact) {
+        BuilderContext BC{M, DM, Ctx, HlslOP, Builder};
+        addCompactBlockEntries(BC, CompactSteps);
+      }
 
       // Add a branch to the new block to point to the current block
       Builder.CreateBr(&CurrentBlock);
     }
   }
 
-  // Instrument original instructions:
+  // Instrument original instructions. The compact encoding writes each
+  // block's steps just before its terminator, where all of their values are
+  // available.
+  if (m_Compact) {
+    for (BasicBlock *BB : AllBlocks) {
+      std::vector<CompactStep> CompactSteps;
+      for (Instruction &Inst : *BB) {
+        gatherCompactStep(&Inst, CompactSteps);
+      }
+      IRBuilder<> Builder(BB->getTerminator());
+      BuilderContext BC2{BC.M, BC.DM, BC.Ctx, BC.HlslOP, Builder};
+      addCompactBlockEntries(BC2, CompactSteps);
+    }
+    AllInstructions.clear();
+    printCompactBlockTable();
+  }
+
   for (auto &Inst : AllInstructions) {
     // Instrumentation goes after the instruction if it is not a terminator.
     // Otherwise, Instrumentation goes prior to the instruction.
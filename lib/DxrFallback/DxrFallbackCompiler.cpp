@@ -516,6 +516,11 @@ void DxrFallbackCompiler::createStateFunctions(
   std::set<Value*> resources;
   collectResources(DM, resources);
 
+  // Index the candidates once rather than in every transform, which made
+  // linking many shaders quadratic.
+  StateFunctionTransform::CandidateFuncIndexMap candidateFuncIndices =
+    StateFunctionTransform::createCandidateFuncIndexMap(shaderNames);
+
   shaderEntryStateIds.clear();
   shaderStackSizes.clear();
   int stateId = baseStateId;
@@ -523,7 +528,7 @@ void DxrFallbackCompiler::createStateFunctions(
   {
     std::vector<Function*> stateFunctions;
     Function* F = m_shaderMap[shader];
-    StateFunctionTransform sft(F, shaderNames, runtimeDataArgTy);
+    StateFunctionTransform sft(F, candidateFuncIndices, runtimeDataArgTy);
     if (m_debugOutputLevel >= 2)
       sft.setVerbose(true);
     if (m_debugOutputLevel >= 3)
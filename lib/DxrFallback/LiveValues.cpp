@@ -53,18 +53,27 @@ void LiveValues::markLiveRange(Instruction* value, BasicBlock::iterator begin, B
 
   for (BasicBlock::iterator I = begin; I != end; ++I)
   {
-    if (m_computeLiveAtIndex.count(I))
+    auto it = m_computeLiveAtIndex.find(I);
+    if (it != m_computeLiveAtIndex.end())
     {
       // Mark this value
-      unsigned int index = m_computeLiveAtIndex[I];
+      unsigned int index = it->second;
       m_liveSets[index].insert(value);
       m_allLiveSet.insert(value);
       // Also store for each value where it is live.
-      m_liveAtIndices[value].insert(index);
+      getOrCreateIndices(value).set(index);
     }
   }
 }
 
+LiveValues::Indices& LiveValues::getOrCreateIndices(const Value* value)
+{
+  Indices& indices = m_liveAtIndices[value];
+  if (indices.empty())
+    indices.resize(m_computeLiveAtIndex.size());
+  return indices;
+}
+
 void LiveValues::upAndMark(Instruction* def, Use& use, BlockSet& scanned)
 {
   // Determine the starting point for the backwards search.
@@ -260,7 +269,9 @@ const LiveValues::Indices* LiveValues::getIndicesWhereLive(const Value* value) c
 
 void LiveValues::setIndicesWhereLive(Value* value, const Indices* indices)
 {
-  for (unsigned int idx : *indices)
+  // Copy first: indices may point into m_liveAtIndices, which can grow below.
+  const Indices copy(*indices);
+  for (int idx = copy.find_first(); idx != -1; idx = copy.find_next(idx))
     setLiveAtIndex(value, idx, true);
 }
 
@@ -274,31 +285,26 @@ bool LiveValues::liveInDisjointRegions(const Value* valueA, const Value* valueB)
   if (!indicesB)
     return true;
 
-  for (const unsigned int index : *indicesA)
-  {
-    if (indicesB->count(index))
-      return false;
-  }
-
-  return true;
+  return !indicesA->anyCommon(*indicesB);
 }
 
 void LiveValues::setLiveAtIndex(Value* value, unsigned int index, bool live)
 {
   assert(index <= m_computeLiveAtIndex.size());
+  Indices& indices = getOrCreateIndices(value);
   if (live)
   {
-    m_liveAtIndices[value].insert(index);
+    indices.set(index);
     Instruction* inst = cast<Instruction>(value);
     m_liveSets[index].insert(inst);
     m_allLiveSet.insert(inst);
   }
   else
   {
-    m_liveAtIndices[value].remove(index);
+    indices.reset(index);
     Instruction* inst = cast<Instruction>(value);
     m_liveSets[index].remove(inst);
-    if (m_liveAtIndices[value].empty())
+    if (indices.none())
       m_allLiveSet.remove(inst);
   }
 }
@@ -306,24 +312,20 @@ void LiveValues::setLiveAtIndex(Value* value, unsigned int index, bool live)
 void LiveValues::setLiveAtAllIndices(llvm::Value* value, bool live)
 {
   Instruction* inst = cast<Instruction>(value);
+  Indices& indices = getOrCreateIndices(value);
   if (live)
   {
-    for (unsigned int index = 0; index < m_computeLiveAtIndex.size(); ++index)
-    {
-      m_liveAtIndices[value].insert(index);
-      m_liveSets[index].insert(inst);
-    }
+    indices.set();
+    for (auto& liveSet : m_liveSets)
+      liveSet.insert(inst);
     m_allLiveSet.insert(inst);
   }
   else
   {
-    for (unsigned int index = 0; index < m_computeLiveAtIndex.size(); ++index)
-    {
-      m_liveAtIndices[value].remove(index);
-      m_liveSets[index].remove(inst);
-    }
-    if (m_liveAtIndices[value].empty())
-      m_allLiveSet.remove(inst);
+    indices.reset();
+    for (auto& liveSet : m_liveSets)
+      liveSet.remove(inst);
+    m_allLiveSet.remove(inst);
   }
 }
 
@@ -333,5 +335,5 @@ bool LiveValues::getLiveAtIndex(const Value* value, unsigned int index) const
   const auto& it = m_liveAtIndices.find(value);
   if (it == m_liveAtIndices.end())
     return false;
-  return (it->second.count(index) != 0);
+  return it->second.test(index);
 }
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/IR/BasicBlock.h"
 
 #include <map>
@@ -40,7 +42,8 @@ public:
   // Update the live sets using the map
   void remapLiveValues(llvm::DenseMap<llvm::Instruction*, llvm::Instruction*>& imap);
 
-  typedef llvm::SetVector<unsigned int> Indices;
+  // One bit per index in computeLiveAt.
+  typedef llvm::BitVector Indices;
 
   // Return all indices at which the given value is live.
   const Indices* getIndicesWhereLive(const llvm::Value* value) const;
@@ -70,12 +73,13 @@ private:
   llvm::Function*                   m_function = nullptr;
   std::vector<InstructionSetVector> m_liveSets;
   InstructionSetVector              m_allLiveSet;
-  llvm::SmallSet<llvm::BasicBlock*, 8>             m_activeBlocks;
+  llvm::SmallPtrSet<llvm::BasicBlock*, 8>          m_activeBlocks;
   llvm::DenseMap<llvm::Instruction*, unsigned int> m_computeLiveAtIndex;
   llvm::DenseMap<const llvm::Value*, Indices>      m_liveAtIndices;
 
-  typedef llvm::SmallSet<llvm::BasicBlock*, 8> BlockSet;
+  typedef llvm::SmallPtrSet<llvm::BasicBlock*, 8> BlockSet;
 
+  Indices& getOrCreateIndices(const llvm::Value* value);
   void markLiveRange(llvm::Instruction* value, llvm::BasicBlock::iterator begin, llvm::BasicBlock::iterator end);
   void upAndMark(llvm::Instruction* v, llvm::Use& use, BlockSet& scanned);
 };
@@ -629,15 +629,23 @@ private:
 
 
 
-StateFunctionTransform::StateFunctionTransform(Function* func, const std::vector<std::string>& candidateFuncNames, Type* runtimeDataArgTy)
+StateFunctionTransform::CandidateFuncIndexMap StateFunctionTransform::createCandidateFuncIndexMap(const std::vector<std::string>& candidateFuncNames)
+{
+  CandidateFuncIndexMap candidateFuncIndices;
+  for (int i = 0; i < (int)candidateFuncNames.size(); ++i)
+    candidateFuncIndices[candidateFuncNames[i]] = i;
+  return candidateFuncIndices;
+}
+
+StateFunctionTransform::StateFunctionTransform(Function* func, const CandidateFuncIndexMap& candidateFuncIndices, Type* runtimeDataArgTy)
   : m_function(func)
-  , m_candidateFuncNames(candidateFuncNames)
+  , m_candidateFuncIndices(candidateFuncIndices)
   , m_runtimeDataArgTy(runtimeDataArgTy)
 {
   m_functionName = cleanName(m_function->getName());
-  auto it = std::find(m_candidateFuncNames.begin(), m_candidateFuncNames.end(), m_functionName);
-  assert(it != m_candidateFuncNames.end());
-  m_functionIdx = it - m_candidateFuncNames.begin();
+  auto it = m_candidateFuncIndices.find(m_functionName);
+  assert(it != m_candidateFuncIndices.end());
+  m_functionIdx = it->second;
 }
 
 void StateFunctionTransform::setAttributeSize(int size)
@@ -779,11 +787,6 @@ void StateFunctionTransform::init()
 
 void StateFunctionTransform::findCallSitesIntrinsicsAndReturns()
 {
-  // Create a map for log N lookup
-  std::map<std::string, int> candidateFuncMap;
-  for (int i = 0; i < (int)m_candidateFuncNames.size(); ++i)
-    candidateFuncMap[m_candidateFuncNames[i]] = i;
-
   for (auto& I : inst_range(m_function))
   {
     if (CallInst* call = dyn_cast<CallInst>(&I))
@@ -797,8 +800,8 @@ void StateFunctionTransform::findCallSitesIntrinsicsAndReturns()
         m_callSites.push_back(call);
       else
       {
-        auto it = candidateFuncMap.find(cleanName(calledFuncName));
-        if (it == candidateFuncMap.end())
+        auto it = m_candidateFuncIndices.find(cleanName(calledFuncName));
+        if (it == m_candidateFuncIndices.end())
           continue;
 
         assert(call->getCalledFunction()->getReturnType() == Type::getVoidTy(call->getContext()) && "Continuations with returns not supported");
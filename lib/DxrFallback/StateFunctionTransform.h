@@ -2,6 +2,7 @@
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/StringMap.h"
 
 #include <map>
 #include <string>
@@ -174,11 +175,17 @@ public:
     PST_COUNT
   };
 
-  // func is the function to be transformed. candidateFuncNames is a list of all 
+  // Maps the name of each candidate function to its index in the list of
+  // candidate functions.
+  typedef llvm::StringMap<int> CandidateFuncIndexMap;
+  static CandidateFuncIndexMap createCandidateFuncIndexMap(const std::vector<std::string>& candidateFuncNames);
+
+  // func is the function to be transformed. candidateFuncIndices indexes all 
   // functions that which have been or will be transformed to state functions, 
-  // including func. The runtimeDataArgTy is the type to use for the first argument
-  // in state functions.
-  StateFunctionTransform(llvm::Function* func, const std::vector<std::string>& candidateFuncNames, llvm::Type* runtimeDataArgTy);
+  // including func. It is built once with createCandidateFuncIndexMap() and
+  // shared by the transforms of all candidates. The runtimeDataArgTy is the
+  // type to use for the first argument in state functions.
+  StateFunctionTransform(llvm::Function* func, const CandidateFuncIndexMap& candidateFuncIndices, llvm::Type* runtimeDataArgTy);
 
   // Optional parameters to be specified before run()
   void setAttributeSize(int sizeInBytes); // needed for TraceRay()
@@ -210,13 +217,13 @@ private:
   // Name of the function to transform
   std::string m_functionName;
 
-  // Index of the function to transform in m_candidateFuncNames
+  // Index of the function to transform in the candidate functions
   int m_functionIdx = 0;
 
-  // cadidateFuncNames is a list of all functions that which have been or will 
-  // be transformed to state functions. Used to create function index used
-  // by the stateID placeholder function.
-  const std::vector<std::string>& m_candidateFuncNames;
+  // Indices of all functions that which have been or will be transformed to
+  // state functions. Used to create function index used by the stateID
+  // placeholder function.
+  const CandidateFuncIndexMap& m_candidateFuncIndices;
 
   llvm::Type* m_runtimeDataArgTy = nullptr;
   llvm::Value* m_runtimeDataArg = nullptr;     // set in init() and changeFunctionSignature()
@@ -31,6 +31,7 @@
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/IR/IRPrintingPasses.h"
 #include "llvm/IR/LegacyPassManager.h"
@@ -39,7 +40,9 @@
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 
 #include <algorithm>
+#include <chrono>
 #include <list>   // should change this for string_table
+#include <map>
 #include <vector>
 
 #include "llvm/PassPrinters/PassPrinters.h"
@@ -205,7 +208,7 @@ static ArrayRef<LPCSTR> GetPassArgNames(LPCSTR passName) {
   static const LPCSTR CFGSimplifyPassArgs[] = { "Threshold", "Ftor", "bonus-inst-threshold" };
   static const LPCSTR DxilAddPixelHitInstrumentationArgs[] = { "force-early-z", "add-pixel-cost", "rt-width", "sv-position-index", "num-pixels" };
   static const LPCSTR DxilConditionalMem2RegArgs[] = { "NoOpt" };
-  static const LPCSTR DxilDebugInstrumentationArgs[] = { "UAVSize", "parameter0", "parameter1", "parameter2" };
+  static const LPCSTR DxilDebugInstrumentationArgs[] = { "UAVSize", "parameter0", "parameter1", "parameter2", "compact" };
   static const LPCSTR DxilGenerationPassArgs[] = { "NotOptimized" };
   static const LPCSTR DxilInsertPreservesArgs[] = { "AllowPreserves" };
   static const LPCSTR DxilLoopUnrollArgs[] = { "MaxIterationAttempt", "OnlyWarnOnFail" };
@@ -288,7 +291,7 @@ static ArrayRef<LPCSTR> GetPassArgDescriptions(LPCSTR passName) {
   static const LPCSTR CFGSimplifyPassArgs[] = { "None", "None", "Control the number of bonus instructions (default = 1)" };
   static const LPCSTR DxilAddPixelHitInstrumentationArgs[] = { "None", "None", "None", "None", "None" };
   static const LPCSTR DxilConditionalMem2RegArgs[] = { "None" };
-  static const LPCSTR DxilDebugInstrumentationArgs[] = { "None", "None", "None", "None" };
+  static const LPCSTR DxilDebugInstrumentationArgs[] = { "None", "None", "None", "None", "Write one record per basic block, leaving out values known at compile time" };
   static const LPCSTR DxilGenerationPassArgs[] = { "None" };
   static const LPCSTR DxilInsertPreservesArgs[] = { "None" };
   static const LPCSTR DxilLoopUnrollArgs[] = { "Maximum number of iterations to attempt when iteratively unrolling.", "Whether to just warn when unrolling fails." };
@@ -393,6 +396,7 @@ static bool IsPassOptionName(StringRef S) {
     ||  S.equals("add-pixel-cost")
     ||  S.equals("bonus-inst-threshold")
     ||  S.equals("checkForDynamicIndexing")
+    ||  S.equals("compact")
     ||  S.equals("config")
     ||  S.equals("constant-alpha")
     ||  S.equals("constant-blue")
@@ -524,7 +528,7 @@ public:
   }
 };
 
-class DxcOptimizer : public IDxcOptimizer {
+class DxcOptimizer : public IDxcOptimizer2 {
 private:
   DXC_MICROCOM_TM_REF_FIELDS()
   PassRegistry *m_registry;
@@ -534,7 +538,7 @@ public:
   DXC_MICROCOM_TM_CTOR(DxcOptimizer)
 
   HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
-    return DoBasicQueryInterface<IDxcOptimizer>(this, iid, ppvObject);
+    return DoBasicQueryInterface<IDxcOptimizer2, IDxcOptimizer>(this, iid, ppvObject);
   }
 
   HRESULT Initialize();
@@ -548,6 +552,8 @@ public:
     _In_count_(optionCount) LPCWSTR *ppOptions, UINT32 optionCount,
     _COM_Outptr_ IDxcBlob **ppOutputModule,
     _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) override;
+  HRESULT STDMETHODCALLTYPE CreateSession(IDxcBlob *pBlob,
+    _COM_Outptr_ IDxcOptimizerSession **ppSession) override;
 };
 
 class CapturePassManager : public llvm::legacy::PassManagerBase {
@@ -610,250 +616,523 @@ HRESULT STDMETHODCALLTYPE DxcOptimizer::GetAvailablePass(
       GetPassArgDescriptions(m_passes[index]->getPassArgument()), ppResult);
 }
 
-HRESULT STDMETHODCALLTYPE DxcOptimizer::RunOptimizer(
-    IDxcBlob *pBlob, _In_count_(optionCount) LPCWSTR *ppOptions,
-    UINT32 optionCount, _COM_Outptr_ IDxcBlob **ppOutputModule,
-    _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) {
-  AssignToOutOpt(nullptr, ppOutputModule);
-  AssignToOutOpt(nullptr, ppOutputText);
-  if (pBlob == nullptr)
-    return E_POINTER;
-  if (optionCount > 0 && ppOptions == nullptr)
-    return E_POINTER;
+namespace {
 
-  DxcThreadMalloc TM(m_pMalloc);
+struct OptimizerPassStats {
+  std::string PassName;
+  double Milliseconds;
+  unsigned Functions;
+  unsigned Blocks;
+  unsigned Instructions;
+};
 
-  // Setup input buffer.
-  //
-  // The ir parsing requires the buffer to be null terminated. We deal with
-  // both source and bitcode input, so the input buffer may not be null
-  // terminated; we create a new membuf that copies and appends for this.
-  //
-  // If we have the beginning of a DXIL program header, skip to the bitcode.
-  //
-  LLVMContext Context;
-  SMDiagnostic Err;
-  std::unique_ptr<MemoryBuffer> memBuf;
-  std::unique_ptr<Module> M;
-  const char * pBlobContent = reinterpret_cast<const char *>(pBlob->GetBufferPointer());
-  unsigned blobSize = pBlob->GetBufferSize();
-  const DxilProgramHeader *pProgramHeader =
-    reinterpret_cast<const DxilProgramHeader *>(pBlobContent);
-  if (IsValidDxilProgramHeader(pProgramHeader, blobSize)) {
-    std::string DiagStr;
-    GetDxilProgramBitcode(pProgramHeader, &pBlobContent, &blobSize);
-    M = hlsl::dxilutil::LoadModuleFromBitcode(
-      llvm::StringRef(pBlobContent, blobSize), Context, DiagStr);
+// Collects the statistics of one pipeline run. Each pass is charged with the
+// time since the previous record, which includes the analyses it required.
+class OptimizerStatsCollector {
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point m_Last;
+
+public:
+  std::vector<OptimizerPassStats> Stats;
+
+  void Start() {
+    Stats.clear();
+    m_Last = Clock::now();
   }
-  else {
-    StringRef bufStrRef(pBlobContent, blobSize);
-    memBuf = MemoryBuffer::getMemBufferCopy(bufStrRef);
-    M = parseIR(memBuf->getMemBufferRef(), Err, Context);
+
+  void Record(StringRef PassName, Module &M) {
+    Clock::time_point Now = Clock::now();
+    OptimizerPassStats PS;
+    PS.PassName = PassName;
+    PS.Milliseconds =
+        std::chrono::duration<double, std::milli>(Now - m_Last).count();
+    PS.Functions = PS.Blocks = PS.Instructions = 0;
+    for (Function &F : M) {
+      if (F.isDeclaration())
+        continue;
+      ++PS.Functions;
+      for (BasicBlock &BB : F) {
+        ++PS.Blocks;
+        PS.Instructions += BB.size();
+      }
+    }
+    Stats.push_back(std::move(PS));
+    // Counting is not charged to the next pass.
+    m_Last = Clock::now();
   }
+};
 
-  if (M == nullptr) {
-    return DXC_E_IR_VERIFICATION_FAILED;
+// Follows each module-level pass of a pipeline built with -opt-stats.
+class OptimizerStatsProbe : public ModulePass {
+  std::string m_PassName;
+  OptimizerStatsCollector &m_Collector;
+
+public:
+  static char ID;
+  OptimizerStatsProbe(StringRef PassName, OptimizerStatsCollector &Collector)
+      : ModulePass(ID), m_PassName(PassName), m_Collector(Collector) {}
+
+  const char *getPassName() const override { return "Optimizer Statistics"; }
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.setPreservesAll();
+  }
+  bool runOnModule(Module &M) override {
+    m_Collector.Record(m_PassName, M);
+    return false;
   }
+};
 
-  legacy::PassManager ModulePasses;
-  legacy::FunctionPassManager FunctionPasses(M.get());
-  legacy::PassManagerBase *pPassManager = &ModulePasses;
+char OptimizerStatsProbe::ID = 0;
 
-  try {
-    CComPtr<AbstractMemoryStream> pOutputStream;
-    CComPtr<IDxcBlob> pOutputBlob;
+void WriteStatsHeader(raw_ostream &OS) {
+  OS << "pipeline\tpass\tms\tfunctions\tblocks\tinstructions\n";
+}
 
-    IFT(CreateMemoryStream(m_pMalloc, &pOutputStream));
-    IFT(pOutputStream.QueryInterface(&pOutputBlob));
+void WriteStats(raw_ostream &OS, StringRef Pipeline,
+                ArrayRef<OptimizerPassStats> Stats) {
+  for (const OptimizerPassStats &PS : Stats) {
+    OS << Pipeline << '\t' << PS.PassName << '\t'
+       << format("%.3f", PS.Milliseconds) << '\t' << PS.Functions << '\t'
+       << PS.Blocks << '\t' << PS.Instructions << '\n';
+  }
+}
 
-    raw_stream_ostream outStream(pOutputStream.p);
+// Passes built from RunOptimizer options for one module. The passes write
+// their text output to the stream given at construction, which must outlive
+// the pipeline. A pipeline may run any number of times.
+class OptimizerPipeline {
+  legacy::PassManager m_ModulePasses;
+  legacy::FunctionPassManager m_FunctionPasses;
+  bool m_HasFunctionPasses = false;
+  raw_ostream &m_OS;
+  std::unique_ptr<OptimizerStatsCollector> m_pStats;
 
-    //
-    // Consider some differences from opt.exe:
-    //
-    // Create a new optimization pass for each one specified on the command line
-    // as in StandardLinkOpts, OptLevelO1, etc.
-    // No target machine, and so no passes get their target machine ctor called.
-    // No print-after-each-pass option.
-    // No printing of the pass options.
-    // No StripDebug support.
-    // No verifyModule before starting.
-    // Use of PassPipeline for new manager.
-    // No TargetInfo.
-    // No DataLayout.
-    //
-    bool OutputAssembly = false;
-    bool AnalyzeOnly = false;
-
-    // First gather flags, wherever they may be.
-    SmallVector<UINT32, 2> handled;
-    for (UINT32 i = 0; i < optionCount; ++i) {
-      if (wcseq(L"-S", ppOptions[i])) {
-        OutputAssembly = true;
-        handled.push_back(i);
-        continue;
-      }
-      if (wcseq(L"-analyze", ppOptions[i])) {
-        AnalyzeOnly = true;
-        handled.push_back(i);
-        continue;
-      }
+public:
+  OptimizerPipeline(Module *M, raw_ostream &OS)
+      : m_FunctionPasses(M), m_OS(OS) {}
+
+  HRESULT Build(DxcOptimizer *pOptimizer, LPCWSTR *ppOptions,
+                UINT32 optionCount);
+  void Run(Module &M);
+
+  // Statistics of the last run, or null without -opt-stats.
+  const OptimizerStatsCollector *GetStats() const { return m_pStats.get(); }
+};
+
+HRESULT OptimizerPipeline::Build(DxcOptimizer *pOptimizer,
+                                 LPCWSTR *ppOptions, UINT32 optionCount) {
+  legacy::PassManagerBase *pPassManager = &m_ModulePasses;
+
+  //
+  // Consider some differences from opt.exe:
+  //
+  // Create a new optimization pass for each one specified on the command line
+  // as in StandardLinkOpts, OptLevelO1, etc.
+  // No target machine, and so no passes get their target machine ctor called.
+  // No print-after-each-pass option.
+  // No printing of the pass options.
+  // No StripDebug support.
+  // No verifyModule before starting.
+  // Use of PassPipeline for new manager.
+  // No TargetInfo.
+  // No DataLayout.
+  //
+  bool OutputAssembly = false;
+  bool AnalyzeOnly = false;
+
+  // First gather flags, wherever they may be.
+  SmallVector<UINT32, 2> handled;
+  for (UINT32 i = 0; i < optionCount; ++i) {
+    if (wcseq(L"-S", ppOptions[i])) {
+      OutputAssembly = true;
+      handled.push_back(i);
+      continue;
     }
+    if (wcseq(L"-analyze", ppOptions[i])) {
+      AnalyzeOnly = true;
+      handled.push_back(i);
+      continue;
+    }
+    if (wcseq(L"-opt-stats", ppOptions[i])) {
+      m_pStats.reset(new OptimizerStatsCollector());
+      handled.push_back(i);
+      continue;
+    }
+  }
 
-    // TODO: should really use string_table for this once that's available
-    std::list<std::string> optionsAnsi;
-    SmallVector<PassOption, 2> options;
-    for (UINT32 i = 0; i < optionCount; ++i) {
-      if (std::find(handled.begin(), handled.end(), i) != handled.end()) {
-        continue;
-      }
+  // TODO: should really use string_table for this once that's available
+  std::list<std::string> optionsAnsi;
+  SmallVector<PassOption, 2> options;
+  for (UINT32 i = 0; i < optionCount; ++i) {
+    if (std::find(handled.begin(), handled.end(), i) != handled.end()) {
+      continue;
+    }
 
-      // Handle some special cases where we can inject a redirected output stream.
-      if (wcsstartswith(ppOptions[i], L"-print-module")) {
-        LPCWSTR pName = ppOptions[i] + _countof(L"-print-module") - 1;
-        std::string Banner;
-        if (*pName) {
-          IFTARG(*pName != L':' || *pName != L'=');
-          ++pName;
-          CW2A name8(pName);
-          Banner = "MODULE-PRINT ";
-          Banner += name8.m_psz;
-          Banner += "\n";
-        }
-        if (pPassManager == &ModulePasses)
-          pPassManager->add(llvm::createPrintModulePass(outStream, Banner));
-        continue;
+    // Handle some special cases where we can inject a redirected output stream.
+    if (wcsstartswith(ppOptions[i], L"-print-module")) {
+      LPCWSTR pName = ppOptions[i] + _countof(L"-print-module") - 1;
+      std::string Banner;
+      if (*pName) {
+        IFTARG(*pName != L':' || *pName != L'=');
+        ++pName;
+        CW2A name8(pName);
+        Banner = "MODULE-PRINT ";
+        Banner += name8.m_psz;
+        Banner += "\n";
       }
+      if (pPassManager == &m_ModulePasses)
+        pPassManager->add(llvm::createPrintModulePass(m_OS, Banner));
+      continue;
+    }
 
-      // Handle special switches to toggle per-function prepasses vs. module passes.
-      if (wcseq(ppOptions[i], L"-opt-fn-passes")) {
-        pPassManager = &FunctionPasses;
-        continue;
-      }
-      if (wcseq(ppOptions[i], L"-opt-mod-passes")) {
-        pPassManager = &ModulePasses;
-        continue;
-      }
+    // Handle special switches to toggle per-function prepasses vs. module passes.
+    if (wcseq(ppOptions[i], L"-opt-fn-passes")) {
+      pPassManager = &m_FunctionPasses;
+      continue;
+    }
+    if (wcseq(ppOptions[i], L"-opt-mod-passes")) {
+      pPassManager = &m_ModulePasses;
+      continue;
+    }
 
-      CW2A optName(ppOptions[i], CP_UTF8);
-      // The option syntax is
-      const char ArgDelim = ',';
-      // '-' OPTION_NAME (',' ARG_NAME ('=' ARG_VALUE)?)*
-      char *pCursor = optName.m_psz;
-      const char *pEnd = optName.m_psz + strlen(optName.m_psz);
-      if (*pCursor != '-' && *pCursor != '/') {
+    CW2A optName(ppOptions[i], CP_UTF8);
+    // The option syntax is
+    const char ArgDelim = ',';
+    // '-' OPTION_NAME (',' ARG_NAME ('=' ARG_VALUE)?)*
+    char *pCursor = optName.m_psz;
+    const char *pEnd = optName.m_psz + strlen(optName.m_psz);
+    if (*pCursor != '-' && *pCursor != '/') {
+      return E_INVALIDARG;
+    }
+    ++pCursor;
+    const char *pOptionNameStart = pCursor;
+    while (*pCursor && *pCursor != ArgDelim) {
+      ++pCursor;
+    }
+    *pCursor = '\0';
+    const llvm::PassInfo *PassInf = pOptimizer->getPassByName(pOptionNameStart);
+    if (!PassInf) {
+      return E_INVALIDARG;
+    }
+    while (pCursor < pEnd) {
+      // *pCursor is '\0' when we overwrite ',' to get a null-terminated string
+      if (*pCursor && *pCursor != ArgDelim) {
         return E_INVALIDARG;
       }
       ++pCursor;
-      const char *pOptionNameStart = pCursor;
+      const char *pArgStart = pCursor;
       while (*pCursor && *pCursor != ArgDelim) {
         ++pCursor;
       }
-      *pCursor = '\0';
-      const llvm::PassInfo *PassInf = getPassByName(pOptionNameStart);
-      if (!PassInf) {
+      StringRef argString = StringRef(pArgStart, pCursor - pArgStart);
+      std::pair<StringRef, StringRef> nameValue = argString.split('=');
+      if (!IsPassOptionName(nameValue.first)) {
         return E_INVALIDARG;
       }
-      while (pCursor < pEnd) {
-        // *pCursor is '\0' when we overwrite ',' to get a null-terminated string
-        if (*pCursor && *pCursor != ArgDelim) {
-          return E_INVALIDARG;
-        }
-        ++pCursor;
-        const char *pArgStart = pCursor;
-        while (*pCursor && *pCursor != ArgDelim) {
-          ++pCursor;
-        }
-        StringRef argString = StringRef(pArgStart, pCursor - pArgStart);
-        std::pair<StringRef, StringRef> nameValue = argString.split('=');
-        if (!IsPassOptionName(nameValue.first)) {
-          return E_INVALIDARG;
-        }
 
-        PassOption *OptionPos = std::lower_bound(options.begin(), options.end(), nameValue, PassOptionsCompare());
-        // If empty, remove if available; otherwise upsert.
-        if (nameValue.second.empty()) {
-          if (OptionPos != options.end() && OptionPos->first == nameValue.first) {
-            options.erase(OptionPos);
-          }
+      PassOption *OptionPos = std::lower_bound(options.begin(), options.end(), nameValue, PassOptionsCompare());
+      // If empty, remove if available; otherwise upsert.
+      if (nameValue.second.empty()) {
+        if (OptionPos != options.end() && OptionPos->first == nameValue.first) {
+          options.erase(OptionPos);
+        }
+      }
+      else {
+        if (OptionPos != options.end() && OptionPos->first == nameValue.first) {
+          OptionPos->second = nameValue.second;
         }
         else {
-          if (OptionPos != options.end() && OptionPos->first == nameValue.first) {
-            OptionPos->second = nameValue.second;
-          }
-          else {
-            options.insert(OptionPos, nameValue);
-          }
+          options.insert(OptionPos, nameValue);
         }
       }
+    }
 
-      DXASSERT(PassInf->getNormalCtor(), "else pass with no default .ctor was added");
-      Pass *pass = PassInf->getNormalCtor()();
-      pass->setOSOverride(&outStream);
-      pass->applyOptions(options);
-      options.clear();
-      pPassManager->add(pass);
-      if (AnalyzeOnly) {
-        const bool Quiet = false;
-        PassKind Kind = pass->getPassKind();
-        switch (Kind) {
-        case PT_BasicBlock:
-          pPassManager->add(createBasicBlockPassPrinter(PassInf, outStream, Quiet));
-          break;
-        case PT_Region:
-          pPassManager->add(createRegionPassPrinter(PassInf, outStream, Quiet));
-          break;
-        case PT_Loop:
-          pPassManager->add(createLoopPassPrinter(PassInf, outStream, Quiet));
-          break;
-        case PT_Function:
-          pPassManager->add(createFunctionPassPrinter(PassInf, outStream, Quiet));
-          break;
-        case PT_CallGraphSCC:
-          pPassManager->add(createCallGraphPassPrinter(PassInf, outStream, Quiet));
-          break;
-        default:
-          pPassManager->add(createModulePassPrinter(PassInf, outStream, Quiet));
-          break;
-        }
+    DXASSERT(PassInf->getNormalCtor(), "else pass with no default .ctor was added");
+    Pass *pass = PassInf->getNormalCtor()();
+    pass->setOSOverride(&m_OS);
+    pass->applyOptions(options);
+    options.clear();
+    pPassManager->add(pass);
+    if (AnalyzeOnly) {
+      const bool Quiet = false;
+      PassKind Kind = pass->getPassKind();
+      switch (Kind) {
+      case PT_BasicBlock:
+        pPassManager->add(createBasicBlockPassPrinter(PassInf, m_OS, Quiet));
+        break;
+      case PT_Region:
+        pPassManager->add(createRegionPassPrinter(PassInf, m_OS, Quiet));
+        break;
+      case PT_Loop:
+        pPassManager->add(createLoopPassPrinter(PassInf, m_OS, Quiet));
+        break;
+      case PT_Function:
+        pPassManager->add(createFunctionPassPrinter(PassInf, m_OS, Quiet));
+        break;
+      case PT_CallGraphSCC:
+        pPassManager->add(createCallGraphPassPrinter(PassInf, m_OS, Quiet));
+        break;
+      default:
+        pPassManager->add(createModulePassPrinter(PassInf, m_OS, Quiet));
+        break;
       }
     }
+    if (pPassManager == &m_FunctionPasses)
+      m_HasFunctionPasses = true;
+    else if (m_pStats)
+      m_ModulePasses.add(
+          new OptimizerStatsProbe(PassInf->getPassArgument(), *m_pStats));
+  }
 
-    ModulePasses.add(createVerifierPass());
 
-    if (OutputAssembly) {
-      ModulePasses.add(llvm::createPrintModulePass(outStream));
-    }
+  m_ModulePasses.add(createVerifierPass());
+
+  if (OutputAssembly) {
+    m_ModulePasses.add(llvm::createPrintModulePass(m_OS));
+  }
+  return S_OK;
+}
 
-    // Now that we have all of the passes ready, run them.
+void OptimizerPipeline::Run(Module &M) {
+  ScopedFatalErrorHandler errHandler(FatalErrorHandlerStreamWrite, &m_OS);
+
+  if (m_pStats)
+    m_pStats->Start();
+  m_FunctionPasses.doInitialization();
+  for (Function &F : M)
+    if (!F.isDeclaration())
+      m_FunctionPasses.run(F);
+  m_FunctionPasses.doFinalization();
+  if (m_pStats && m_HasFunctionPasses)
+    m_pStats->Record("opt-fn-passes", M);
+  m_ModulePasses.run(M);
+}
+
+// Setup input buffer.
+//
+// The ir parsing requires the buffer to be null terminated. We deal with
+// both source and bitcode input, so the input buffer may not be null
+// terminated; we create a new membuf that copies and appends for this.
+//
+// If we have the beginning of a DXIL program header, skip to the bitcode.
+//
+std::unique_ptr<Module> LoadOptimizerInput(IDxcBlob *pBlob,
+                                           LLVMContext &Context) {
+  SMDiagnostic Err;
+  std::unique_ptr<MemoryBuffer> memBuf;
+  const char * pBlobContent = reinterpret_cast<const char *>(pBlob->GetBufferPointer());
+  unsigned blobSize = pBlob->GetBufferSize();
+  const DxilProgramHeader *pProgramHeader =
+    reinterpret_cast<const DxilProgramHeader *>(pBlobContent);
+  if (IsValidDxilProgramHeader(pProgramHeader, blobSize)) {
+    std::string DiagStr;
+    GetDxilProgramBitcode(pProgramHeader, &pBlobContent, &blobSize);
+    return hlsl::dxilutil::LoadModuleFromBitcode(
+      llvm::StringRef(pBlobContent, blobSize), Context, DiagStr);
+  }
+  StringRef bufStrRef(pBlobContent, blobSize);
+  memBuf = MemoryBuffer::getMemBufferCopy(bufStrRef);
+  return parseIR(memBuf->getMemBufferRef(), Err, Context);
+}
+
+HRESULT WriteOptimizerModule(IMalloc *pMalloc, Module &M,
+                             IDxcBlob **ppOutputModule,
+                             IDxcBlobEncoding **ppOutputText) {
+  if (ppOutputModule != nullptr) {
+    CComPtr<AbstractMemoryStream> pProgramStream;
+    IFR(CreateMemoryStream(pMalloc, &pProgramStream));
+    {
+      raw_stream_ostream outStream(pProgramStream.p);
+      WriteBitcodeToFile(&M, outStream, true);
+    }
+    IFR(pProgramStream.QueryInterface(ppOutputModule));
+  }
+  if (ppOutputText != nullptr) {
+    std::string Text;
     {
-      raw_ostream *err_ostream = &outStream;
-      ScopedFatalErrorHandler errHandler(FatalErrorHandlerStreamWrite, err_ostream);
-
-      FunctionPasses.doInitialization();
-      for (Function &F : *M.get())
-        if (!F.isDeclaration())
-          FunctionPasses.run(F);
-      FunctionPasses.doFinalization();
-      ModulePasses.run(*M.get());
+      raw_string_ostream OS(Text);
+      M.print(OS, nullptr);
+    }
+    IFR(DxcCreateBlobWithEncodingOnHeapCopy(Text.data(), Text.size(), CP_UTF8,
+                                            ppOutputText));
+  }
+  return S_OK;
+}
+
+} // namespace
+
+HRESULT STDMETHODCALLTYPE DxcOptimizer::RunOptimizer(
+    IDxcBlob *pBlob, _In_count_(optionCount) LPCWSTR *ppOptions,
+    UINT32 optionCount, _COM_Outptr_ IDxcBlob **ppOutputModule,
+    _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) {
+  AssignToOutOpt(nullptr, ppOutputModule);
+  AssignToOutOpt(nullptr, ppOutputText);
+  if (pBlob == nullptr)
+    return E_POINTER;
+  if (optionCount > 0 && ppOptions == nullptr)
+    return E_POINTER;
+
+  DxcThreadMalloc TM(m_pMalloc);
+
+  LLVMContext Context;
+  std::unique_ptr<Module> M = LoadOptimizerInput(pBlob, Context);
+  if (M == nullptr) {
+    return DXC_E_IR_VERIFICATION_FAILED;
+  }
+
+  try {
+    CComPtr<AbstractMemoryStream> pOutputStream;
+    CComPtr<IDxcBlob> pOutputBlob;
+
+    IFT(CreateMemoryStream(m_pMalloc, &pOutputStream));
+    IFT(pOutputStream.QueryInterface(&pOutputBlob));
+
+    raw_stream_ostream outStream(pOutputStream.p);
+
+    OptimizerPipeline Pipeline(M.get(), outStream);
+    IFR(Pipeline.Build(this, ppOptions, optionCount));
+    Pipeline.Run(*M);
+    if (const OptimizerStatsCollector *pStats = Pipeline.GetStats()) {
+      WriteStatsHeader(outStream);
+      WriteStats(outStream, "-", pStats->Stats);
     }
 
     outStream.flush();
     if (ppOutputText != nullptr) {
       IFT(DxcCreateBlobWithEncodingSet(pOutputBlob, CP_UTF8, ppOutputText));
     }
-    if (ppOutputModule != nullptr) {
-      CComPtr<AbstractMemoryStream> pProgramStream;
-      IFT(CreateMemoryStream(m_pMalloc, &pProgramStream));
-      {
-        raw_stream_ostream outStream(pProgramStream.p);
-        WriteBitcodeToFile(M.get(), outStream, true);
+    IFT(WriteOptimizerModule(m_pMalloc, *M, ppOutputModule, nullptr));
+  }
+  CATCH_CPP_RETURN_HRESULT();
+
+  return S_OK;
+}
+
+class DxcOptimizerSession : public IDxcOptimizerSession {
+private:
+  DXC_MICROCOM_TM_REF_FIELDS()
+  CComPtr<DxcOptimizer> m_pOptimizer;
+  LLVMContext m_Context;
+  std::unique_ptr<Module> m_pModule;
+  // Each pipeline keeps the text its passes write until the run returns it.
+  struct NamedPipeline {
+    std::string Text;
+    raw_string_ostream OS;
+    std::unique_ptr<OptimizerPipeline> Pipeline;
+    NamedPipeline() : OS(Text) {}
+  };
+  std::map<std::wstring, std::unique_ptr<NamedPipeline>> m_Pipelines;
+  std::string m_Stats;
+
+public:
+  DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
+  DXC_MICROCOM_TM_CTOR(DxcOptimizerSession)
+
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
+    return DoBasicQueryInterface<IDxcOptimizerSession>(this, iid, ppvObject);
+  }
+
+  HRESULT Initialize(DxcOptimizer *pOptimizer, IDxcBlob *pBlob) {
+    m_pOptimizer = pOptimizer;
+    m_pModule = LoadOptimizerInput(pBlob, m_Context);
+    if (m_pModule == nullptr)
+      return DXC_E_IR_VERIFICATION_FAILED;
+    raw_string_ostream OS(m_Stats);
+    WriteStatsHeader(OS);
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE DefinePipeline(_In_z_ LPCWSTR pName,
+    _In_count_(optionCount) LPCWSTR *ppOptions, UINT32 optionCount) override {
+    if (pName == nullptr)
+      return E_POINTER;
+    if (optionCount > 0 && ppOptions == nullptr)
+      return E_POINTER;
+
+    DxcThreadMalloc TM(m_pMalloc);
+    try {
+      std::unique_ptr<NamedPipeline> pNamed(new NamedPipeline());
+      pNamed->Pipeline.reset(new OptimizerPipeline(m_pModule.get(), pNamed->OS));
+      IFR(pNamed->Pipeline->Build(m_pOptimizer, ppOptions, optionCount));
+      m_Pipelines[pName] = std::move(pNamed);
+    }
+    CATCH_CPP_RETURN_HRESULT();
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE RunPipeline(_In_z_ LPCWSTR pName,
+    _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) override {
+    AssignToOutOpt(nullptr, ppOutputText);
+    if (pName == nullptr)
+      return E_POINTER;
+
+    DxcThreadMalloc TM(m_pMalloc);
+    try {
+      auto It = m_Pipelines.find(pName);
+      if (It == m_Pipelines.end())
+        return E_INVALIDARG;
+      NamedPipeline &Named = *It->second;
+      Named.Pipeline->Run(*m_pModule);
+      Named.OS.flush();
+      if (const OptimizerStatsCollector *pStats = Named.Pipeline->GetStats()) {
+        CW2A name8(pName, CP_UTF8);
+        raw_string_ostream OS(m_Stats);
+        WriteStats(OS, name8.m_psz, pStats->Stats);
+      }
+      std::string Text;
+      Text.swap(Named.Text);
+      if (ppOutputText != nullptr) {
+        IFT(DxcCreateBlobWithEncodingOnHeapCopy(Text.data(), Text.size(),
+                                                CP_UTF8, ppOutputText));
       }
-      IFT(pProgramStream.QueryInterface(ppOutputModule));
     }
+    CATCH_CPP_RETURN_HRESULT();
+    return S_OK;
   }
-  CATCH_CPP_RETURN_HRESULT();
 
+  HRESULT STDMETHODCALLTYPE GetModule(
+    _COM_Outptr_opt_ IDxcBlob **ppOutputModule,
+    _COM_Outptr_opt_ IDxcBlobEncoding **ppOutputText) override {
+    AssignToOutOpt(nullptr, ppOutputModule);
+    AssignToOutOpt(nullptr, ppOutputText);
+
+    DxcThreadMalloc TM(m_pMalloc);
+    try {
+      IFT(WriteOptimizerModule(m_pMalloc, *m_pModule, ppOutputModule,
+                               ppOutputText));
+    }
+    CATCH_CPP_RETURN_HRESULT();
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE GetStatistics(
+    _COM_Outptr_ IDxcBlobEncoding **ppStatistics) override {
+    if (ppStatistics == nullptr)
+      return E_POINTER;
+    *ppStatistics = nullptr;
+    DxcThreadMalloc TM(m_pMalloc);
+    return DxcCreateBlobWithEncodingOnHeapCopy(m_Stats.data(), m_Stats.size(),
+                                               CP_UTF8, ppStatistics);
+  }
+};
+
+HRESULT STDMETHODCALLTYPE DxcOptimizer::CreateSession(
+    IDxcBlob *pBlob, _COM_Outptr_ IDxcOptimizerSession **ppSession) {
+  if (ppSession == nullptr)
+    return E_POINTER;
+  *ppSession = nullptr;
+  if (pBlob == nullptr)
+    return E_POINTER;
+
+  DxcThreadMalloc TM(m_pMalloc);
+  try {
+    CComPtr<DxcOptimizerSession> pSession =
+        DxcOptimizerSession::Alloc(m_pMalloc);
+    IFROOM(pSession.p);
+    IFR(pSession->Initialize(this, pBlob));
+    *ppSession = pSession.Detach();
+  }
+  CATCH_CPP_RETURN_HRESULT();
   return S_OK;
 }
 
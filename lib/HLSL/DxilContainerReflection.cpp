@@ -15,6 +15,7 @@
 #include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Operator.h"
 #include "dxc/DxilContainer/DxilContainer.h"
+#include "dxc/DxilContainer/DxilContainerAssembler.h"
 #include "dxc/DXIL/DxilModule.h"
 #include "dxc/DXIL/DxilShaderModel.h"
 #include "dxc/DXIL/DxilOperations.h"
@@ -120,6 +121,8 @@ public:
 
   HRESULT LoadRDAT(const DxilPartHeader *pPart);
   HRESULT LoadModule(const DxilPartHeader *pPart);
+  // Reflects a module owned by the caller, which must outlive this object.
+  HRESULT LoadModule(Module *pModule);
 
   // Common code
   ID3D12ShaderReflectionConstantBuffer* _GetConstantBufferByIndex(UINT Index);
@@ -144,7 +147,15 @@ private:
   std::vector<D3D12_SIGNATURE_PARAMETER_DESC>     m_PatchConstantSignature;
   std::vector<std::unique_ptr<char[]>>            m_UpperCaseNames;
   D3D12_SHADER_DESC m_Desc = {};
-
+  D3D_PRIMITIVE m_GSInputPrimitive = D3D10_PRIMITIVE_UNDEFINED;
+  UINT m_NumThreads[3] = {};
+  UINT64 m_RequiresFlags = 0;
+  // Copy of the reflection tables part when loaded from it; names point here.
+  std::vector<uint32_t> m_TablesData;
+
+  HRESULT LoadTables(const DxilPartHeader *pTablesPart);
+  void ClearReflectionObjects();
+  HRESULT InitFromModule();
   void SetCBufferUsage();
   void CreateReflectionObjectsForSignature(
       const DxilSignature &Sig,
@@ -180,7 +191,10 @@ public:
     return hr;
   }
 
-  HRESULT Load(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart);
+  HRESULT Load(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart,
+               const DxilPartHeader *pTablesPart);
+  HRESULT Load(Module *pModule);
+  void WriteTables(DxilReflectionTablesWriter &W);
 
   // ID3D12ShaderReflection
   STDMETHODIMP GetDesc(THIS_ _Out_ D3D12_SHADER_DESC *pDesc);
@@ -254,7 +268,7 @@ public:
 };
 
 namespace hlsl {
-HRESULT CreateDxilShaderReflection(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject) {
+HRESULT CreateDxilShaderReflection(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, const DxilPartHeader *pTablesPart, REFIID iid, void **ppvObject) {
   if (!ppvObject)
     return E_INVALIDARG;
   CComPtr<DxilShaderReflection> pReflection = DxilShaderReflection::Alloc(DxcGetThreadMallocNoRef());
@@ -262,7 +276,7 @@ HRESULT CreateDxilShaderReflection(const DxilPartHeader *pModulePart, const Dxil
   PublicAPI api = DxilShaderReflection::IIDToAPI(iid);
   pReflection->SetPublicAPI(api);
   // pRDATPart to be used for transition.
-  IFR(pReflection->Load(pModulePart, pRDATPart));
+  IFR(pReflection->Load(pModulePart, pRDATPart, pTablesPart));
   IFR(pReflection.p->QueryInterface(iid, ppvObject));
   return S_OK;
 }
@@ -374,11 +388,15 @@ HRESULT DxilContainerReflection::GetPartReflection(UINT32 idx, REFIID iid, void
   // Use DFCC_ShaderStatistics for reflection instead of DXIL part, until switch
   // to using RDAT for reflection instead of module.
   const DxilPartHeader *pRDATPart = nullptr;
+  const DxilPartHeader *pTablesPart = nullptr;
   for (idx = 0; idx < m_pHeader->PartCount; ++idx) {
     const DxilPartHeader *pPartTest = GetDxilContainerPart(m_pHeader, idx);
     if (pPartTest->PartFourCC == DFCC_RuntimeData) {
       pRDATPart = pPartTest;
     }
+    if (pPartTest->PartFourCC == DFCC_ReflectionTables) {
+      pTablesPart = pPartTest;
+    }
     if (pPart->PartFourCC != DFCC_ShaderStatistics) {
       if (pPartTest->PartFourCC == DFCC_ShaderStatistics) {
         const DxilProgramHeader *pProgramHeaderTest =
@@ -404,7 +422,7 @@ HRESULT DxilContainerReflection::GetPartReflection(UINT32 idx, REFIID iid, void
   if (SK == DXIL::ShaderKind::Library) {
     IFC(hlsl::CreateDxilLibraryReflection(pPart, pRDATPart, iid, ppvObject));
   } else {
-    IFC(hlsl::CreateDxilShaderReflection(pPart, pRDATPart, iid, ppvObject));
+    IFC(hlsl::CreateDxilShaderReflection(pPart, pRDATPart, pTablesPart, iid, ppvObject));
   }
 
 Cleanup:
@@ -417,6 +435,20 @@ void hlsl::CreateDxcContainerReflection(IDxcContainerReflection **ppResult) {
   if (*ppResult == nullptr) throw std::bad_alloc();
 }
 
+DxilPartWriter *hlsl::NewReflectionTablesWriterForModule(Module *pReflectionM) {
+  // Library reflection is still served from the module.
+  if (pReflectionM->GetOrCreateDxilModule().GetShaderModel()->IsLib())
+    return nullptr;
+  CComPtr<DxilShaderReflection> pReflection = DxilShaderReflection::Alloc(DxcGetThreadMallocNoRef());
+  if (pReflection.p == nullptr) throw std::bad_alloc();
+  pReflection->SetPublicAPI(PublicAPI::D3D12);
+  if (FAILED(pReflection->Load(pReflectionM)))
+    return nullptr;
+  std::unique_ptr<DxilReflectionTablesWriter> pWriter(NewReflectionTablesWriter());
+  pReflection->WriteTables(*pWriter);
+  return pWriter.release();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // DxilShaderReflection implementation - helper objects.                     //
 
@@ -428,6 +460,7 @@ struct D3D11_INTERNALSHADER_RESOURCE_DEF;
 class CShaderReflectionType : public ID3D12ShaderReflectionType
 {
   friend class CShaderReflectionConstantBuffer;
+  friend class DxilShaderReflection;
 protected:
   D3D12_SHADER_TYPE_DESC              m_Desc;
   UINT                                m_SizeInCBuffer;
@@ -474,6 +507,7 @@ public:
 
 class CShaderReflectionVariable : public ID3D12ShaderReflectionVariable
 {
+  friend class DxilShaderReflection;
 protected:
   D3D12_SHADER_VARIABLE_DESC          m_Desc;
   CShaderReflectionType              *m_pType;
@@ -498,6 +532,7 @@ public:
 
 class CShaderReflectionConstantBuffer : public ID3D12ShaderReflectionConstantBuffer
 {
+  friend class DxilShaderReflection;
 protected:
   D3D12_SHADER_BUFFER_DESC                m_Desc;
   std::vector<CShaderReflectionVariable>  m_Variables;
@@ -829,6 +864,7 @@ static bool IsObjectType(
 HRESULT CShaderReflectionType::InitializeEmpty()
 {
   ZeroMemory(&m_Desc, sizeof(m_Desc));
+  m_SizeInCBuffer = 0;
   return S_OK;
 }
 
@@ -2062,34 +2098,56 @@ HRESULT DxilModuleReflection::LoadModule(const DxilPartHeader *pShaderPart) {
     auto errorHandler = [&bBitcodeLoadError](const DiagnosticInfo &diagInfo) {
         bBitcodeLoadError |= diagInfo.getSeverity() == DS_Error;
       };
-#if 0 // We materialize eagerly, because we'll need to walk instructions to look for usage information.
+    // Function bodies are only read when usage information isn't in the
+    // metadata; LoadModule(Module*) materializes them in that case.
     ErrorOr<std::unique_ptr<Module>> mod =
         getLazyBitcodeModule(std::move(pMemBuffer), Context, errorHandler);
-#else
-    ErrorOr<std::unique_ptr<Module>> mod =
-      parseBitcodeFile(pMemBuffer->getMemBufferRef(), Context, errorHandler);
-#endif
     if (!mod || bBitcodeLoadError) {
       return E_INVALIDARG;
     }
     std::swap(m_pModule, mod.get());
-    m_pDxilModule = &m_pModule->GetOrCreateDxilModule();
+  }
+  CATCH_CPP_RETURN_HRESULT();
+  return LoadModule(m_pModule.get());
+};
+
+HRESULT DxilModuleReflection::LoadModule(Module *pModule) {
+  try {
+    m_pDxilModule = &pModule->GetOrCreateDxilModule();
 
     unsigned ValMajor, ValMinor;
     m_pDxilModule->GetValidatorVersion(ValMajor, ValMinor);
     m_bUsageInMetadata = hlsl::DXIL::CompareVersions(ValMajor, ValMinor, 1, 5) >= 0;
 
+    // Older validators leave usage out of the metadata, so it is recovered
+    // by walking instructions.
+    if (!m_bUsageInMetadata)
+      IFTBOOL(!pModule->materializeAll(), DXC_E_CONTAINER_INVALID);
+
     CreateReflectionObjects();
     return S_OK;
   }
   CATCH_CPP_RETURN_HRESULT();
-};
+}
 
 HRESULT DxilShaderReflection::Load(const DxilPartHeader *pModulePart,
-                                   const DxilPartHeader *pRDATPart) {
+                                   const DxilPartHeader *pRDATPart,
+                                   const DxilPartHeader *pTablesPart) {
+  // Prefer the reflection tables, which need no module; fall back to the
+  // module for containers without them.
+  if (pTablesPart && SUCCEEDED(LoadTables(pTablesPart)))
+    return S_OK;
   IFR(LoadRDAT(pRDATPart));
   IFR(LoadModule(pModulePart));
+  return InitFromModule();
+}
 
+HRESULT DxilShaderReflection::Load(Module *pModule) {
+  IFR(LoadModule(pModule));
+  return InitFromModule();
+}
+
+HRESULT DxilShaderReflection::InitFromModule() {
   try {
     // Set cbuf usage.
     if (!m_bUsageInMetadata)
@@ -2109,6 +2167,391 @@ HRESULT DxilShaderReflection::Load(const DxilPartHeader *pModulePart,
   CATCH_CPP_RETURN_HRESULT();
 }
 
+static uint32_t InsertTableString(DxilReflectionTablesWriter &W, LPCSTR pValue) {
+  return pValue ? W.InsertString(pValue) : UINT_MAX;
+}
+
+static LPCSTR GetTableString(const RDAT::ReflectionTablesReader &R,
+                             uint32_t offset) {
+  if (offset == UINT_MAX)
+    return nullptr;
+  LPCSTR pValue = R.GetString(offset);
+  IFTBOOL(pValue != nullptr, DXC_E_CONTAINER_INVALID);
+  return pValue;
+}
+
+template <typename T>
+static const T &GetTableRow(const RDAT::TableReader &Table, uint32_t index) {
+  const T *pRow = Table.Row<T>(index);
+  IFTBOOL(pRow != nullptr, DXC_E_CONTAINER_INVALID);
+  return *pRow;
+}
+
+void DxilShaderReflection::WriteTables(DxilReflectionTablesWriter &W) {
+  // Every type is written, including the empty type at index 0, so that
+  // members and variables can refer to types by index.
+  DenseMap<const CShaderReflectionType *, uint32_t> typeIndices;
+  for (uint32_t i = 0; i < m_Types.size(); ++i)
+    typeIndices[m_Types[i].get()] = i;
+  for (auto &&pType : m_Types) {
+    const D3D12_SHADER_TYPE_DESC &TD = pType->m_Desc;
+    RDAT::ReflectionTypeInfo Info = {};
+    Info.Class = TD.Class;
+    Info.Type = TD.Type;
+    Info.Rows = TD.Rows;
+    Info.Columns = TD.Columns;
+    Info.Elements = TD.Elements;
+    Info.Members = TD.Members;
+    Info.Offset = TD.Offset;
+    Info.Name = InsertTableString(W, TD.Name);
+    Info.SizeInCBuffer = pType->m_SizeInCBuffer;
+    Info.MemberTypes = UINT_MAX;
+    Info.MemberNames = UINT_MAX;
+    if (!pType->m_MemberTypes.empty()) {
+      SmallVector<uint32_t, 8> memberTypes;
+      SmallVector<uint32_t, 8> memberNames;
+      for (CShaderReflectionType *pMember : pType->m_MemberTypes)
+        memberTypes.push_back(typeIndices.lookup(pMember));
+      for (StringRef memberName : pType->m_MemberNames)
+        memberNames.push_back(W.InsertString(memberName));
+      Info.MemberTypes = W.InsertIndexArray(memberTypes);
+      Info.MemberNames = W.InsertIndexArray(memberNames);
+    }
+    W.InsertType(Info);
+  }
+
+  for (auto &&pCB : m_CBs) {
+    const D3D12_SHADER_BUFFER_DESC &CD = pCB->m_Desc;
+    RDAT::ReflectionCBufferInfo Info = {};
+    Info.Name = InsertTableString(W, CD.Name);
+    Info.Type = CD.Type;
+    Info.Variables = CD.Variables;
+    Info.Size = CD.Size;
+    Info.Flags = CD.uFlags;
+    Info.VariableCount = pCB->m_Variables.size();
+    for (CShaderReflectionVariable &Var : pCB->m_Variables) {
+      const D3D12_SHADER_VARIABLE_DESC &VD = Var.m_Desc;
+      RDAT::ReflectionVariableInfo VarInfo = {};
+      VarInfo.Name = InsertTableString(W, VD.Name);
+      VarInfo.StartOffset = VD.StartOffset;
+      VarInfo.Size = VD.Size;
+      VarInfo.Flags = VD.uFlags;
+      VarInfo.StartTexture = VD.StartTexture;
+      VarInfo.TextureSize = VD.TextureSize;
+      VarInfo.StartSampler = VD.StartSampler;
+      VarInfo.SamplerSize = VD.SamplerSize;
+      VarInfo.Type = typeIndices.lookup(Var.m_pType);
+      uint32_t index = W.InsertVariable(VarInfo);
+      if (&Var == &pCB->m_Variables.front())
+        Info.FirstVariable = index;
+    }
+    W.InsertCBuffer(Info);
+  }
+
+  for (const D3D12_SHADER_INPUT_BIND_DESC &BD : m_Resources) {
+    RDAT::ReflectionResourceInfo Info = {};
+    Info.Name = InsertTableString(W, BD.Name);
+    Info.Type = BD.Type;
+    Info.BindPoint = BD.BindPoint;
+    Info.BindCount = BD.BindCount;
+    Info.Flags = BD.uFlags;
+    Info.ReturnType = BD.ReturnType;
+    Info.Dimension = BD.Dimension;
+    Info.NumSamples = BD.NumSamples;
+    Info.Space = BD.Space;
+    Info.ID = BD.uID;
+    W.InsertResource(Info);
+  }
+
+  for (auto *pSignature :
+       {&m_InputSignature, &m_OutputSignature, &m_PatchConstantSignature}) {
+    for (const D3D12_SIGNATURE_PARAMETER_DESC &PD : *pSignature) {
+      RDAT::ReflectionSignatureElement Info = {};
+      Info.SemanticName = InsertTableString(W, PD.SemanticName);
+      Info.SemanticIndex = PD.SemanticIndex;
+      Info.Register = PD.Register;
+      Info.SystemValueType = PD.SystemValueType;
+      Info.ComponentType = PD.ComponentType;
+      Info.Mask = PD.Mask;
+      Info.ReadWriteMask = PD.ReadWriteMask;
+      Info.Stream = PD.Stream;
+      Info.MinPrecision = PD.MinPrecision;
+      W.InsertSignatureElement(Info);
+    }
+  }
+
+  const D3D12_SHADER_DESC &D = m_Desc;
+  RDAT::ReflectionShaderInfo Info = {};
+  Info.Version = D.Version;
+  Info.Creator = InsertTableString(W, D.Creator);
+  Info.Flags = D.Flags;
+  Info.ConstantBuffers = D.ConstantBuffers;
+  Info.BoundResources = D.BoundResources;
+  Info.InputParameters = D.InputParameters;
+  Info.OutputParameters = D.OutputParameters;
+  Info.InstructionCount = D.InstructionCount;
+  Info.TempRegisterCount = D.TempRegisterCount;
+  Info.TempArrayCount = D.TempArrayCount;
+  Info.DefCount = D.DefCount;
+  Info.DclCount = D.DclCount;
+  Info.TextureNormalInstructions = D.TextureNormalInstructions;
+  Info.TextureLoadInstructions = D.TextureLoadInstructions;
+  Info.TextureCompInstructions = D.TextureCompInstructions;
+  Info.TextureBiasInstructions = D.TextureBiasInstructions;
+  Info.TextureGradientInstructions = D.TextureGradientInstructions;
+  Info.FloatInstructionCount = D.FloatInstructionCount;
+  Info.IntInstructionCount = D.IntInstructionCount;
+  Info.UintInstructionCount = D.UintInstructionCount;
+  Info.StaticFlowControlCount = D.StaticFlowControlCount;
+  Info.DynamicFlowControlCount = D.DynamicFlowControlCount;
+  Info.MacroInstructionCount = D.MacroInstructionCount;
+  Info.ArrayInstructionCount = D.ArrayInstructionCount;
+  Info.CutInstructionCount = D.CutInstructionCount;
+  Info.EmitInstructionCount = D.EmitInstructionCount;
+  Info.GSOutputTopology = D.GSOutputTopology;
+  Info.GSMaxOutputVertexCount = D.GSMaxOutputVertexCount;
+  Info.InputPrimitive = D.InputPrimitive;
+  Info.PatchConstantParameters = D.PatchConstantParameters;
+  Info.GSInstanceCount = D.cGSInstanceCount;
+  Info.ControlPoints = D.cControlPoints;
+  Info.HSOutputPrimitive = D.HSOutputPrimitive;
+  Info.HSPartitioning = D.HSPartitioning;
+  Info.TessellatorDomain = D.TessellatorDomain;
+  Info.BarrierInstructions = D.cBarrierInstructions;
+  Info.InterlockedInstructions = D.cInterlockedInstructions;
+  Info.TextureStoreInstructions = D.cTextureStoreInstructions;
+  Info.GSInputPrimitive = m_GSInputPrimitive;
+  for (unsigned i = 0; i < 3; ++i)
+    Info.NumThreads[i] = m_NumThreads[i];
+  Info.RequiresFlags[0] = (uint32_t)m_RequiresFlags;
+  Info.RequiresFlags[1] = (uint32_t)(m_RequiresFlags >> 32);
+  W.SetShaderInfo(Info);
+}
+
+HRESULT DxilShaderReflection::LoadTables(const DxilPartHeader *pTablesPart) {
+  HRESULT hr = S_OK;
+  try {
+    // Names are served from this copy of the part.
+    m_TablesData.resize((pTablesPart->PartSize + 3) / 4);
+    memcpy(m_TablesData.data(), GetDxilPartData(pTablesPart),
+           pTablesPart->PartSize);
+    RDAT::ReflectionTablesReader R;
+    IFTBOOL(R.InitFromData(m_TablesData.data(), pTablesPart->PartSize),
+            DXC_E_CONTAINER_INVALID);
+    const RDAT::ReflectionShaderInfo &Info = *R.GetShaderInfo();
+
+    // Create all types up front, since members refer to types by index.
+    const RDAT::TableReader &Types = R.GetTypeTable();
+    IFTBOOL(Types.Count() > 0, DXC_E_CONTAINER_INVALID);
+    for (uint32_t i = 0; i < Types.Count(); ++i)
+      m_Types.push_back(llvm::make_unique<CShaderReflectionType>());
+    auto GetType = [&](uint32_t index) -> CShaderReflectionType * {
+      IFTBOOL(index < m_Types.size(), DXC_E_CONTAINER_INVALID);
+      return m_Types[index].get();
+    };
+    for (uint32_t i = 0; i < Types.Count(); ++i) {
+      const auto &TI = GetTableRow<RDAT::ReflectionTypeInfo>(Types, i);
+      CShaderReflectionType &T = *m_Types[i];
+      T.InitializeEmpty();
+      T.m_Desc.Class = (D3D_SHADER_VARIABLE_CLASS)TI.Class;
+      T.m_Desc.Type = (D3D_SHADER_VARIABLE_TYPE)TI.Type;
+      T.m_Desc.Rows = TI.Rows;
+      T.m_Desc.Columns = TI.Columns;
+      T.m_Desc.Elements = TI.Elements;
+      T.m_Desc.Members = TI.Members;
+      T.m_Desc.Offset = TI.Offset;
+      if (LPCSTR pName = GetTableString(R, TI.Name)) {
+        T.m_Name = pName;
+        T.m_Desc.Name = T.m_Name.c_str();
+      }
+      T.m_SizeInCBuffer = TI.SizeInCBuffer;
+      uint32_t count = 0;
+      if (TI.MemberTypes != UINT_MAX) {
+        const uint32_t *pIndices = R.GetIndexArray(TI.MemberTypes, &count);
+        IFTBOOL(pIndices != nullptr, DXC_E_CONTAINER_INVALID);
+        for (uint32_t j = 0; j < count; ++j)
+          T.m_MemberTypes.push_back(GetType(pIndices[j]));
+      }
+      if (TI.MemberNames != UINT_MAX) {
+        const uint32_t *pNames = R.GetIndexArray(TI.MemberNames, &count);
+        IFTBOOL(pNames != nullptr, DXC_E_CONTAINER_INVALID);
+        for (uint32_t j = 0; j < count; ++j) {
+          LPCSTR pName = GetTableString(R, pNames[j]);
+          IFTBOOL(pName != nullptr, DXC_E_CONTAINER_INVALID);
+          T.m_MemberNames.push_back(pName);
+        }
+      }
+      IFTBOOL(T.m_MemberNames.size() == T.m_MemberTypes.size() &&
+                  T.m_Desc.Members <= T.m_MemberTypes.size(),
+              DXC_E_CONTAINER_INVALID);
+    }
+
+    const RDAT::TableReader &CBuffers = R.GetCBufferTable();
+    const RDAT::TableReader &Variables = R.GetVariableTable();
+    for (uint32_t i = 0; i < CBuffers.Count(); ++i) {
+      const auto &CI = GetTableRow<RDAT::ReflectionCBufferInfo>(CBuffers, i);
+      m_CBs.push_back(llvm::make_unique<CShaderReflectionConstantBuffer>());
+      CShaderReflectionConstantBuffer &CB = *m_CBs.back();
+      ZeroMemory(&CB.m_Desc, sizeof(CB.m_Desc));
+      if (LPCSTR pName = GetTableString(R, CI.Name)) {
+        CB.m_ReflectionName = pName;
+        CB.m_Desc.Name = CB.m_ReflectionName.c_str();
+      }
+      CB.m_Desc.Type = (D3D_CBUFFER_TYPE)CI.Type;
+      CB.m_Desc.Variables = CI.Variables;
+      CB.m_Desc.Size = CI.Size;
+      CB.m_Desc.uFlags = CI.Flags;
+      IFTBOOL(CI.FirstVariable <= Variables.Count() &&
+                  CI.VariableCount <= Variables.Count() - CI.FirstVariable,
+              DXC_E_CONTAINER_INVALID);
+      CB.m_Variables.resize(CI.VariableCount);
+      for (uint32_t j = 0; j < CI.VariableCount; ++j) {
+        const auto &VI = GetTableRow<RDAT::ReflectionVariableInfo>(
+            Variables, CI.FirstVariable + j);
+        D3D12_SHADER_VARIABLE_DESC VarDesc;
+        ZeroMemory(&VarDesc, sizeof(VarDesc));
+        VarDesc.Name = GetTableString(R, VI.Name);
+        VarDesc.StartOffset = VI.StartOffset;
+        VarDesc.Size = VI.Size;
+        VarDesc.uFlags = VI.Flags;
+        VarDesc.StartTexture = VI.StartTexture;
+        VarDesc.TextureSize = VI.TextureSize;
+        VarDesc.StartSampler = VI.StartSampler;
+        VarDesc.SamplerSize = VI.SamplerSize;
+        CB.m_Variables[j].Initialize(&CB, &VarDesc, GetType(VI.Type), nullptr);
+      }
+      // Structured buffers are looked up apart from cbuffers and tbuffers.
+      if (CB.m_Desc.Name) {
+        if (CB.m_Desc.Type == D3D11_CT_RESOURCE_BIND_INFO)
+          m_StructuredBufferCBsByName[CB.GetName()] = i;
+        else
+          m_CBsByName[CB.GetName()] = i;
+      }
+    }
+
+    const RDAT::TableReader &Resources = R.GetResourceTable();
+    for (uint32_t i = 0; i < Resources.Count(); ++i) {
+      const auto &RI = GetTableRow<RDAT::ReflectionResourceInfo>(Resources, i);
+      D3D12_SHADER_INPUT_BIND_DESC BD;
+      ZeroMemory(&BD, sizeof(BD));
+      BD.Name = GetTableString(R, RI.Name);
+      IFTBOOL(BD.Name != nullptr, DXC_E_CONTAINER_INVALID);
+      BD.Type = (D3D_SHADER_INPUT_TYPE)RI.Type;
+      BD.BindPoint = RI.BindPoint;
+      BD.BindCount = RI.BindCount;
+      BD.uFlags = RI.Flags;
+      BD.ReturnType = (D3D_RESOURCE_RETURN_TYPE)RI.ReturnType;
+      BD.Dimension = (D3D_SRV_DIMENSION)RI.Dimension;
+      BD.NumSamples = RI.NumSamples;
+      BD.Space = RI.Space;
+      BD.uID = RI.ID;
+      m_Resources.push_back(BD);
+    }
+
+    // Signature rows are input, then output, then patch constant parameters.
+    const RDAT::TableReader &Signature = R.GetSignatureTable();
+    IFTBOOL((uint64_t)Info.InputParameters + Info.OutputParameters +
+                    Info.PatchConstantParameters == Signature.Count(),
+            DXC_E_CONTAINER_INVALID);
+    uint32_t row = 0;
+    auto LoadSignature = [&](uint32_t count,
+                             std::vector<D3D12_SIGNATURE_PARAMETER_DESC> &Descs) {
+      for (uint32_t i = 0; i < count; ++i) {
+        const auto &SE =
+            GetTableRow<RDAT::ReflectionSignatureElement>(Signature, row++);
+        D3D12_SIGNATURE_PARAMETER_DESC Desc;
+        ZeroMemory(&Desc, sizeof(Desc));
+        Desc.SemanticName = GetTableString(R, SE.SemanticName);
+        IFTBOOL(Desc.SemanticName != nullptr, DXC_E_CONTAINER_INVALID);
+        Desc.SemanticIndex = SE.SemanticIndex;
+        Desc.Register = SE.Register;
+        Desc.SystemValueType = (D3D_NAME)SE.SystemValueType;
+        Desc.ComponentType = (D3D_REGISTER_COMPONENT_TYPE)SE.ComponentType;
+        Desc.Mask = SE.Mask;
+        Desc.ReadWriteMask = SE.ReadWriteMask;
+        Desc.Stream = SE.Stream;
+        // D3D11_43 does not have MinPrecison.
+        if (m_PublicAPI != PublicAPI::D3D11_43)
+          Desc.MinPrecision = (D3D_MIN_PRECISION)SE.MinPrecision;
+        Descs.push_back(Desc);
+      }
+    };
+    LoadSignature(Info.InputParameters, m_InputSignature);
+    LoadSignature(Info.OutputParameters, m_OutputSignature);
+    LoadSignature(Info.PatchConstantParameters, m_PatchConstantSignature);
+
+    D3D12_SHADER_DESC &D = m_Desc;
+    D.Version = Info.Version;
+    D.Creator = GetTableString(R, Info.Creator);
+    D.Flags = Info.Flags;
+    D.ConstantBuffers = Info.ConstantBuffers;
+    D.BoundResources = Info.BoundResources;
+    D.InputParameters = Info.InputParameters;
+    D.OutputParameters = Info.OutputParameters;
+    D.InstructionCount = Info.InstructionCount;
+    D.TempRegisterCount = Info.TempRegisterCount;
+    D.TempArrayCount = Info.TempArrayCount;
+    D.DefCount = Info.DefCount;
+    D.DclCount = Info.DclCount;
+    D.TextureNormalInstructions = Info.TextureNormalInstructions;
+    D.TextureLoadInstructions = Info.TextureLoadInstructions;
+    D.TextureCompInstructions = Info.TextureCompInstructions;
+    D.TextureBiasInstructions = Info.TextureBiasInstructions;
+    D.TextureGradientInstructions = Info.TextureGradientInstructions;
+    D.FloatInstructionCount = Info.FloatInstructionCount;
+    D.IntInstructionCount = Info.IntInstructionCount;
+    D.UintInstructionCount = Info.UintInstructionCount;
+    D.StaticFlowControlCount = Info.StaticFlowControlCount;
+    D.DynamicFlowControlCount = Info.DynamicFlowControlCount;
+    D.MacroInstructionCount = Info.MacroInstructionCount;
+    D.ArrayInstructionCount = Info.ArrayInstructionCount;
+    D.CutInstructionCount = Info.CutInstructionCount;
+    D.EmitInstructionCount = Info.EmitInstructionCount;
+    D.GSOutputTopology = (D3D_PRIMITIVE_TOPOLOGY)Info.GSOutputTopology;
+    D.GSMaxOutputVertexCount = Info.GSMaxOutputVertexCount;
+    D.InputPrimitive = (D3D_PRIMITIVE)Info.InputPrimitive;
+    D.PatchConstantParameters = Info.PatchConstantParameters;
+    D.cGSInstanceCount = Info.GSInstanceCount;
+    D.cControlPoints = Info.ControlPoints;
+    D.HSOutputPrimitive = (D3D_TESSELLATOR_OUTPUT_PRIMITIVE)Info.HSOutputPrimitive;
+    D.HSPartitioning = (D3D_TESSELLATOR_PARTITIONING)Info.HSPartitioning;
+    D.TessellatorDomain = (D3D_TESSELLATOR_DOMAIN)Info.TessellatorDomain;
+    D.cBarrierInstructions = Info.BarrierInstructions;
+    D.cInterlockedInstructions = Info.InterlockedInstructions;
+    D.cTextureStoreInstructions = Info.TextureStoreInstructions;
+    IFTBOOL(D.ConstantBuffers == m_CBs.size() &&
+                D.BoundResources == m_Resources.size(),
+            DXC_E_CONTAINER_INVALID);
+
+    m_GSInputPrimitive = (D3D_PRIMITIVE)Info.GSInputPrimitive;
+    for (unsigned i = 0; i < 3; ++i)
+      m_NumThreads[i] = Info.NumThreads[i];
+    m_RequiresFlags =
+        Info.RequiresFlags[0] | ((UINT64)Info.RequiresFlags[1] << 32);
+  }
+  CATCH_CPP_ASSIGN_HRESULT();
+  if (FAILED(hr))
+    ClearReflectionObjects();
+  return hr;
+}
+
+void DxilShaderReflection::ClearReflectionObjects() {
+  m_CBsByName.clear();
+  m_StructuredBufferCBsByName.clear();
+  m_CBs.clear();
+  m_Resources.clear();
+  m_Types.clear();
+  m_InputSignature.clear();
+  m_OutputSignature.clear();
+  m_PatchConstantSignature.clear();
+  m_Desc = {};
+  m_GSInputPrimitive = D3D10_PRIMITIVE_UNDEFINED;
+  for (unsigned i = 0; i < 3; ++i)
+    m_NumThreads[i] = 0;
+  m_RequiresFlags = 0;
+  m_TablesData.clear();
+}
+
 _Use_decl_annotations_
 HRESULT DxilShaderReflection::GetDesc(D3D12_SHADER_DESC *pDesc) {
   if (nullptr == pDesc) return E_POINTER;
@@ -2301,6 +2744,22 @@ void DxilShaderReflection::InitDesc() {
   // This used to map to flow control using special int/bool constant registers in DX9.
   // Unset:  UINT MacroInstructionCount;  // Number of macro instructions used
   // Macro instructions are a <= DX9 concept.
+
+  // Answers for queries outside of the description.
+  if (pSM->IsGS())
+    m_GSInputPrimitive = (D3D_PRIMITIVE)M.GetInputPrimitive();
+  if (pSM->IsCS()) {
+    for (unsigned i = 0; i < 3; ++i)
+      m_NumThreads[i] = M.GetNumThreads(i);
+  }
+  m_RequiresFlags = M.m_ShaderFlags.GetFeatureInfo();
+  // FeatureInfo flags are identical, with the exception of a collision between:
+  // SHADER_FEATURE_COMPUTE_SHADERS_PLUS_RAW_AND_STRUCTURED_BUFFERS_VIA_SHADER_4_X
+  // and D3D_SHADER_REQUIRES_EARLY_DEPTH_STENCIL
+  // We keep track of the flag elsewhere, so use that instead.
+  m_RequiresFlags &= ~(UINT64)D3D_SHADER_REQUIRES_EARLY_DEPTH_STENCIL;
+  if (M.m_ShaderFlags.GetForceEarlyDepthStencil())
+    m_RequiresFlags |= D3D_SHADER_REQUIRES_EARLY_DEPTH_STENCIL;
 }
 
 _Use_decl_annotations_
@@ -2451,9 +2910,7 @@ UINT DxilShaderReflection::GetConversionInstructionCount() { return 0; }
 UINT DxilShaderReflection::GetBitwiseInstructionCount() { return 0; }
 
 D3D_PRIMITIVE DxilShaderReflection::GetGSInputPrimitive() {
-  if (!m_pDxilModule->GetShaderModel()->IsGS())
-    return D3D_PRIMITIVE::D3D10_PRIMITIVE_UNDEFINED;
-  return (D3D_PRIMITIVE)m_pDxilModule->GetInputPrimitive();
+  return m_GSInputPrimitive;
 }
 
 BOOL DxilShaderReflection::IsSampleFrequencyShader() {
@@ -2471,15 +2928,10 @@ HRESULT DxilShaderReflection::GetMinFeatureLevel(enum D3D_FEATURE_LEVEL* pLevel)
 
 _Use_decl_annotations_
 UINT DxilShaderReflection::GetThreadGroupSize(UINT *pSizeX, UINT *pSizeY, UINT *pSizeZ) {
-  if (!m_pDxilModule->GetShaderModel()->IsCS()) {
-    AssignToOutOpt((UINT)0, pSizeX);
-    AssignToOutOpt((UINT)0, pSizeY);
-    AssignToOutOpt((UINT)0, pSizeZ);
-    return 0;
-  }
-  unsigned x = m_pDxilModule->GetNumThreads(0);
-  unsigned y = m_pDxilModule->GetNumThreads(1);
-  unsigned z = m_pDxilModule->GetNumThreads(2);
+  // Zero unless this is a compute shader.
+  unsigned x = m_NumThreads[0];
+  unsigned y = m_NumThreads[1];
+  unsigned z = m_NumThreads[2];
   AssignToOutOpt(x, pSizeX);
   AssignToOutOpt(y, pSizeY);
   AssignToOutOpt(z, pSizeZ);
@@ -2487,15 +2939,7 @@ UINT DxilShaderReflection::GetThreadGroupSize(UINT *pSizeX, UINT *pSizeY, UINT *
 }
 
 UINT64 DxilShaderReflection::GetRequiresFlags() {
-  UINT64 result = m_pDxilModule->m_ShaderFlags.GetFeatureInfo();
-  // FeatureInfo flags are identical, with the exception of a collision between:
-  // SHADER_FEATURE_COMPUTE_SHADERS_PLUS_RAW_AND_STRUCTURED_BUFFERS_VIA_SHADER_4_X
-  // and D3D_SHADER_REQUIRES_EARLY_DEPTH_STENCIL
-  // We keep track of the flag elsewhere, so use that instead.
-  result &= ~(UINT64)D3D_SHADER_REQUIRES_EARLY_DEPTH_STENCIL;
-  if (m_pDxilModule->m_ShaderFlags.GetForceEarlyDepthStencil())
-    result |= D3D_SHADER_REQUIRES_EARLY_DEPTH_STENCIL;
-  return result;
+  return m_RequiresFlags;
 }
 
 
@@ -2768,4 +3212,9 @@ void hlsl::CreateDxcContainerReflection(IDxcContainerReflection **ppResult) {
   *ppResult = nullptr;
 }
 
+hlsl::DxilPartWriter *
+hlsl::NewReflectionTablesWriterForModule(llvm::Module *) {
+  return nullptr;
+}
+
 #endif // LLVM_ON_WIN32
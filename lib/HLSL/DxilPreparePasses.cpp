@@ -1030,7 +1030,8 @@ private:
   }
 
   void RemoveUnusedRayQuery(Module &M) {
-    hlsl::OP *hlslOP = M.GetDxilModule().GetOP();
+    DxilModule &DM = M.GetDxilModule();
+    hlsl::OP *hlslOP = DM.GetOP();
     llvm::Function *AllocFn = hlslOP->GetOpFunc(
       DXIL::OpCode::AllocateRayQuery, Type::getVoidTy(M.getContext()));
     SmallVector<CallInst*, 4> DeadInsts;
@@ -1042,6 +1043,8 @@ private:
       }
     }
     for (auto CI : DeadInsts) {
+      // Shader flags were collected with the call in place.
+      DM.InvalidateFunctionShaderFlags(CI->getParent()->getParent());
       CI->eraseFromParent();
     }
     if (AllocFn->user_empty()) {
@@ -12,6 +12,7 @@
 #include "dxc/Support/Global.h"
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/Support/FileIOHelper.h"
+#include "dxc/Support/WorkerThreads.h"
 
 #include "dxc/HLSL/DxilValidation.h"
 #include "dxc/DxilContainer/DxilContainerAssembler.h"
@@ -42,7 +43,9 @@
 #include "llvm/IR/DiagnosticPrinter.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/IR/ModuleSlotTracker.h"
+#include "llvm/IR/TypeFinder.h"
 #include "llvm/ADT/BitVector.h"
+#include "llvm/Support/Compiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Bitcode/ReaderWriter.h"
@@ -56,7 +59,11 @@
 #include "dxc/HLSL/DxilPackSignatureElement.h"
 #include "dxc/DxilRootSignature/DxilRootSignature.h"
 #include <algorithm>
+#include <atomic>
 #include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using namespace llvm;
 using namespace std;
@@ -386,8 +393,15 @@ struct EntryStatus {
   }
 };
 
+// Diagnostics raised while validating one function, replayed later on the
+// validating thread. The LLVMContext diagnostic handler and the slot tracker
+// are not thread safe, so function bodies validated on worker threads record
+// their diagnostics here instead of emitting them.
+typedef std::vector<std::function<void()>> DeferredDiagnostics;
+static LLVM_THREAD_LOCAL DeferredDiagnostics *CurrentDeferredDiagnostics = nullptr;
+
 struct ValidationContext {
-  bool Failed = false;
+  std::atomic<bool> Failed{false};
   Module &M;
   Module *pDebugModule;
   DxilModule &DxilMod;
@@ -410,6 +424,8 @@ struct ValidationContext {
   const unsigned kLLVMLoopMDKind;
   unsigned m_DxilMajor, m_DxilMinor;
   ModuleSlotTracker slotTracker;
+  // Guards the hlsl::OP type caches, which are filled lazily.
+  std::mutex OPTypeLock;
 
   ValidationContext(Module &llvmModule, Module *DebugModule,
                     DxilModule &dxilModule)
@@ -631,20 +647,32 @@ struct ValidationContext {
 
   DxilResourceProperties GetResourceFromVal(Value *resVal);
 
+  // Emits a diagnostic now, or records it if the current thread is
+  // collecting diagnostics for later replay.
+  void Diagnose(std::function<void()> Emit) {
+    Failed = true;
+    if (CurrentDeferredDiagnostics)
+      CurrentDeferredDiagnostics->push_back(std::move(Emit));
+    else
+      Emit();
+  }
+
   void EmitGlobalVariableFormatError(GlobalVariable *GV, ValidationRule rule,
                                      ArrayRef<StringRef> args) {
     std::string ruleText = GetValidationRuleText(rule);
     FormatRuleText(ruleText, args);
     if (pDebugModule)
       GV = pDebugModule->getGlobalVariable(GV->getName());
-    dxilutil::EmitErrorOnGlobalVariable(M.getContext(), GV, ruleText);
-    Failed = true;
+    Diagnose([=] {
+      dxilutil::EmitErrorOnGlobalVariable(M.getContext(), GV, ruleText);
+    });
   }
 
   // This is the least desirable mechanism, as it has no context.
   void EmitError(ValidationRule rule) {
-    dxilutil::EmitErrorOnContext(M.getContext(), GetValidationRuleText(rule));
-    Failed = true;
+    Diagnose([=] {
+      dxilutil::EmitErrorOnContext(M.getContext(), GetValidationRuleText(rule));
+    });
   }
 
   void FormatRuleText(std::string &ruleText, ArrayRef<StringRef> args) {
@@ -675,22 +703,25 @@ struct ValidationContext {
   void EmitFormatError(ValidationRule rule, ArrayRef<StringRef> args) {
     std::string ruleText = GetValidationRuleText(rule);
     FormatRuleText(ruleText, args);
-    dxilutil::EmitErrorOnContext(M.getContext(), ruleText);
-    Failed = true;
+    Diagnose([=] { dxilutil::EmitErrorOnContext(M.getContext(), ruleText); });
   }
 
   void EmitMetaError(Metadata *Meta, ValidationRule rule) {
-    std::string O;
-    raw_string_ostream OSS(O);
-    Meta->print(OSS, &M);
-    dxilutil::EmitErrorOnContext(M.getContext(), GetValidationRuleText(rule) + O);
-    Failed = true;
+    Diagnose([=] {
+      std::string O;
+      raw_string_ostream OSS(O);
+      Meta->print(OSS, &M);
+      dxilutil::EmitErrorOnContext(M.getContext(),
+                                   GetValidationRuleText(rule) + OSS.str());
+    });
   }
 
   void EmitResourceError(const hlsl::DxilResourceBase *Res, ValidationRule rule) {
     std::string QuotedRes = " '" + Res->GetGlobalName() + "'";
-    dxilutil::EmitErrorOnContext(M.getContext(), GetValidationRuleText(rule) + QuotedRes);
-    Failed = true;
+    Diagnose([=] {
+      dxilutil::EmitErrorOnContext(M.getContext(),
+                                   GetValidationRuleText(rule) + QuotedRes);
+    });
   }
 
   void EmitResourceFormatError(const hlsl::DxilResourceBase *Res,
@@ -699,8 +730,9 @@ struct ValidationContext {
     std::string QuotedRes = " '" + Res->GetGlobalName() + "'";
     std::string ruleText = GetValidationRuleText(rule);
     FormatRuleText(ruleText, args);
-    dxilutil::EmitErrorOnContext(M.getContext(), ruleText + QuotedRes);
-    Failed = true;
+    Diagnose([=] {
+      dxilutil::EmitErrorOnContext(M.getContext(), ruleText + QuotedRes);
+    });
   }
 
   bool IsDebugFunctionCall(Instruction *I) {
@@ -731,6 +763,13 @@ struct ValidationContext {
   }
 
   void EmitInstrErrorMsg(Instruction *I, ValidationRule Rule, std::string Msg) {
+    // Deduplicate when emitting so replayed diagnostics behave the same as
+    // immediate ones.
+    Diagnose([=] { EmitInstrErrorMsgNow(I, Rule, Msg); });
+  }
+
+  void EmitInstrErrorMsgNow(Instruction *I, ValidationRule Rule,
+                            std::string Msg) {
     Instruction *DbgI = GetDebugInstr(I);
     const DebugLoc L = DbgI->getDebugLoc();
     if (L) {
@@ -779,8 +818,6 @@ struct ValidationContext {
     Msg += " of function '" + F->getName().str() + "'.";
 
     dxilutil::EmitNoteOnContext(DbgI->getContext(), Msg);
-
-    Failed = true;
   }
 
   void EmitInstrError(Instruction *I, ValidationRule rule) {
@@ -808,8 +845,10 @@ struct ValidationContext {
     if (pDebugModule)
       if (Function *dbgF = pDebugModule->getFunction(F->getName()))
         F = dbgF;
-    dxilutil::EmitErrorOnFunction(M.getContext(), F, GetValidationRuleText(rule));
-    Failed = true;
+    Diagnose([=] {
+      dxilutil::EmitErrorOnFunction(M.getContext(), F,
+                                    GetValidationRuleText(rule));
+    });
   }
 
   void EmitFnFormatError(Function *F, ValidationRule rule, ArrayRef<StringRef> args) {
@@ -818,8 +857,7 @@ struct ValidationContext {
     if (pDebugModule)
       if (Function *dbgF = pDebugModule->getFunction(F->getName()))
         F = dbgF;
-    dxilutil::EmitErrorOnFunction(M.getContext(), F, ruleText);
-    Failed = true;
+    Diagnose([=] { dxilutil::EmitErrorOnFunction(M.getContext(), F, ruleText); });
   }
 
   void EmitFnAttributeError(Function *F, StringRef Kind, StringRef Value) {
@@ -2676,7 +2714,9 @@ static bool IsLLVMInstructionAllowed(llvm::Instruction &I) {
   // OPCODE-ALLOWED:END
 }
 
-static bool IsDxilBuiltinStructType(StructType *ST, hlsl::OP *hlslOP) {
+static bool IsDxilBuiltinStructType(StructType *ST, ValidationContext &ValCtx) {
+  hlsl::OP *hlslOP = ValCtx.DxilMod.GetOP();
+  std::lock_guard<std::mutex> Lock(ValCtx.OPTypeLock);
   if (ST == hlslOP->GetBinaryWithCarryType())
     return true;
   if (ST == hlslOP->GetBinaryWithTwoOutputsType())
@@ -2745,8 +2785,7 @@ static bool ValidateType(Type *Ty, ValidationContext &ValCtx, bool bInner = fals
       // Allow handle type.
       if (ValCtx.HandleTy == Ty)
         return true;
-      hlsl::OP *hlslOP = ValCtx.DxilMod.GetOP();
-      if (IsDxilBuiltinStructType(ST, hlslOP)) {
+      if (IsDxilBuiltinStructType(ST, ValCtx)) {
         ValCtx.EmitTypeError(Ty, ValidationRule::InstrDxilStructUser);
         result = false;
       }
@@ -3395,7 +3434,7 @@ static void ValidateFunctionBody(Function *F, ValidationContext &ValCtx) {
         if (StructType *ST = dyn_cast<StructType>(Ty)) {
           Value *Agg = EV->getAggregateOperand();
           if (!isa<AtomicCmpXchgInst>(Agg) &&
-              !IsDxilBuiltinStructType(ST, ValCtx.DxilMod.GetOP())) {
+              !IsDxilBuiltinStructType(ST, ValCtx)) {
             ValCtx.EmitInstrError(EV, ValidationRule::InstrExtractValue);
           }
         } else {
@@ -3660,6 +3699,89 @@ static void ValidateFunction(Function &F, ValidationContext &ValCtx) {
   }
 }
 
+// Libraries with fewer function bodies than this are validated serially;
+// other shaders always are, as they have only a handful of functions.
+static const unsigned kMinParallelFunctionBodies = 16;
+
+namespace {
+// Collects the diagnostics of the current thread into a buffer while alive.
+class DeferDiagnosticsScope {
+public:
+  explicit DeferDiagnosticsScope(DeferredDiagnostics &Diags)
+      : pPrior(CurrentDeferredDiagnostics) {
+    CurrentDeferredDiagnostics = &Diags;
+  }
+  ~DeferDiagnosticsScope() { CurrentDeferredDiagnostics = pPrior; }
+
+private:
+  DeferredDiagnostics *pPrior;
+};
+} // namespace
+
+// Fills the module-wide caches that validating a function body would
+// otherwise fill lazily, so bodies can be validated concurrently.
+static void PrepareConcurrentFunctionValidation(ValidationContext &ValCtx) {
+  Type::getInt8PtrTy(ValCtx.M.getContext());
+  TypeFinder StructTypes;
+  StructTypes.run(ValCtx.M, /*onlyNamed*/ false);
+  for (StructType *ST : StructTypes) {
+    if (ST->isSized())
+      ValCtx.DL.getStructLayout(ST);
+  }
+}
+
+static void ValidateFunctions(ValidationContext &ValCtx) {
+  Module &M = ValCtx.M;
+  unsigned numBodies = 0;
+  for (Function &F : M.functions()) {
+    if (!F.isDeclaration())
+      ++numBodies;
+  }
+  unsigned threadCount =
+      std::min(std::thread::hardware_concurrency(), numBodies);
+  // Worker threads allocate with the caller's allocator.
+  IMalloc *pMalloc = DxcGetThreadMallocNoRef();
+  if (!ValCtx.isLibProfile || numBodies < kMinParallelFunctionBodies ||
+      threadCount < 2 || pMalloc == nullptr) {
+    for (Function &F : M.functions()) {
+      ValidateFunction(F, ValCtx);
+    }
+    return;
+  }
+
+  // Declarations are validated first, on this thread: that validates every
+  // call to a dxil operation, which updates per-entry state and may add
+  // declarations to the module. Diagnostics are buffered per function and
+  // emitted in module order at the end, so the output matches the serial
+  // validation.
+  std::vector<Function *> functions;
+  std::vector<DeferredDiagnostics> diags;
+  for (Function &F : M.functions()) {
+    functions.push_back(&F);
+    diags.emplace_back();
+    if (F.isDeclaration()) {
+      DeferDiagnosticsScope Scope(diags.back());
+      ValidateFunction(F, ValCtx);
+    }
+  }
+
+  PrepareConcurrentFunctionValidation(ValCtx);
+
+  // Validating a body only reads the module and the validation context.
+  RunOnWorkerThreads(functions.size(), threadCount, pMalloc,
+                     [&](size_t i, unsigned) {
+                       if (functions[i]->isDeclaration())
+                         return;
+                       DeferDiagnosticsScope Scope(diags[i]);
+                       ValidateFunction(*functions[i], ValCtx);
+                     });
+
+  for (DeferredDiagnostics &functionDiags : diags) {
+    for (std::function<void()> &emit : functionDiags)
+      emit();
+  }
+}
+
 static void ValidateGlobalVariable(GlobalVariable &GV,
                                    ValidationContext &ValCtx) {
   bool isInternalGV =
@@ -4281,6 +4403,17 @@ static void ValidateShaderFlags(ValidationContext &ValCtx) {
 
   ShaderFlags calcFlags;
   ValCtx.DxilMod.CollectShaderFlagsForModule(calcFlags);
+#ifdef DBG
+  // In-process validation reuses the flags collected while compiling; make
+  // sure every pass that changed a function after they were collected called
+  // InvalidateFunctionShaderFlags.
+  for (const Function &F : ValCtx.M.functions()) {
+    DXASSERT(ValCtx.DxilMod.GetFunctionShaderFlags(&F).GetShaderFlagsRaw() ==
+                 ShaderFlags::CollectShaderFlags(&F, &ValCtx.DxilMod)
+                     .GetShaderFlagsRaw(),
+             "otherwise function changed after its shader flags were collected");
+  }
+#endif
   const uint64_t mask = ShaderFlags::GetShaderFlagsRawForCollection();
   uint64_t declaredFlagsRaw = ValCtx.DxilMod.m_ShaderFlags.GetShaderFlagsRaw();
   uint64_t calcFlagsRaw = calcFlags.GetShaderFlagsRaw();
@@ -5726,9 +5859,7 @@ _Use_decl_annotations_ HRESULT ValidateDxilModule(
   ValidateFlowControl(ValCtx);
 
   // Validate functions.
-  for (Function &F : pModule->functions()) {
-    ValidateFunction(F, ValCtx);
-  }
+  ValidateFunctions(ValCtx);
 
   ValidateShaderFlags(ValCtx);
 
@@ -5989,6 +6120,7 @@ HRESULT ValidateDxilContainerParts(llvm::Module *pModule,
     case DFCC_DXIL:
     case DFCC_ShaderDebugInfoDXIL:
     case DFCC_ShaderDebugName:
+    case DFCC_ReflectionTables:
       continue;
 
     case DFCC_ShaderHash:
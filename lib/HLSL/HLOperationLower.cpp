@@ -28,6 +28,7 @@
 #include "dxc/HLSL/DxilConvergent.h"
 #include "dxc/DXIL/DxilResourceProperties.h"
 
+#include "llvm/Analysis/VectorUtils.h"
 #include "llvm/IR/GetElementPtrTypeIterator.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Instructions.h"
@@ -375,6 +376,16 @@ struct IntrinsicLower {
 // IOP intrinsics.
 namespace {
 
+// Returns element i of a vector operand. Vector operands are usually built
+// element by element, often by lowering an earlier intrinsic, so the scalar
+// is reused directly instead of emitting an extractelement for later passes
+// to fold away.
+Value *GetVectorElement(Value *vec, unsigned i, IRBuilder<> &Builder) {
+  if (Value *elt = findScalarElement(vec, i))
+    return elt;
+  return Builder.CreateExtractElement(vec, i);
+}
+
 Value *TrivialDxilOperation(Function *dxilFunc, OP::OpCode opcode, ArrayRef<Value *> refArgs,
                             Type *Ty, Type *RetTy, OP *hlslOP,
                             IRBuilder<> &Builder) {
@@ -391,7 +402,7 @@ Value *TrivialDxilOperation(Function *dxilFunc, OP::OpCode opcode, ArrayRef<Valu
            argIdx++) {
         if (refArgs[argIdx]->getType()->isVectorTy()) {
           Value *arg = refArgs[argIdx];
-          args[argIdx] = Builder.CreateExtractElement(arg, i);
+          args[argIdx] = GetVectorElement(arg, i, Builder);
         }
       }
       Value *EltOP =
@@ -2038,10 +2049,10 @@ Value *TrivialDotOperation(OP::OpCode opcode, Value *src0,
 
   unsigned vecSize = src0->getType()->getVectorNumElements();
   for (unsigned i = 0; i < vecSize; i++)
-    args.emplace_back(Builder.CreateExtractElement(src0, i));
+    args.emplace_back(GetVectorElement(src0, i, Builder));
 
   for (unsigned i = 0; i < vecSize; i++)
-    args.emplace_back(Builder.CreateExtractElement(src1, i));
+    args.emplace_back(GetVectorElement(src1, i, Builder));
   Value *dotOP = Builder.CreateCall(dxilFunc, args);
 
   return dotOP;
@@ -2049,12 +2060,12 @@ Value *TrivialDotOperation(OP::OpCode opcode, Value *src0,
 
 Value *TranslateIDot(Value *arg0, Value *arg1, unsigned vecSize, hlsl::OP *hlslOP, IRBuilder<> &Builder, bool Unsigned = false) {
   auto madOpCode = Unsigned ? DXIL::OpCode::UMad : DXIL::OpCode::IMad;
-  Value *Elt0 = Builder.CreateExtractElement(arg0, (uint64_t)0);
-  Value *Elt1 = Builder.CreateExtractElement(arg1, (uint64_t)0);
+  Value *Elt0 = GetVectorElement(arg0, 0, Builder);
+  Value *Elt1 = GetVectorElement(arg1, 0, Builder);
   Value *Result = Builder.CreateMul(Elt0, Elt1);
   for (unsigned iVecElt = 1; iVecElt < vecSize; ++iVecElt) {
-    Elt0 = Builder.CreateExtractElement(arg0, iVecElt);
-    Elt1 = Builder.CreateExtractElement(arg1, iVecElt);
+    Elt0 = GetVectorElement(arg0, iVecElt, Builder);
+    Elt1 = GetVectorElement(arg1, iVecElt, Builder);
     Result = TrivialDxilTrinaryOperation(madOpCode, Elt0, Elt1, Result, hlslOP, Builder);
   }
 
@@ -5720,8 +5731,32 @@ static void TranslateBuiltinIntrinsic(CallInst *CI,
   const IntrinsicLower &lower = gLowerTable[opcode];
   Value *Result =
       lower.LowerFunc(CI, lower.IntriOpcode, lower.DxilOpcode, helper, pObjHelper, Translated);
-  if (Result)
-    CI->replaceAllUsesWith(Result);
+  if (!Result)
+    return;
+
+  // Vector results are rebuilt from per-element operations. Users that only
+  // take one element get the scalar directly, and if that leaves the rebuilt
+  // vector unused, it is removed.
+  if (Result->getType()->isVectorTy()) {
+    for (auto U = CI->user_begin(); U != CI->user_end();) {
+      ExtractElementInst *EEI = dyn_cast<ExtractElementInst>(*(U++));
+      if (!EEI || !isa<ConstantInt>(EEI->getIndexOperand()))
+        continue;
+      unsigned Idx = cast<ConstantInt>(EEI->getIndexOperand())->getZExtValue();
+      if (Value *Elt = findScalarElement(Result, Idx)) {
+        EEI->replaceAllUsesWith(Elt);
+        EEI->eraseFromParent();
+      }
+    }
+  }
+  CI->replaceAllUsesWith(Result);
+  Value *V = Result;
+  while (InsertElementInst *IEI = dyn_cast<InsertElementInst>(V)) {
+    if (!IEI->use_empty())
+      break;
+    V = IEI->getOperand(0);
+    IEI->eraseFromParent();
+  }
 }
 
 // SharedMem.
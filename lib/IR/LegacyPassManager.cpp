@@ -22,6 +22,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Mutex.h"
+#include "llvm/Support/TimeProfiler.h" // HLSL Change
 #include "llvm/Support/TimeValue.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -1563,6 +1564,12 @@ bool FPPassManager::runOnFunction(Function &F) {
     {
       PassManagerPrettyStackEntry X(FP, F);
       TimeRegion PassTimer(getPassTimer(FP));
+      // HLSL Change Starts - block passes are timed as a whole by the
+      // BasicBlockPassManager run here, not once per block.
+      Optional<TimeTraceScope> TimeScope;
+      if (timeTraceProfilerEnabled())
+        TimeScope.emplace(FP->getPassName(), F.getName());
+      // HLSL Change Ends
 
       LocalChanged |= FP->runOnFunction(F);
     }
@@ -1639,6 +1646,11 @@ MPPassManager::runOnModule(Module &M) {
     {
       PassManagerPrettyStackEntry X(MP, M);
       TimeRegion PassTimer(getPassTimer(MP));
+      // HLSL Change Starts
+      Optional<TimeTraceScope> TimeScope;
+      if (timeTraceProfilerEnabled())
+        TimeScope.emplace(MP->getPassName());
+      // HLSL Change Ends
 
       LocalChanged |= MP->runOnModule(M);
     }
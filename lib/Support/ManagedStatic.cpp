@@ -20,6 +20,18 @@
 using namespace llvm;
 
 static const ManagedStaticBase *StaticList = nullptr;
+static ManagedStaticCreatorWrapper CreatorWrapper = nullptr; // HLSL Change
+
+// HLSL Change Starts
+void llvm::llvm_set_managed_static_creator_wrapper(
+    ManagedStaticCreatorWrapper Wrapper) {
+  CreatorWrapper = Wrapper;
+}
+
+static void *CreateManagedStatic(void *(*Creator)()) {
+  return CreatorWrapper ? CreatorWrapper(Creator) : Creator();
+}
+// HLSL Change Ends
 
 static sys::Mutex& getManagedStaticMutex() {
   // We need to use a function local static here, since this can get called
@@ -36,7 +48,7 @@ void ManagedStaticBase::RegisterManagedStatic(void *(*Creator)(),
     MutexGuard Lock(getManagedStaticMutex());
 
     if (!Ptr) {
-      void* tmp = Creator();
+      void* tmp = CreateManagedStatic(Creator); // HLSL Change
 
       TsanHappensBefore(this);
       sys::MemoryFence();
@@ -56,7 +68,7 @@ void ManagedStaticBase::RegisterManagedStatic(void *(*Creator)(),
   } else {
     assert(!Ptr && !DeleterFn && !Next &&
            "Partially initialized ManagedStatic!?");
-    Ptr = Creator();
+    Ptr = CreateManagedStatic(Creator); // HLSL Change
     DeleterFn = Deleter;
   
     // Add to list of managed statics.
@@ -0,0 +1,235 @@
+//===-- TimeProfiler.cpp - Per-thread phase profiler ----------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// HLSL Change - new file. Implements the per-thread span profiler declared
+// in TimeProfiler.h.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace llvm {
+
+LLVM_THREAD_LOCAL TimeTraceProfiler *TimeTraceProfilerInstance = nullptr;
+
+typedef std::chrono::steady_clock ClockType;
+typedef std::chrono::microseconds MicroSeconds;
+
+struct TimeTraceEntry {
+  std::string Name;
+  std::string Detail;
+  ClockType::time_point Start;
+  MicroSeconds Duration;
+  unsigned Depth;
+  uint64_t Allocs;      // Counter value at start, then the delta.
+  uint64_t AllocBytes;  // Counter value at start, then the delta.
+  int64_t PeakLive;     // Highest live byte count while open.
+};
+
+struct TimeTraceTotal {
+  uint64_t Count = 0;
+  MicroSeconds Duration = MicroSeconds::zero();
+  uint64_t Allocs = 0;
+  uint64_t AllocBytes = 0;
+  int64_t PeakLive = 0;
+};
+
+struct TimeTraceProfiler {
+  TimeTraceProfiler(bool TrackLiveBytes, unsigned GranularityUs)
+      : StartTime(ClockType::now()), Granularity(GranularityUs),
+        TrackLiveBytes(TrackLiveBytes) {}
+
+  void begin(StringRef Name, StringRef Detail) {
+    Stack.push_back(TimeTraceEntry{Name, Detail, ClockType::now(),
+                                   MicroSeconds::zero(), (unsigned)Stack.size(),
+                                   Allocs, AllocBytes, Live});
+  }
+
+  void end() {
+    if (Stack.empty())
+      return;
+    TimeTraceEntry E = std::move(Stack.back());
+    Stack.pop_back();
+    E.Duration = std::chrono::duration_cast<MicroSeconds>(ClockType::now() -
+                                                          E.Start);
+    E.Allocs = Allocs - E.Allocs;
+    E.AllocBytes = AllocBytes - E.AllocBytes;
+    if (!Stack.empty())
+      Stack.back().PeakLive = std::max(Stack.back().PeakLive, E.PeakLive);
+
+    // Only count the outermost of nested spans with the same name, so that
+    // totals never exceed the wall time actually spent.
+    if (std::none_of(Stack.begin(), Stack.end(),
+                     [&](const TimeTraceEntry &Open) {
+                       return Open.Name == E.Name;
+                     })) {
+      TimeTraceTotal &T = Totals[E.Name];
+      ++T.Count;
+      T.Duration += E.Duration;
+      T.Allocs += E.Allocs;
+      T.AllocBytes += E.AllocBytes;
+      T.PeakLive = std::max(T.PeakLive, E.PeakLive);
+    }
+    if (E.Duration >= Granularity)
+      Entries.push_back(std::move(E));
+  }
+
+  void recordAlloc(size_t Size) {
+    ++Allocs;
+    AllocBytes += Size;
+    if (TrackLiveBytes) {
+      Live += Size;
+      PeakLive = std::max(PeakLive, Live);
+      if (!Stack.empty())
+        Stack.back().PeakLive = std::max(Stack.back().PeakLive, Live);
+    }
+  }
+
+  void recordFree(size_t Size) {
+    // Memory allocated before profiling started may be freed while it runs.
+    if (TrackLiveBytes)
+      Live -= Size;
+  }
+
+  void write(raw_ostream &OS);
+
+  std::vector<TimeTraceEntry> Stack;
+  std::vector<TimeTraceEntry> Entries;
+  StringMap<TimeTraceTotal> Totals;
+  const ClockType::time_point StartTime;
+  const MicroSeconds Granularity;
+  const bool TrackLiveBytes;
+  uint64_t Allocs = 0;
+  uint64_t AllocBytes = 0;
+  int64_t Live = 0;
+  int64_t PeakLive = 0;
+};
+
+} // namespace llvm
+
+static void writeJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (unsigned char C : Str) {
+    switch (C) {
+    case '"':  OS << "\\\""; break;
+    case '\\': OS << "\\\\"; break;
+    case '\n': OS << "\\n"; break;
+    case '\r': OS << "\\r"; break;
+    case '\t': OS << "\\t"; break;
+    default:
+      if (C < 0x20)
+        OS << format("\\u%04x", C);
+      else
+        OS << C;
+    }
+  }
+  OS << '"';
+}
+
+void TimeTraceProfiler::write(raw_ostream &OS) {
+  // Chrome trace-event format, viewable in chrome://tracing, with an extra
+  // "totals" array summarizing each span name for aggregation.
+  OS << "{\"traceEvents\":[";
+  bool First = true;
+  for (const TimeTraceEntry &E : Entries) {
+    OS << (First ? "\n" : ",\n");
+    First = false;
+    int64_t StartUs =
+        std::chrono::duration_cast<MicroSeconds>(E.Start - StartTime).count();
+    OS << "{\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":" << StartUs
+       << ",\"dur\":" << (int64_t)E.Duration.count() << ",\"name\":";
+    writeJSONString(OS, E.Name);
+    OS << ",\"args\":{";
+    if (!E.Detail.empty()) {
+      OS << "\"detail\":";
+      writeJSONString(OS, E.Detail);
+      OS << ',';
+    }
+    OS << "\"depth\":" << E.Depth << ",\"allocs\":" << E.Allocs
+       << ",\"allocBytes\":" << E.AllocBytes;
+    if (TrackLiveBytes)
+      OS << ",\"peakLiveBytes\":" << E.PeakLive;
+    OS << "}}";
+  }
+  OS << "\n],\"totals\":[";
+
+  // Sort by name so reports from different compiles line up.
+  std::vector<StringRef> Names;
+  for (const auto &T : Totals)
+    Names.push_back(T.getKey());
+  std::sort(Names.begin(), Names.end());
+  First = true;
+  for (StringRef Name : Names) {
+    const TimeTraceTotal &T = Totals.find(Name)->getValue();
+    OS << (First ? "\n" : ",\n");
+    First = false;
+    OS << "{\"name\":";
+    writeJSONString(OS, Name);
+    OS << ",\"count\":" << T.Count << ",\"dur\":" << (int64_t)T.Duration.count()
+       << ",\"allocs\":" << T.Allocs << ",\"allocBytes\":" << T.AllocBytes;
+    if (TrackLiveBytes)
+      OS << ",\"peakLiveBytes\":" << T.PeakLive;
+    OS << '}';
+  }
+  OS << "\n],\"allocs\":" << Allocs << ",\"allocBytes\":" << AllocBytes;
+  if (TrackLiveBytes)
+    OS << ",\"peakLiveBytes\":" << PeakLive;
+  OS << ",\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void llvm::timeTraceProfilerInitialize(bool TrackLiveBytes,
+                                       unsigned GranularityUs) {
+  assert(TimeTraceProfilerInstance == nullptr &&
+         "Profiler should not be initialized");
+  TimeTraceProfilerInstance =
+      new TimeTraceProfiler(TrackLiveBytes, GranularityUs);
+}
+
+void llvm::timeTraceProfilerCleanup() {
+  // Detach first; the frees made while destroying the profiler must not be
+  // recorded into it.
+  TimeTraceProfiler *Profiler = TimeTraceProfilerInstance;
+  TimeTraceProfilerInstance = nullptr;
+  delete Profiler;
+}
+
+void llvm::timeTraceProfilerWrite(raw_ostream &OS) {
+  assert(TimeTraceProfilerInstance != nullptr &&
+         "Profiler object can't be null");
+  TimeTraceProfilerInstance->write(OS);
+}
+
+void llvm::timeTraceProfilerBegin(StringRef Name, StringRef Detail) {
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->begin(Name, Detail);
+}
+
+void llvm::timeTraceProfilerEnd() {
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->end();
+}
+
+void llvm::timeTraceProfilerRecordAlloc(size_t Size) {
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->recordAlloc(Size);
+}
+
+void llvm::timeTraceProfilerRecordFree(size_t Size) {
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->recordFree(Size);
+}
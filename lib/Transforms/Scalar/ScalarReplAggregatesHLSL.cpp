@@ -1688,6 +1688,17 @@ bool isGroupShareOrConstStaticArray(GlobalVariable *GV) {
   return Ty->isArrayTy();
 }
 
+// Adds the functions with an instruction that uses V, directly or through
+// constant expressions, to Fns.
+void CollectUserFunctions(Value *V, SmallPtrSetImpl<Function *> &Fns) {
+  for (User *U : V->users()) {
+    if (Instruction *I = dyn_cast<Instruction>(U))
+      Fns.insert(I->getParent()->getParent());
+    else if (isa<ConstantExpr>(U))
+      CollectUserFunctions(U, Fns);
+  }
+}
+
 bool SROAGlobalAndAllocas(HLModule &HLM, bool bHasDbgInfo) {
   Module &M = *HLM.GetModule();
   DxilTypeSystem &typeSys = HLM.GetTypeSystem();
@@ -1735,25 +1746,6 @@ bool SROAGlobalAndAllocas(HLModule &HLM, bool bHasDbgInfo) {
   for (GlobalVariable *GV : staticGVs)
     WorkList.push(GV);
 
-  DenseMap<Function *, DominatorTree> domTreeMap;
-  for (Function &F : M) {
-    if (F.isDeclaration())
-      continue;
-    // Collect domTree.
-    domTreeMap[&F].recalculate(F);
-
-    // Scan the entry basic block, adding allocas to the worklist.
-    BasicBlock &BB = F.getEntryBlock();
-    for (BasicBlock::iterator I = BB.begin(), E = BB.end(); I != E; ++I)
-      if (AllocaInst *A = dyn_cast<AllocaInst>(I)) {
-        if (!A->user_empty()) {
-          WorkList.push(A);
-          // merge GEP use for the allocs
-          HLModule::MergeGepUse(A);
-        }
-      }
-  }
-
   // Establish debug metadata layout name in the context in advance so the name
   // is serialized in both debug and non-debug compilations.
   (void)M.getContext().getMDKindID(
@@ -1769,215 +1761,265 @@ bool SROAGlobalAndAllocas(HLModule &HLM, bool bHasDbgInfo) {
   std::unordered_map<Value *, StringRef> EltNameMap;
 
   bool Changed = false;
-  while (!WorkList.empty()) {
-    Value *V = WorkList.top();
-    WorkList.pop();
 
-    if (AllocaInst *AI = dyn_cast<AllocaInst>(V)) {
-      // Handle dead allocas trivially.  These can be formed by SROA'ing arrays
-      // with unused elements.
-      if (AI->use_empty()) {
-        AI->eraseFromParent();
-        Changed = true;
-        continue;
-      }
-      Function *F = AI->getParent()->getParent();
-      const bool bAllowReplace = true;
-      DominatorTree &DT = domTreeMap[F];
-      if (SROA_Helper::LowerMemcpy(AI, /*annotation*/ nullptr, typeSys, DL, &DT,
-                                   bAllowReplace)) {
-        Changed = true;
-        continue;
-      }
+  auto SROAAlloca = [&](AllocaInst *AI, DominatorTree &DT) {
+    // Handle dead allocas trivially.  These can be formed by SROA'ing arrays
+    // with unused elements.
+    if (AI->use_empty()) {
+      AI->eraseFromParent();
+      Changed = true;
+      return;
+    }
+    const bool bAllowReplace = true;
+    if (SROA_Helper::LowerMemcpy(AI, /*annotation*/ nullptr, typeSys, DL, &DT,
+                                 bAllowReplace)) {
+      Changed = true;
+      return;
+    }
 
-      // If this alloca is impossible for us to promote, reject it early.
-      if (AI->isArrayAllocation() || !AI->getAllocatedType()->isSized())
-        continue;
+    // If this alloca is impossible for us to promote, reject it early.
+    if (AI->isArrayAllocation() || !AI->getAllocatedType()->isSized())
+      return;
 
-      // Check to see if we can perform the core SROA transformation.  We cannot
-      // transform the allocation instruction if it is an array allocation
-      // (allocations OF arrays are ok though), and an allocation of a scalar
-      // value cannot be decomposed at all.
-      uint64_t AllocaSize = DL.getTypeAllocSize(AI->getAllocatedType());
+    // Check to see if we can perform the core SROA transformation.  We cannot
+    // transform the allocation instruction if it is an array allocation
+    // (allocations OF arrays are ok though), and an allocation of a scalar
+    // value cannot be decomposed at all.
+    uint64_t AllocaSize = DL.getTypeAllocSize(AI->getAllocatedType());
 
-      // Do not promote [0 x %struct].
-      if (AllocaSize == 0)
-        continue;
+    // Do not promote [0 x %struct].
+    if (AllocaSize == 0)
+      return;
 
-      Type *Ty = AI->getAllocatedType();
-      // Skip empty struct type.
-      if (SROA_Helper::IsEmptyStructType(Ty, typeSys)) {
-        SROA_Helper::MarkEmptyStructUsers(AI, DeadInsts);
-        DeleteDeadInstructions(DeadInsts);
-        continue;
-      }
+    Type *Ty = AI->getAllocatedType();
+    // Skip empty struct type.
+    if (SROA_Helper::IsEmptyStructType(Ty, typeSys)) {
+      SROA_Helper::MarkEmptyStructUsers(AI, DeadInsts);
+      DeleteDeadInstructions(DeadInsts);
+      return;
+    }
 
-      if (Value *NewV = TranslatePtrIfUsedByLoweredFn(AI, typeSys)) {
-        if (NewV != AI) {
-          DXASSERT(AI->getNumUses() == 0, "must have zero users.");
-          // Update debug declare.
-          if (DbgDeclareInst *DDI = llvm::FindAllocaDbgDeclare(AI)) {
-            DDI->setArgOperand(0, MetadataAsValue::get(NewV->getContext(), ValueAsMetadata::get(NewV)));
-          }
-          AI->eraseFromParent();
-          Changed = true;
+    if (Value *NewV = TranslatePtrIfUsedByLoweredFn(AI, typeSys)) {
+      if (NewV != AI) {
+        DXASSERT(AI->getNumUses() == 0, "must have zero users.");
+        // Update debug declare.
+        if (DbgDeclareInst *DDI = llvm::FindAllocaDbgDeclare(AI)) {
+          DDI->setArgOperand(0, MetadataAsValue::get(NewV->getContext(), ValueAsMetadata::get(NewV)));
         }
-        continue;
+        AI->eraseFromParent();
+        Changed = true;
       }
+      return;
+    }
 
-      // If the alloca looks like a good candidate for scalar replacement, and
-      // if
-      // all its users can be transformed, then split up the aggregate into its
-      // separate elements.
-      if (ShouldAttemptScalarRepl(AI) && isSafeAllocaToScalarRepl(AI)) {
-        std::vector<Value *> Elts;
-        IRBuilder<> Builder(dxilutil::FindAllocaInsertionPt(AI));
-        bool hasPrecise = HLModule::HasPreciseAttributeWithMetadata(AI);
-
-        Type *BrokenUpTy = nullptr;
-        uint64_t NumInstances = 1;
-        bool SROAed = SROA_Helper::DoScalarReplacement(
-            AI, Elts, BrokenUpTy, NumInstances, Builder,
-            /*bFlatVector*/ true, hasPrecise, typeSys, DL, DeadInsts, &DT);
-
-        if (SROAed) {
-          Type *Ty = AI->getAllocatedType();
-          // Skip empty struct parameters.
-          if (StructType *ST = dyn_cast<StructType>(Ty)) {
-            if (!HLMatrixType::isa(Ty)) {
-              DxilStructAnnotation *SA = typeSys.GetStructAnnotation(ST);
-              if (SA && SA->IsEmptyStruct()) {
-                for (User *U : AI->users()) {
-                  if (StoreInst *SI = dyn_cast<StoreInst>(U))
-                    DeadInsts.emplace_back(SI);
-                }
-                DeleteDeadInstructions(DeadInsts);
-                AI->replaceAllUsesWith(UndefValue::get(AI->getType()));
-                AI->eraseFromParent();
-                continue;
+    // If the alloca looks like a good candidate for scalar replacement, and
+    // if
+    // all its users can be transformed, then split up the aggregate into its
+    // separate elements.
+    if (ShouldAttemptScalarRepl(AI) && isSafeAllocaToScalarRepl(AI)) {
+      std::vector<Value *> Elts;
+      IRBuilder<> Builder(dxilutil::FindAllocaInsertionPt(AI));
+      bool hasPrecise = HLModule::HasPreciseAttributeWithMetadata(AI);
+
+      Type *BrokenUpTy = nullptr;
+      uint64_t NumInstances = 1;
+      bool SROAed = SROA_Helper::DoScalarReplacement(
+          AI, Elts, BrokenUpTy, NumInstances, Builder,
+          /*bFlatVector*/ true, hasPrecise, typeSys, DL, DeadInsts, &DT);
+
+      if (SROAed) {
+        Type *Ty = AI->getAllocatedType();
+        // Skip empty struct parameters.
+        if (StructType *ST = dyn_cast<StructType>(Ty)) {
+          if (!HLMatrixType::isa(Ty)) {
+            DxilStructAnnotation *SA = typeSys.GetStructAnnotation(ST);
+            if (SA && SA->IsEmptyStruct()) {
+              for (User *U : AI->users()) {
+                if (StoreInst *SI = dyn_cast<StoreInst>(U))
+                  DeadInsts.emplace_back(SI);
               }
+              DeleteDeadInstructions(DeadInsts);
+              AI->replaceAllUsesWith(UndefValue::get(AI->getType()));
+              AI->eraseFromParent();
+              return;
             }
           }
+        }
 
-          addDebugInfoForElements(AI, BrokenUpTy, NumInstances, Elts, DL, &DIB);
-
-          // Push Elts into workList.
-          for (unsigned EltIdx = 0; EltIdx < Elts.size(); ++EltIdx) {
-            AllocaInst *EltAlloca = cast<AllocaInst>(Elts[EltIdx]);
-            WorkList.push(EltAlloca);
-          }
+        addDebugInfoForElements(AI, BrokenUpTy, NumInstances, Elts, DL, &DIB);
 
-          // Now erase any instructions that were made dead while rewriting the
-          // alloca.
-          DeleteDeadInstructions(DeadInsts);
-          ++NumReplaced;
-          DXASSERT(AI->getNumUses() == 0, "must have zero users.");
-          AI->eraseFromParent();
-          Changed = true;
-          continue;
+        // Push Elts into workList.
+        for (unsigned EltIdx = 0; EltIdx < Elts.size(); ++EltIdx) {
+          AllocaInst *EltAlloca = cast<AllocaInst>(Elts[EltIdx]);
+          WorkList.push(EltAlloca);
         }
-      }
-    } else {
-      GlobalVariable *GV = cast<GlobalVariable>(V);
-      if (staticGVs.count(GV)) {
-        Type *Ty = GV->getType()->getPointerElementType();
-        // Skip basic types.
-        if (!Ty->isAggregateType() && !Ty->isVectorTy())
-          continue;
-        // merge GEP use for global.
-        HLModule::MergeGepUse(GV);
-      }
 
-      const bool bAllowReplace = true;
-      // SROA_Parameter_HLSL has no access to a domtree, if one is needed, it'll
-      // be generated
-      if (SROA_Helper::LowerMemcpy(GV, /*annotation*/ nullptr, typeSys, DL,
-                                   nullptr /*DT */, bAllowReplace)) {
-        continue;
+        // Now erase any instructions that were made dead while rewriting the
+        // alloca.
+        DeleteDeadInstructions(DeadInsts);
+        ++NumReplaced;
+        DXASSERT(AI->getNumUses() == 0, "must have zero users.");
+        AI->eraseFromParent();
+        Changed = true;
+        return;
       }
+    }
+  };
 
-      // Flat Global vector if no dynamic vector indexing.
-      bool bFlatVector = !hasDynamicVectorIndexing(GV);
+  auto SROAGlobal = [&](GlobalVariable *GV) {
+    if (staticGVs.count(GV)) {
+      Type *Ty = GV->getType()->getPointerElementType();
+      // Skip basic types.
+      if (!Ty->isAggregateType() && !Ty->isVectorTy())
+        return;
+      // merge GEP use for global.
+      HLModule::MergeGepUse(GV);
+    }
 
-      if (bFlatVector) {
-        GVDbgOffset &dbgOffset = GVDbgOffsetMap[GV];
-        GlobalVariable *baseGV = dbgOffset.base;
-        // Disable scalarization of groupshared/const_static vector arrays
-        if (isGroupShareOrConstStaticArray(baseGV))
-          bFlatVector = false;
-      }
+    const bool bAllowReplace = true;
+    // SROA_Parameter_HLSL has no access to a domtree, if one is needed, it'll
+    // be generated
+    if (SROA_Helper::LowerMemcpy(GV, /*annotation*/ nullptr, typeSys, DL,
+                                 nullptr /*DT */, bAllowReplace)) {
+      return;
+    }
 
-      std::vector<Value *> Elts;
-      bool SROAed = false;
-      if (GlobalVariable *NewEltGV = dyn_cast_or_null<GlobalVariable>(
-              TranslatePtrIfUsedByLoweredFn(GV, typeSys))) {
-        GVDbgOffset dbgOffset = GVDbgOffsetMap[GV];
-        // Don't need to update when skip SROA on base GV.
-        if (NewEltGV == dbgOffset.base)
-          continue;
+    // Flat Global vector if no dynamic vector indexing.
+    bool bFlatVector = !hasDynamicVectorIndexing(GV);
 
-        if (GV != NewEltGV) {
-          GVDbgOffsetMap[NewEltGV] = dbgOffset;
-          // Remove GV from GVDbgOffsetMap.
-          GVDbgOffsetMap.erase(GV);
-          if (GV != dbgOffset.base) {
-            // Remove GV when it is replaced by NewEltGV and is not a base GV.
-            GV->removeDeadConstantUsers();
-            GV->eraseFromParent();
-          }
-          GV = NewEltGV;
+    if (bFlatVector) {
+      GVDbgOffset &dbgOffset = GVDbgOffsetMap[GV];
+      GlobalVariable *baseGV = dbgOffset.base;
+      // Disable scalarization of groupshared/const_static vector arrays
+      if (isGroupShareOrConstStaticArray(baseGV))
+        bFlatVector = false;
+    }
+
+    std::vector<Value *> Elts;
+    bool SROAed = false;
+    if (GlobalVariable *NewEltGV = dyn_cast_or_null<GlobalVariable>(
+            TranslatePtrIfUsedByLoweredFn(GV, typeSys))) {
+      GVDbgOffset dbgOffset = GVDbgOffsetMap[GV];
+      // Don't need to update when skip SROA on base GV.
+      if (NewEltGV == dbgOffset.base)
+        return;
+
+      if (GV != NewEltGV) {
+        GVDbgOffsetMap[NewEltGV] = dbgOffset;
+        // Remove GV from GVDbgOffsetMap.
+        GVDbgOffsetMap.erase(GV);
+        if (GV != dbgOffset.base) {
+          // Remove GV when it is replaced by NewEltGV and is not a base GV.
+          GV->removeDeadConstantUsers();
+          GV->eraseFromParent();
         }
-      } else {
-        // SROA_Parameter_HLSL has no access to a domtree, if one is needed,
-        // it'll be generated
-        SROAed = SROA_Helper::DoScalarReplacement(
-            GV, Elts, Builder, bFlatVector,
-            // TODO: set precise.
-            /*hasPrecise*/ false, typeSys, DL, DeadInsts, /*DT*/ nullptr);
+        GV = NewEltGV;
       }
+    } else {
+      // SROA_Parameter_HLSL has no access to a domtree, if one is needed,
+      // it'll be generated
+      SROAed = SROA_Helper::DoScalarReplacement(
+          GV, Elts, Builder, bFlatVector,
+          // TODO: set precise.
+          /*hasPrecise*/ false, typeSys, DL, DeadInsts, /*DT*/ nullptr);
+    }
 
-      if (SROAed) {
-        GVDbgOffset dbgOffset = GVDbgOffsetMap[GV];
-        unsigned offset = 0;
-        // Push Elts into workList.
-        for (auto iter = Elts.begin(); iter != Elts.end(); iter++) {
-          WorkList.push(*iter);
-          GlobalVariable *EltGV = cast<GlobalVariable>(*iter);
-          if (bHasDbgInfo) {
-            StringRef OriginEltName = EltGV->getName();
-            StringRef OriginName = dbgOffset.base->getName();
-            StringRef EltName = OriginEltName.substr(OriginName.size());
-            StringRef EltParentName = OriginEltName.substr(0, OriginName.size());
-            DXASSERT_LOCALVAR(EltParentName, EltParentName == OriginName, "parent name mismatch");
-            EltNameMap[EltGV] = EltName;
-          }
-          GVDbgOffset &EltDbgOffset = GVDbgOffsetMap[EltGV];
-          EltDbgOffset.base = dbgOffset.base;
-          EltDbgOffset.debugOffset = dbgOffset.debugOffset + offset;
-          unsigned size =
-              DL.getTypeAllocSizeInBits(EltGV->getType()->getElementType());
-          offset += size;
+    if (SROAed) {
+      GVDbgOffset dbgOffset = GVDbgOffsetMap[GV];
+      unsigned offset = 0;
+      // Push Elts into workList.
+      for (auto iter = Elts.begin(); iter != Elts.end(); iter++) {
+        WorkList.push(*iter);
+        GlobalVariable *EltGV = cast<GlobalVariable>(*iter);
+        if (bHasDbgInfo) {
+          StringRef OriginEltName = EltGV->getName();
+          StringRef OriginName = dbgOffset.base->getName();
+          StringRef EltName = OriginEltName.substr(OriginName.size());
+          StringRef EltParentName = OriginEltName.substr(0, OriginName.size());
+          DXASSERT_LOCALVAR(EltParentName, EltParentName == OriginName, "parent name mismatch");
+          EltNameMap[EltGV] = EltName;
         }
-        GV->removeDeadConstantUsers();
-        // Now erase any instructions that were made dead while rewriting the
-        // alloca.
-        DeleteDeadInstructions(DeadInsts);
-        ++NumReplaced;
-      } else {
-        // Add debug info for flattened globals.
-        if (bHasDbgInfo && staticGVs.count(GV) == 0) {
-          GVDbgOffset &dbgOffset = GVDbgOffsetMap[GV];
-          DebugInfoFinder &Finder = HLM.GetOrCreateDebugInfoFinder();
-          Type *Ty = GV->getType()->getElementType();
-          unsigned size = DL.getTypeAllocSizeInBits(Ty);
-          unsigned align = DL.getPrefTypeAlignment(Ty);
-          HLModule::CreateElementGlobalVariableDebugInfo(
-              dbgOffset.base, Finder, GV, size, align, dbgOffset.debugOffset,
-              EltNameMap[GV]);
+        GVDbgOffset &EltDbgOffset = GVDbgOffsetMap[EltGV];
+        EltDbgOffset.base = dbgOffset.base;
+        EltDbgOffset.debugOffset = dbgOffset.debugOffset + offset;
+        unsigned size =
+            DL.getTypeAllocSizeInBits(EltGV->getType()->getElementType());
+        offset += size;
+      }
+      GV->removeDeadConstantUsers();
+      // Now erase any instructions that were made dead while rewriting the
+      // alloca.
+      DeleteDeadInstructions(DeadInsts);
+      ++NumReplaced;
+    } else {
+      // Add debug info for flattened globals.
+      if (bHasDbgInfo && staticGVs.count(GV) == 0) {
+        GVDbgOffset &dbgOffset = GVDbgOffsetMap[GV];
+        DebugInfoFinder &Finder = HLM.GetOrCreateDebugInfoFinder();
+        Type *Ty = GV->getType()->getElementType();
+        unsigned size = DL.getTypeAllocSizeInBits(Ty);
+        unsigned align = DL.getPrefTypeAlignment(Ty);
+        HLModule::CreateElementGlobalVariableDebugInfo(
+            dbgOffset.base, Finder, GV, size, align, dbgOffset.debugOffset,
+            EltNameMap[GV]);
+      }
+    }
+    // Remove GV from GVDbgOffsetMap.
+    GVDbgOffsetMap.erase(GV);
+  };
+
+  // Scan the entry basic block, adding allocas to the worklist.
+  auto AddAllocas = [&](Function &F) {
+    BasicBlock &BB = F.getEntryBlock();
+    for (BasicBlock::iterator I = BB.begin(), E = BB.end(); I != E; ++I)
+      if (AllocaInst *A = dyn_cast<AllocaInst>(I)) {
+        if (!A->user_empty()) {
+          WorkList.push(A);
+          // merge GEP use for the allocs
+          HLModule::MergeGepUse(A);
         }
       }
-      // Remove GV from GVDbgOffsetMap.
-      GVDbgOffsetMap.erase(GV);
+  };
+
+  // A static global can be copied to or from the allocas of any function
+  // that uses it, so those allocas share the work list with the static
+  // globals to keep the big-first order between the two kinds.
+  SmallPtrSet<Function *, 8> staticGVUsers;
+  for (GlobalVariable *GV : staticGVs)
+    CollectUserFunctions(GV, staticGVUsers);
+  DenseMap<Function *, DominatorTree> domTreeMap;
+  for (Function &F : M) {
+    if (F.isDeclaration() || !staticGVUsers.count(&F))
+      continue;
+    // Collect domTree.
+    domTreeMap[&F].recalculate(F);
+    AddAllocas(F);
+  }
+
+  while (!WorkList.empty()) {
+    Value *V = WorkList.top();
+    WorkList.pop();
+    if (AllocaInst *AI = dyn_cast<AllocaInst>(V))
+      SROAAlloca(AI, domTreeMap[AI->getParent()->getParent()]);
+    else
+      SROAGlobal(cast<GlobalVariable>(V));
+  }
+  domTreeMap.clear();
+
+  // The allocas of every other function can only interact with each other,
+  // so those functions go one at a time: only one dominator tree is alive
+  // and the work list only holds the allocas of that function.
+  for (Function &F : M) {
+    if (F.isDeclaration() || staticGVUsers.count(&F))
+      continue;
+    DominatorTree DT;
+    DT.recalculate(F);
+    AddAllocas(F);
+
+    while (!WorkList.empty()) {
+      AllocaInst *AI = cast<AllocaInst>(WorkList.top());
+      WorkList.pop();
+      SROAAlloca(AI, DT);
     }
   }
 
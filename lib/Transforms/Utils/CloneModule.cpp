@@ -33,6 +33,14 @@ Module *llvm::CloneModule(const Module *M) {
 }
 
 Module *llvm::CloneModule(const Module *M, ValueToValueMapTy &VMap) {
+  // HLSL Change Starts - Clone all definitions.
+  return CloneModule(M, VMap, [](const Function *) { return true; });
+}
+
+Module *llvm::CloneModule(
+    const Module *M, ValueToValueMapTy &VMap,
+    std::function<bool(const Function *)> ShouldCloneDefinition) {
+  // HLSL Change Ends
   // First off, we need to create the new module.
   Module *New = new Module(M->getModuleIdentifier(), M->getContext());
   New->setDataLayout(M->getDataLayout());
@@ -89,6 +97,12 @@ Module *llvm::CloneModule(const Module *M, ValueToValueMapTy &VMap) {
   //
   for (Module::const_iterator I = M->begin(), E = M->end(); I != E; ++I) {
     Function *F = cast<Function>(VMap[I]);
+    // HLSL Change Starts - Skip the body, leaving an external declaration.
+    if (!I->isDeclaration() && !ShouldCloneDefinition(I)) {
+      F->setLinkage(GlobalValue::ExternalLinkage);
+      continue;
+    }
+    // HLSL Change Ends
     if (!I->isDeclaration()) {
       Function::arg_iterator DestI = F->arg_begin();
       for (Function::const_arg_iterator J = I->arg_begin(); J != I->arg_end();
@@ -72,6 +72,10 @@ private:
 
   void DxilConvTestCheckFile(LPCWSTR path) {
     FileRunTestResult t = FileRunTestResult::RunFromFileCommands(path, m_dllSupport, &m_TestToolPaths);
+    if (!t.Log.empty()) {
+      CA2W logWide(t.Log.c_str(), CP_UTF8);
+      WEX::Logging::Log::Comment(logWide);
+    }
     if (t.RunResult != 0) {
       CA2W commentWide(t.ErrorMessage.c_str(), CP_UTF8);
       WEX::Logging::Log::Comment(commentWide);
@@ -163,6 +163,13 @@ void AttachHeaderIncludeGen(Preprocessor &PP, bool ShowAllHeaders = false,
 /// Cache tokens for use with PCH. Note that this requires a seekable stream.
 void CacheTokens(Preprocessor &PP, raw_pwrite_stream *OS);
 
+// HLSL Change Begin
+/// Cache the tokens of every file \p PP has already read, without lexing the
+/// main file again. Relative file names are cached as well. Note that this
+/// requires a seekable stream.
+void CacheTokensForLoadedFiles(Preprocessor &PP, raw_pwrite_stream *OS);
+// HLSL Change End
+
 /// The ChainedIncludesSource class converts headers to chained PCHs in
 /// memory, mainly for testing.
 IntrusiveRefCntPtr<ExternalSemaSource>
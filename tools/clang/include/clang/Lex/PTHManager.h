@@ -22,6 +22,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/OnDiskHashTable.h"
+#include <functional> // HLSL Change
 #include <string>
 
 namespace llvm {
@@ -83,6 +84,17 @@ class PTHManager : public IdentifierInfoLookup {
   ///  if the file (if any) that was to used to generate the PTH cache.
   const char* OriginalSourceFile;
 
+  // HLSL Change Begin - per-file validation of cached tokens.
+public:
+  /// Decides whether the cached tokens of a file may be used, given the
+  /// file's current contents.
+  typedef std::function<bool(const FileEntry *, const llvm::MemoryBuffer *)>
+      FileFilterTy;
+
+private:
+  FileFilterTy FileFilter;
+  // HLSL Change End
+
   /// This constructor is intended to only be called by the static 'Create'
   /// method.
   PTHManager(std::unique_ptr<const llvm::MemoryBuffer> buf,
@@ -131,6 +143,17 @@ public:
   ///  is the name of the PTH file.  This method returns NULL upon failure.
   static PTHManager *Create(StringRef file, DiagnosticsEngine &Diags);
 
+  // HLSL Change Begin - create from an in-memory PTH image.
+  /// Create - As above, but reads the PTH data from \p File; \p Name is only
+  ///  used for diagnostics.
+  static PTHManager *Create(std::unique_ptr<llvm::MemoryBuffer> File,
+                            StringRef Name, DiagnosticsEngine &Diags);
+
+  /// setFileFilter - Only use the cached tokens of files accepted by
+  ///  \p Filter; other files are lexed from their current contents.
+  void setFileFilter(FileFilterTy Filter) { FileFilter = std::move(Filter); }
+  // HLSL Change End
+
   void setPreprocessor(Preprocessor *pp) { PP = pp; }
 
   /// CreateLexer - Return a PTHLexer that "lexes" the cached tokens for the
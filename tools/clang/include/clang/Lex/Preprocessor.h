@@ -690,7 +690,7 @@ public:
   Builtin::Context &getBuiltinInfo() { return BuiltinInfo; }
   llvm::BumpPtrAllocator &getPreprocessorAllocator() { return BP; }
 
-  void setPTHManager(PTHManager* pm);
+  void setPTHManager(PTHManager* pm, bool UseStatCache = true); // HLSL Change - UseStatCache
 
   PTHManager *getPTHManager() { return PTH.get(); }
 
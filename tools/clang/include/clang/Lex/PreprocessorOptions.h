@@ -16,6 +16,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 #include <cassert>
+#include <functional> // HLSL Change
 #include <set>
 #include <string>
 #include <utility>
@@ -27,6 +28,7 @@ namespace llvm {
 
 namespace clang {
 
+class FileEntry; // HLSL Change
 class Preprocessor;
 class LangOptions;
 
@@ -96,6 +98,18 @@ public:
   /// If given, a PTH cache file to use for speeding up header parsing.
   std::string TokenCache;
 
+  // HLSL Change Begin - in-memory token cache.
+  /// If given and TokenCache is empty, an in-memory PTH image to use for
+  /// speeding up header parsing. Not owned; must outlive the preprocessor.
+  /// The 'stat' results recorded in the image are not used.
+  const llvm::MemoryBuffer *TokenCacheBuffer;
+
+  /// If set, the cached tokens of a file are only used when this accepts the
+  /// file's current contents.
+  std::function<bool(const FileEntry *, const llvm::MemoryBuffer *)>
+      TokenCacheFileFilter;
+  // HLSL Change End
+
   /// \brief True if the SourceManager should report the original file name for
   /// contents of files that were remapped to other files. Defaults to true.
   bool RemappedFilesKeepOriginalName;
@@ -153,6 +167,7 @@ public:
                           AllowPCHWithCompilerErrors(false),
                           DumpDeserializedPCHDecls(false),
                           PrecompiledPreambleBytes(0, true),
+                          TokenCacheBuffer(nullptr), // HLSL Change
                           RemappedFilesKeepOriginalName(true),
                           RetainRemappedFileBuffers(false),
                           ObjCXXARCStandardLibrary(ARCXX_nolib) { }
@@ -182,6 +197,8 @@ public:
     ImplicitPCHInclude.clear();
     ImplicitPTHInclude.clear();
     TokenCache.clear();
+    TokenCacheBuffer = nullptr;     // HLSL Change
+    TokenCacheFileFilter = nullptr; // HLSL Change
     RetainRemappedFileBuffers = true;
     PrecompiledPreambleBytes.first = 0;
     PrecompiledPreambleBytes.second = 0;
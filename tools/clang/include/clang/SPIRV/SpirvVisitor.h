@@ -10,6 +10,8 @@
 
 #include "dxc/Support/SPIRVOptions.h"
 #include "clang/SPIRV/SpirvInstruction.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
 
 namespace clang {
 namespace spirv {
@@ -52,94 +54,9 @@ public:
   /// regardless of their polymorphism.
   virtual bool visitInstruction(SpirvInstruction *) { return true; }
 
-#define DEFINE_VISIT_METHOD(cls)                                               \
+#define SPIRV_VISITOR_INSTRUCTION(cls)                                         \
   virtual bool visit(cls *i) { return visitInstruction(i); }
-
-  DEFINE_VISIT_METHOD(SpirvCapability)
-  DEFINE_VISIT_METHOD(SpirvExtension)
-  DEFINE_VISIT_METHOD(SpirvExtInstImport)
-  DEFINE_VISIT_METHOD(SpirvMemoryModel)
-  DEFINE_VISIT_METHOD(SpirvEntryPoint)
-  DEFINE_VISIT_METHOD(SpirvExecutionMode)
-  DEFINE_VISIT_METHOD(SpirvString)
-  DEFINE_VISIT_METHOD(SpirvSource)
-  DEFINE_VISIT_METHOD(SpirvModuleProcessed)
-  DEFINE_VISIT_METHOD(SpirvDecoration)
-  DEFINE_VISIT_METHOD(SpirvVariable)
-
-  DEFINE_VISIT_METHOD(SpirvFunctionParameter)
-  DEFINE_VISIT_METHOD(SpirvLoopMerge)
-  DEFINE_VISIT_METHOD(SpirvSelectionMerge)
-  DEFINE_VISIT_METHOD(SpirvBranching)
-  DEFINE_VISIT_METHOD(SpirvBranch)
-  DEFINE_VISIT_METHOD(SpirvBranchConditional)
-  DEFINE_VISIT_METHOD(SpirvKill)
-  DEFINE_VISIT_METHOD(SpirvReturn)
-  DEFINE_VISIT_METHOD(SpirvSwitch)
-  DEFINE_VISIT_METHOD(SpirvUnreachable)
-
-  DEFINE_VISIT_METHOD(SpirvAccessChain)
-  DEFINE_VISIT_METHOD(SpirvAtomic)
-  DEFINE_VISIT_METHOD(SpirvBarrier)
-  DEFINE_VISIT_METHOD(SpirvBinaryOp)
-  DEFINE_VISIT_METHOD(SpirvBitFieldExtract)
-  DEFINE_VISIT_METHOD(SpirvBitFieldInsert)
-  DEFINE_VISIT_METHOD(SpirvConstantBoolean)
-  DEFINE_VISIT_METHOD(SpirvConstantInteger)
-  DEFINE_VISIT_METHOD(SpirvConstantFloat)
-  DEFINE_VISIT_METHOD(SpirvConstantComposite)
-  DEFINE_VISIT_METHOD(SpirvConstantNull)
-  DEFINE_VISIT_METHOD(SpirvCompositeConstruct)
-  DEFINE_VISIT_METHOD(SpirvCompositeExtract)
-  DEFINE_VISIT_METHOD(SpirvCompositeInsert)
-  DEFINE_VISIT_METHOD(SpirvEmitVertex)
-  DEFINE_VISIT_METHOD(SpirvEndPrimitive)
-  DEFINE_VISIT_METHOD(SpirvExtInst)
-  DEFINE_VISIT_METHOD(SpirvFunctionCall)
-  DEFINE_VISIT_METHOD(SpirvNonUniformBinaryOp)
-  DEFINE_VISIT_METHOD(SpirvNonUniformElect)
-  DEFINE_VISIT_METHOD(SpirvNonUniformUnaryOp)
-  DEFINE_VISIT_METHOD(SpirvImageOp)
-  DEFINE_VISIT_METHOD(SpirvImageQuery)
-  DEFINE_VISIT_METHOD(SpirvImageSparseTexelsResident)
-  DEFINE_VISIT_METHOD(SpirvImageTexelPointer)
-  DEFINE_VISIT_METHOD(SpirvLoad)
-  DEFINE_VISIT_METHOD(SpirvCopyObject)
-  DEFINE_VISIT_METHOD(SpirvSampledImage)
-  DEFINE_VISIT_METHOD(SpirvSelect)
-  DEFINE_VISIT_METHOD(SpirvSpecConstantBinaryOp)
-  DEFINE_VISIT_METHOD(SpirvSpecConstantUnaryOp)
-  DEFINE_VISIT_METHOD(SpirvStore)
-  DEFINE_VISIT_METHOD(SpirvUnaryOp)
-  DEFINE_VISIT_METHOD(SpirvVectorShuffle)
-  DEFINE_VISIT_METHOD(SpirvArrayLength)
-  DEFINE_VISIT_METHOD(SpirvRayTracingOpNV)
-  DEFINE_VISIT_METHOD(SpirvDemoteToHelperInvocationEXT)
-  DEFINE_VISIT_METHOD(SpirvDebugInfoNone)
-  DEFINE_VISIT_METHOD(SpirvDebugSource)
-  DEFINE_VISIT_METHOD(SpirvDebugCompilationUnit)
-  DEFINE_VISIT_METHOD(SpirvDebugFunctionDeclaration)
-  DEFINE_VISIT_METHOD(SpirvDebugFunction)
-  DEFINE_VISIT_METHOD(SpirvDebugLocalVariable)
-  DEFINE_VISIT_METHOD(SpirvDebugGlobalVariable)
-  DEFINE_VISIT_METHOD(SpirvDebugOperation)
-  DEFINE_VISIT_METHOD(SpirvDebugExpression)
-  DEFINE_VISIT_METHOD(SpirvDebugDeclare)
-  DEFINE_VISIT_METHOD(SpirvDebugLexicalBlock)
-  DEFINE_VISIT_METHOD(SpirvDebugScope)
-  DEFINE_VISIT_METHOD(SpirvDebugTypeBasic)
-  DEFINE_VISIT_METHOD(SpirvDebugTypeArray)
-  DEFINE_VISIT_METHOD(SpirvDebugTypeVector)
-  DEFINE_VISIT_METHOD(SpirvDebugTypeFunction)
-  DEFINE_VISIT_METHOD(SpirvDebugTypeComposite)
-  DEFINE_VISIT_METHOD(SpirvDebugTypeMember)
-  DEFINE_VISIT_METHOD(SpirvDebugTypeTemplate)
-  DEFINE_VISIT_METHOD(SpirvDebugTypeTemplateParameter)
-
-  DEFINE_VISIT_METHOD(SpirvRayQueryOpKHR)
-  DEFINE_VISIT_METHOD(SpirvReadClock)
-  DEFINE_VISIT_METHOD(SpirvRayTracingTerminateOpKHR)
-#undef DEFINE_VISIT_METHOD
+#include "clang/SPIRV/SpirvVisitor.def"
 
 protected:
   explicit Visitor(const SpirvCodeGenOptions &opts, SpirvContext &ctx)
@@ -152,6 +69,54 @@ protected:
   SpirvContext &context;
 };
 
+/// \brief A visitor that runs several visitors in one walk over a module.
+///
+/// Every construct is handed to each sub-visitor, in the order given, before
+/// the walk moves on to the next construct. This gives the same result as one
+/// walk per visitor only if no visitor needs a later one to have processed
+/// other constructs first; visitors that depend on the whole module having
+/// been processed by another visitor must keep their own walk.
+///
+/// A sub-visitor that returns false receives no further constructs, as if its
+/// own walk had stopped there. The combined walk stops once all of them have.
+class CompositeVisitor : public Visitor {
+public:
+  CompositeVisitor(const SpirvCodeGenOptions &opts, SpirvContext &ctx,
+                   llvm::ArrayRef<Visitor *> visitors)
+      : Visitor(opts, ctx), visitors(visitors.begin(), visitors.end()) {}
+
+  bool visit(SpirvModule *m, Phase phase) override {
+    return forEachVisitor([=](Visitor *v) { return v->visit(m, phase); });
+  }
+  bool visit(SpirvFunction *fn, Phase phase) override {
+    return forEachVisitor([=](Visitor *v) { return v->visit(fn, phase); });
+  }
+  bool visit(SpirvBasicBlock *bb, Phase phase) override {
+    return forEachVisitor([=](Visitor *v) { return v->visit(bb, phase); });
+  }
+
+#define SPIRV_VISITOR_INSTRUCTION(cls)                                         \
+  bool visit(cls *i) override {                                                \
+    return forEachVisitor([=](Visitor *v) { return v->visit(i); });            \
+  }
+#include "clang/SPIRV/SpirvVisitor.def"
+
+private:
+  /// Calls fn on every sub-visitor that has not stopped yet, dropping those
+  /// for which it returns false. Returns false once none are left.
+  template <typename Fn> bool forEachVisitor(Fn fn) {
+    bool anyActive = false;
+    for (Visitor *&v : visitors) {
+      if (v && !fn(v))
+        v = nullptr;
+      anyActive |= v != nullptr;
+    }
+    return anyActive;
+  }
+
+  llvm::SmallVector<Visitor *, 4> visitors;
+};
+
 } // namespace spirv
 } // namespace clang
 
@@ -34,6 +34,7 @@
 #include "llvm/Pass.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TimeProfiler.h" // HLSL Change
 #include "llvm/Support/Timer.h"
 #include <memory>
 using namespace clang;
@@ -141,6 +142,7 @@ namespace clang {
     void HandleTranslationUnit(ASTContext &C) override {
       {
         PrettyStackTraceString CrashInfo("Per-file LLVM IR generation");
+        llvm::TimeTraceScope TimeScope("CodeGen"); // HLSL Change
         if (llvm::TimePassesIsEnabled)
           LLVMIRGeneration.startTimer();
 
@@ -188,9 +190,12 @@ namespace clang {
       void *OldDiagnosticContext = Ctx.getDiagnosticContext();
       Ctx.setDiagnosticHandler(DiagnosticHandler, this);
 
-      EmitBackendOutput(Diags, CodeGenOpts, TargetOpts, LangOpts,
-                        C.getTargetInfo().getTargetDescription(),
-                        TheModule.get(), Action, AsmOutStream);
+      {
+        llvm::TimeTraceScope TimeScope("Backend"); // HLSL Change
+        EmitBackendOutput(Diags, CodeGenOpts, TargetOpts, LangOpts,
+                          C.getTargetInfo().getTargetDescription(),
+                          TheModule.get(), Action, AsmOutStream);
+      }
 
       Ctx.setInlineAsmDiagnosticHandler(OldHandler, OldContext);
 
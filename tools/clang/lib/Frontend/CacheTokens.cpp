@@ -190,6 +190,7 @@ class PTHWriter {
   CachedStrsTy CachedStrs;
   Offset CurStrOffset;
   std::vector<llvm::StringMapEntry<OffsetOpt>*> StrEntries;
+  bool CacheRelativePaths = false; // HLSL Change
 
   //// Get the persistent id for the given IdentifierInfo*.
   uint32_t ResolveID(const IdentifierInfo* II);
@@ -241,6 +242,7 @@ public:
 
   PTHMap &getPM() { return PM; }
   void GeneratePTH(const std::string &MainFile);
+  void setCacheRelativePaths(bool Value) { CacheRelativePaths = Value; } // HLSL Change
 };
 } // end anonymous namespace
 
@@ -258,9 +260,18 @@ uint32_t PTHWriter::ResolveID(const IdentifierInfo* II) {
 }
 
 void PTHWriter::EmitToken(const Token& T) {
+  // HLSL Change Begin - the kind field is 8 bits wide, and HLSL keywords are
+  // numbered past 255. The reader recomputes the kind of any token that has
+  // identifier info, so record keywords as plain identifiers.
+  tok::TokenKind Kind = T.getKind();
+  if (!T.isLiteral() && T.getIdentifierInfo())
+    Kind = tok::identifier;
+  assert((unsigned)Kind <= 0xFF && "token kind does not fit the PTH format");
+
   // Emit the token kind, flags, and length.
-  Emit32(((uint32_t) T.getKind()) | ((((uint32_t) T.getFlags())) << 8)|
+  Emit32(((uint32_t) Kind) | ((((uint32_t) T.getFlags())) << 8)|
          (((uint32_t) T.getLength()) << 16));
+  // HLSL Change End
 
   if (!T.isLiteral()) {
     Emit32(ResolveID(T.getIdentifierInfo()));
@@ -508,7 +519,8 @@ void PTHWriter::GeneratePTH(const std::string &MainFile) {
     const FileEntry *FE = C.OrigEntry;
 
     // FIXME: Handle files with non-absolute paths.
-    if (llvm::sys::path::is_relative(FE->getName()))
+    if (!CacheRelativePaths && // HLSL Change
+        llvm::sys::path::is_relative(FE->getName()))
       continue;
 
     const llvm::MemoryBuffer *B = C.getBuffer(PP.getDiagnostics(), SM);
@@ -597,6 +609,18 @@ void clang::CacheTokens(Preprocessor &PP, raw_pwrite_stream *OS) {
   PW.GeneratePTH(MainFilePath.str());
 }
 
+// HLSL Change Begin - cache the files of an already preprocessed input.
+void clang::CacheTokensForLoadedFiles(Preprocessor &PP,
+                                      raw_pwrite_stream *OS) {
+  // File names are kept as the preprocessor saw them, so the result is only
+  // meaningful to compiles that resolve names the same way; no 'stat'
+  // information is recorded for them.
+  PTHWriter PW(*OS, PP);
+  PW.setCacheRelativePaths(true);
+  PW.GeneratePTH(std::string());
+}
+// HLSL Change End
+
 //===----------------------------------------------------------------------===//
 
 namespace {
@@ -310,6 +310,17 @@ void CompilerInstance::createPreprocessor(TranslationUnitKind TUKind) {
   PTHManager *PTHMgr = nullptr;
   if (!PPOpts.TokenCache.empty())
     PTHMgr = PTHManager::Create(PPOpts.TokenCache, getDiagnostics());
+  // HLSL Change Begin - in-memory token cache.
+  else if (PPOpts.TokenCacheBuffer) {
+    PTHMgr = PTHManager::Create(
+        llvm::MemoryBuffer::getMemBuffer(
+            PPOpts.TokenCacheBuffer->getMemBufferRef(),
+            /*RequiresNullTerminator*/ false),
+        "<token cache>", getDiagnostics());
+    if (PTHMgr)
+      PTHMgr->setFileFilter(PPOpts.TokenCacheFileFilter);
+  }
+  // HLSL Change End
 
   // Create the Preprocessor.
   std::unique_ptr<HeaderSearch> HeaderInfo ( // HLSL Change - make unique_ptr and free
@@ -329,7 +340,7 @@ void CompilerInstance::createPreprocessor(TranslationUnitKind TUKind) {
   // IdentifierTable's ctor.
   if (PTHMgr) {
     PTHMgr->setPreprocessor(&*PP);
-    PP->setPTHManager(PTHMgr);
+    PP->setPTHManager(PTHMgr, /*UseStatCache*/ !PPOpts.TokenCache.empty()); // HLSL Change
   }
 
   if (PPOpts.DetailedRecord)
@@ -441,8 +441,12 @@ PTHManager *PTHManager::Create(StringRef file, DiagnosticsEngine &Diags) {
     Diags.Report(diag::err_invalid_pth_file) << file;
     return nullptr;
   }
-  std::unique_ptr<llvm::MemoryBuffer> File = std::move(FileOrErr.get());
+  return Create(std::move(FileOrErr.get()), file, Diags); // HLSL Change
+}
 
+// HLSL Change - split from the file-based Create above.
+PTHManager *PTHManager::Create(std::unique_ptr<llvm::MemoryBuffer> File,
+                               StringRef file, DiagnosticsEngine &Diags) {
   using namespace llvm::support;
 
   // Get the buffer ranges and check if there are at least three 32-bit
@@ -607,6 +611,12 @@ PTHLexer *PTHManager::CreateLexer(FileID FID) {
   if (I == FileLookup->end()) // No tokens available?
     return nullptr;
 
+  // HLSL Change Begin - let the owner reject tokens for changed files.
+  if (FileFilter &&
+      !FileFilter(FE, PP->getSourceManager().getBuffer(FID)))
+    return nullptr;
+  // HLSL Change End
+
   const PTHFileData& FileData = *I;
 
   const unsigned char *BufStart = (const unsigned char *)Buf->getBufferStart();
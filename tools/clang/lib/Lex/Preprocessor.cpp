@@ -198,9 +198,10 @@ void Preprocessor::FinalizeForModelFile() {
   PragmaHandlers = std::move(PragmaHandlersBackup);
 }
 
-void Preprocessor::setPTHManager(PTHManager* pm) {
+void Preprocessor::setPTHManager(PTHManager* pm, bool UseStatCache) { // HLSL Change - UseStatCache
   PTH.reset(pm);
-  FileMgr.addStatCache(PTH->createStatCache());
+  if (UseStatCache) // HLSL Change
+    FileMgr.addStatCache(PTH->createStatCache());
 }
 
 void Preprocessor::DumpToken(const Token &Tok, bool DumpFlags) const {
@@ -23,7 +23,9 @@
 #include "clang/Sema/Sema.h"
 #include "clang/Sema/SemaConsumer.h"
 #include "clang/Sema/SemaHLSL.h" // HLSL Change
+#include "llvm/ADT/Optional.h" // HLSL Change
 #include "llvm/Support/CrashRecoveryContext.h"
+#include "llvm/Support/TimeProfiler.h" // HLSL Change
 #include <cstdio>
 #include <memory>
 
@@ -132,6 +134,9 @@ void clang::ParseAST(Sema &S, bool PrintStats, bool SkipFunctionBodies) {
   if (External)
     External->StartTranslationUnit(Consumer);
 
+  llvm::Optional<llvm::TimeTraceScope> FrontendTimeScope; // HLSL Change
+  FrontendTimeScope.emplace("Frontend");                  // HLSL Change
+
   if (!S.getDiagnostics().hasUnrecoverableErrorOccurred()) {  // HLSL Change: Skip if fatal error already occurred
     if (P.ParseTopLevelDecl(ADecl)) {
       if (!External && !S.getLangOpts().CPlusPlus)
@@ -156,6 +161,7 @@ void clang::ParseAST(Sema &S, bool PrintStats, bool SkipFunctionBodies) {
   // errors in the front-end, without relying on code generation being
   // available.
   hlsl::DiagnoseTranslationUnit(&S);
+  FrontendTimeScope.reset();
   // HLSL Change Ends
   Consumer->HandleTranslationUnit(S.getASTContext());
 
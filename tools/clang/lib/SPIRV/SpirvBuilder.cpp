@@ -1243,11 +1243,13 @@ std::vector<uint32_t> SpirvBuilder::takeModule() {
 
   mod->invokeVisitor(&literalTypeVisitor, true);
 
-  // Propagate NonUniform decorations
-  mod->invokeVisitor(&nonUniformVisitor);
+  // Visitors that do not depend on each other's effects on other constructs
+  // share one walk over the module; see CompositeVisitor.
 
-  // Lower types
-  mod->invokeVisitor(&lowerTypeVisitor);
+  // Propagate NonUniform decorations and lower types
+  CompositeVisitor lowerTypePass(spirvOptions, context,
+                                 {&nonUniformVisitor, &lowerTypeVisitor});
+  mod->invokeVisitor(&lowerTypePass);
 
   // Generate debug types (if needed)
   if (spirvOptions.debugInfoRich) {
@@ -1258,19 +1260,18 @@ std::vector<uint32_t> SpirvBuilder::takeModule() {
     mod->invokeVisitor(&sortDebugInfoVisitor);
   }
 
-  // Add necessary capabilities and extensions
-  mod->invokeVisitor(&capabilityVisitor);
+  // Add necessary capabilities and extensions, propagate RelaxedPrecision
+  // decorations, and remove the BufferBlock decoration if necessary (this
+  // decoration is deprecated after SPIR-V 1.3). These need all types lowered.
+  CompositeVisitor decorationPass(spirvOptions, context,
+                                  {&capabilityVisitor, &relaxedPrecisionVisitor,
+                                   &removeBufferBlockVisitor});
+  mod->invokeVisitor(&decorationPass);
 
-  // Propagate RelaxedPrecision decorations
-  mod->invokeVisitor(&relaxedPrecisionVisitor);
-
-  // Propagate NoContraction decorations
+  // Propagate NoContraction decorations. This walks the module backwards, so
+  // it cannot share a walk with the visitors above.
   mod->invokeVisitor(&preciseVisitor, true);
 
-  // Remove BufferBlock decoration if necessary (this decoration is deprecated
-  // after SPIR-V 1.3).
-  mod->invokeVisitor(&removeBufferBlockVisitor);
-
   // Emit SPIR-V
   mod->invokeVisitor(&emitVisitor);
 
@@ -16,10 +16,17 @@
 #include "AlignmentSizeCalculator.h"
 #include "RawBufferMethods.h"
 #include "dxc/HlslIntrinsicOp.h"
+#include "dxc/Support/Global.h"
+#include "dxc/Support/WorkerThreads.h"
+#include "spirv-tools/linker.hpp"
 #include "spirv-tools/optimizer.hpp"
 #include "clang/SPIRV/AstTypeProbe.h"
 #include "clang/Sema/Sema.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/TimeProfiler.h"
+
+#include <algorithm>
+#include <memory>
 
 #include "InitListHandler.h"
 #include "dxc/DXIL/DxilConstants.h"
@@ -442,6 +449,61 @@ bool isMemoryObjectDeclaration(SpirvInstruction *inst) {
   return isa<SpirvVariable>(inst) || isa<SpirvFunctionParameter>(inst);
 }
 
+/// Splits the SPIR-V binary |module| into one module per OpEntryPoint, each
+/// keeping only that entry point and its execution modes; the optimizer then
+/// removes whatever the entry point does not use. Returns false, leaving
+/// |entryModules| untouched, if there are fewer than two entry points or the
+/// module uses the Linkage capability.
+bool splitModuleByEntryPoint(const std::vector<uint32_t> &module,
+                             std::vector<std::vector<uint32_t>> *entryModules) {
+  const size_t kHeaderWordCount = 5;
+  if (module.size() < kHeaderWordCount)
+    return false;
+
+  std::vector<size_t> entryPoints;
+  for (size_t i = kHeaderWordCount; i < module.size();) {
+    const uint32_t wordCount = module[i] >> 16;
+    const auto opcode = static_cast<spv::Op>(module[i] & 0xffff);
+    if (wordCount == 0 || i + wordCount > module.size())
+      return false;
+    if (opcode == spv::Op::OpCapability && wordCount == 2 &&
+        static_cast<spv::Capability>(module[i + 1]) ==
+            spv::Capability::Linkage)
+      return false;
+    if (opcode == spv::Op::OpEntryPoint)
+      entryPoints.push_back(i);
+    // Entry points and execution modes come before any function.
+    if (opcode == spv::Op::OpFunction)
+      break;
+    i += wordCount;
+  }
+  if (entryPoints.size() < 2)
+    return false;
+
+  for (size_t entryPoint : entryPoints) {
+    const uint32_t entryFunction = module[entryPoint + 2];
+    std::vector<uint32_t> entryModule(module.begin(),
+                                      module.begin() + kHeaderWordCount);
+    entryModule.reserve(module.size());
+    for (size_t i = kHeaderWordCount; i < module.size();) {
+      const uint32_t wordCount = module[i] >> 16;
+      const auto opcode = static_cast<spv::Op>(module[i] & 0xffff);
+      bool keep = true;
+      if (opcode == spv::Op::OpEntryPoint)
+        keep = i == entryPoint;
+      else if (opcode == spv::Op::OpExecutionMode ||
+               opcode == spv::Op::OpExecutionModeId)
+        keep = module[i + 1] == entryFunction;
+      if (keep)
+        entryModule.insert(entryModule.end(), module.begin() + i,
+                           module.begin() + i + wordCount);
+      i += wordCount;
+    }
+    entryModules->push_back(std::move(entryModule));
+  }
+  return true;
+}
+
 } // namespace
 
 SpirvEmitter::SpirvEmitter(CompilerInstance &ci)
@@ -594,12 +656,15 @@ void SpirvEmitter::HandleTranslationUnit(ASTContext &context) {
   // Translate all functions reachable from the entry function.
   // The queue can grow in the meanwhile; so need to keep evaluating
   // workQueue.size().
-  for (uint32_t i = 0; i < workQueue.size(); ++i) {
-    const FunctionInfo *curEntryOrCallee = workQueue[i];
-    spvContext.setCurrentShaderModelKind(curEntryOrCallee->shaderModelKind);
-    doDecl(curEntryOrCallee->funcDecl);
-    if (context.getDiagnostics().hasErrorOccurred())
-      return;
+  {
+    llvm::TimeTraceScope TimeScope("SpirvLowering");
+    for (uint32_t i = 0; i < workQueue.size(); ++i) {
+      const FunctionInfo *curEntryOrCallee = workQueue[i];
+      spvContext.setCurrentShaderModelKind(curEntryOrCallee->shaderModelKind);
+      doDecl(curEntryOrCallee->funcDecl);
+      if (context.getDiagnostics().hasErrorOccurred())
+        return;
+    }
   }
 
   // Addressing and memory model are required in a valid SPIR-V module.
@@ -636,7 +701,11 @@ void SpirvEmitter::HandleTranslationUnit(ASTContext &context) {
     return;
 
   // Output the constructed module.
-  std::vector<uint32_t> m = spvBuilder.takeModule();
+  std::vector<uint32_t> m;
+  {
+    llvm::TimeTraceScope TimeScope("SpirvEmit");
+    m = spvBuilder.takeModule();
+  }
 
   if (!spirvOptions.codeGenHighLevel) {
     // In order to flatten composite resources, we must also unroll loops.
@@ -645,38 +714,19 @@ void SpirvEmitter::HandleTranslationUnit(ASTContext &context) {
                         declIdMapper.requiresLegalization() ||
                         spirvOptions.flattenResourceArrays ||
                         declIdMapper.requiresFlatteningCompositeResources();
+    const bool needsOptimization =
+        theCompilerInstance.getCodeGenOpts().OptimizationLevel > 0;
 
-    // Run legalization passes
-    if (needsLegalization) {
-      std::string messages;
-      if (!spirvToolsLegalize(&m, &messages)) {
-        emitFatalError("failed to legalize SPIR-V: %0", {}) << messages;
-        emitNote("please file a bug report on "
-                 "https://github.com/Microsoft/DirectXShaderCompiler/issues "
-                 "with source code if possible",
-                 {});
-        return;
-      } else if (!messages.empty()) {
-        emitWarning("SPIR-V legalization: %0", {}) << messages;
-      }
-    }
-
-    // Run optimization passes
-    if (theCompilerInstance.getCodeGenOpts().OptimizationLevel > 0) {
-      std::string messages;
-      if (!spirvToolsOptimize(&m, &messages)) {
-        emitFatalError("failed to optimize SPIR-V: %0", {}) << messages;
-        emitNote("please file a bug report on "
-                 "https://github.com/Microsoft/DirectXShaderCompiler/issues "
-                 "with source code if possible",
-                 {});
-        return;
-      }
-    }
+    // Run legalization and optimization passes
+    if ((needsLegalization || needsOptimization) &&
+        !spirvToolsLegalizeAndOptimize(&m, needsLegalization,
+                                       needsOptimization))
+      return;
   }
 
   // Validate the generated SPIR-V code
   if (!spirvOptions.disableValidation) {
+    llvm::TimeTraceScope TimeScope("SpirvValidation");
     std::string messages;
     if (!spirvToolsValidate(&m, &messages)) {
       emitFatalError("generated SPIR-V is invalid: %0", {}) << messages;
@@ -12272,60 +12322,142 @@ bool SpirvEmitter::spirvToolsValidate(std::vector<uint32_t> *mod,
   return tools.Validate(mod->data(), mod->size(), options);
 }
 
-bool SpirvEmitter::spirvToolsOptimize(std::vector<uint32_t> *mod,
-                                      std::string *messages) {
-  spvtools::Optimizer optimizer(featureManager.getTargetEnv());
-
-  optimizer.SetMessageConsumer(
-      [messages](spv_message_level_t /*level*/, const char * /*source*/,
-                 const spv_position_t & /*position*/,
-                 const char *message) { *messages += message; });
-
-  spvtools::OptimizerOptions options;
-  options.set_run_validator(false);
+void SpirvEmitter::spirvToolsRegisterLegalizationPasses(
+    spvtools::Optimizer *optimizer) {
+  optimizer->RegisterLegalizationPasses();
+  // Add flattening of resources if needed.
+  if (spirvOptions.flattenResourceArrays ||
+      declIdMapper.requiresFlatteningCompositeResources()) {
+    optimizer->RegisterPass(spvtools::CreateDescriptorScalarReplacementPass());
+    // ADCE should be run after desc_sroa in order to remove potentially
+    // illegal types such as structures containing opaque types.
+    optimizer->RegisterPass(spvtools::CreateAggressiveDCEPass());
+  }
+  optimizer->RegisterPass(spvtools::CreateReplaceInvalidOpcodePass());
+  optimizer->RegisterPass(spvtools::CreateCompactIdsPass());
+}
 
+bool SpirvEmitter::spirvToolsRegisterOptimizationPasses(
+    spvtools::Optimizer *optimizer) {
   if (spirvOptions.optConfig.empty()) {
     // Add performance passes.
-    optimizer.RegisterPerformancePasses();
+    optimizer->RegisterPerformancePasses();
 
     // Add compact ID pass.
-    optimizer.RegisterPass(spvtools::CreateCompactIdsPass());
-  } else {
-    // Command line options use llvm::SmallVector and llvm::StringRef, whereas
-    // SPIR-V optimizer uses std::vector and std::string.
-    std::vector<std::string> stdFlags;
-    for (const auto &f : spirvOptions.optConfig)
-      stdFlags.push_back(f.str());
-    if (!optimizer.RegisterPassesFromFlags(stdFlags))
-      return false;
+    optimizer->RegisterPass(spvtools::CreateCompactIdsPass());
+    return true;
   }
 
-  return optimizer.Run(mod->data(), mod->size(), mod, options);
-}
-
-bool SpirvEmitter::spirvToolsLegalize(std::vector<uint32_t> *mod,
-                                      std::string *messages) {
-  spvtools::Optimizer optimizer(featureManager.getTargetEnv());
-  optimizer.SetMessageConsumer(
-      [messages](spv_message_level_t /*level*/, const char * /*source*/,
-                 const spv_position_t & /*position*/,
-                 const char *message) { *messages += message; });
+  // Command line options use llvm::SmallVector and llvm::StringRef, whereas
+  // SPIR-V optimizer uses std::vector and std::string.
+  std::vector<std::string> stdFlags;
+  for (const auto &f : spirvOptions.optConfig)
+    stdFlags.push_back(f.str());
+  return optimizer->RegisterPassesFromFlags(stdFlags);
+}
+
+bool SpirvEmitter::spirvToolsLegalizeAndOptimize(std::vector<uint32_t> *mod,
+                                                 bool legalize,
+                                                 bool optimize) {
+  llvm::TimeTraceScope TimeScope("SpirvOptimizer");
+
+  // With -fspv-parallel-entry-points, each entry point of a library is
+  // processed in its own copy of the module, all at once, and the results are
+  // linked back together in entry point order.
+  std::vector<std::vector<uint32_t>> modules;
+  if (!spirvOptions.parallelEntryPoints || !spvContext.isLib() ||
+      !splitModuleByEntryPoint(*mod, &modules))
+    modules.push_back(std::move(*mod));
+
+  // A single optimizer runs both sets of passes, so each module is parsed
+  // into one IR context and serialized back once, rather than once per set.
+  std::vector<std::string> messages(modules.size());
+  std::vector<std::unique_ptr<spvtools::Optimizer>> optimizers;
+  bool validConfig = true;
+  for (size_t i = 0; i < modules.size() && validConfig; ++i) {
+    optimizers.emplace_back(
+        new spvtools::Optimizer(featureManager.getTargetEnv()));
+    std::string *moduleMessages = &messages[i];
+    optimizers.back()->SetMessageConsumer(
+        [moduleMessages](spv_message_level_t /*level*/,
+                         const char * /*source*/,
+                         const spv_position_t & /*position*/,
+                         const char *message) { *moduleMessages += message; });
+
+    if (legalize)
+      spirvToolsRegisterLegalizationPasses(optimizers.back().get());
+    // An invalid -Oconfig fails before any pass runs.
+    validConfig = !optimize ||
+                  spirvToolsRegisterOptimizationPasses(optimizers.back().get());
+  }
+
+  bool success = validConfig;
+  if (validConfig) {
+    std::vector<char> succeeded(modules.size(), false);
+    // Worker threads allocate with the caller's allocator.
+    hlsl::RunOnWorkerThreads(
+        modules.size(), 0, DxcGetThreadMallocNoRef(), [&](size_t i, unsigned) {
+          spvtools::OptimizerOptions options;
+          options.set_run_validator(false);
+          std::vector<uint32_t> &module = modules[i];
+          succeeded[i] = optimizers[i]->Run(module.data(), module.size(),
+                                            &module, options);
+        });
+    success = std::find(succeeded.begin(), succeeded.end(), false) ==
+              succeeded.end();
+  }
+
+  // Messages are reported in entry point order, whichever finished first.
+  std::string allMessages;
+  for (const std::string &moduleMessages : messages)
+    allMessages += moduleMessages;
+
+  if (!success) {
+    if (!optimize)
+      emitFatalError("failed to legalize SPIR-V: %0", {}) << allMessages;
+    else if (!legalize || !validConfig)
+      emitFatalError("failed to optimize SPIR-V: %0", {}) << allMessages;
+    else
+      emitFatalError("failed to legalize and optimize SPIR-V: %0", {})
+          << allMessages;
+    emitNote("please file a bug report on "
+             "https://github.com/Microsoft/DirectXShaderCompiler/issues "
+             "with source code if possible",
+             {});
+    return false;
+  }
 
-  spvtools::OptimizerOptions options;
-  options.set_run_validator(false);
-  optimizer.RegisterLegalizationPasses();
-  // Add flattening of resources if needed.
-  if (spirvOptions.flattenResourceArrays ||
-      declIdMapper.requiresFlatteningCompositeResources()) {
-    optimizer.RegisterPass(spvtools::CreateDescriptorScalarReplacementPass());
-    // ADCE should be run after desc_sroa in order to remove potentially
-    // illegal types such as structures containing opaque types.
-    optimizer.RegisterPass(spvtools::CreateAggressiveDCEPass());
+  if (modules.size() == 1) {
+    *mod = std::move(modules.front());
+  } else {
+    std::string linkMessages;
+    spvtools::Context linkContext(featureManager.getTargetEnv());
+    linkContext.SetMessageConsumer(
+        [&linkMessages](spv_message_level_t /*level*/, const char * /*source*/,
+                        const spv_position_t & /*position*/,
+                        const char *message) { linkMessages += message; });
+    if (spvtools::Link(linkContext, modules, mod) != SPV_SUCCESS) {
+      emitFatalError("failed to link SPIR-V entry points: %0", {})
+          << linkMessages;
+      emitNote("please file a bug report on "
+               "https://github.com/Microsoft/DirectXShaderCompiler/issues "
+               "with source code if possible",
+               {});
+      return false;
+    }
   }
-  optimizer.RegisterPass(spvtools::CreateReplaceInvalidOpcodePass());
-  optimizer.RegisterPass(spvtools::CreateCompactIdsPass());
 
-  return optimizer.Run(mod->data(), mod->size(), mod, options);
+  // Messages from a successful run are warnings. Optimization on its own
+  // has never reported them; when it ran with legalization, the messages of
+  // the two cannot be told apart, so the warning names both.
+  if (legalize && !allMessages.empty()) {
+    if (optimize)
+      emitWarning("SPIR-V legalization and optimization: %0", {})
+          << allMessages;
+    else
+      emitWarning("SPIR-V legalization: %0", {}) << allMessages;
+  }
+  return true;
 }
 
 SpirvInstruction *
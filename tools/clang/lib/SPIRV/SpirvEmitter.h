@@ -35,6 +35,10 @@
 
 #include "DeclResultIdMapper.h"
 
+namespace spvtools {
+class Optimizer;
+} // namespace spvtools
+
 namespace clang {
 namespace spirv {
 
@@ -1011,17 +1015,22 @@ private:
                               const clang::FunctionDecl *,
                               bool isEntryFunction);
 
-  /// \brief Helper function to run SPIRV-Tools optimizer's performance passes.
-  /// Runs the SPIRV-Tools optimizer on the given SPIR-V module |mod|, and
-  /// gets the info/warning/error messages via |messages|.
+  /// \brief Helper function to run the SPIRV-Tools optimizer's legalization
+  /// passes (if |legalize|) followed by its performance passes, or the passes
+  /// given by -Oconfig (if |optimize|), on the given SPIR-V module |mod|.
+  /// With -fspv-parallel-entry-points, libraries are split into one module
+  /// per entry point, processed concurrently and linked back together.
+  /// Reports errors and legalization warnings to the diagnostic engine.
   /// Returns true on success and false otherwise.
-  bool spirvToolsOptimize(std::vector<uint32_t> *mod, std::string *messages);
+  bool spirvToolsLegalizeAndOptimize(std::vector<uint32_t> *mod, bool legalize,
+                                     bool optimize);
 
-  /// \brief Helper function to run SPIRV-Tools optimizer's legalization passes.
-  /// Runs the SPIRV-Tools legalization on the given SPIR-V module |mod|, and
-  /// gets the info/warning/error messages via |messages|.
-  /// Returns true on success and false otherwise.
-  bool spirvToolsLegalize(std::vector<uint32_t> *mod, std::string *messages);
+  /// \brief Registers the legalization passes with |optimizer|.
+  void spirvToolsRegisterLegalizationPasses(spvtools::Optimizer *optimizer);
+
+  /// \brief Registers the performance passes, or the passes given by
+  /// -Oconfig, with |optimizer|. Returns false if -Oconfig is invalid.
+  bool spirvToolsRegisterOptimizationPasses(spvtools::Optimizer *optimizer);
 
   /// \brief Helper function to run the SPIRV-Tools validator.
   /// Runs the SPIRV-Tools validator on the given SPIR-V module |mod|, and
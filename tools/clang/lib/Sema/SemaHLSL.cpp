@@ -12,6 +12,7 @@
 
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/Attr.h"
 #include "clang/AST/DeclCXX.h"
@@ -2241,6 +2242,17 @@ class UsedIntrinsicStore : public std::set<UsedIntrinsic>
 {
 };
 
+/// <summary>Returns the generated name index for a built-in intrinsic table, or null for other tables.</summary>
+static
+const HLSL_INTRINSIC_NAME_INDEX* GetIntrinsicNameIndex(_In_opt_ const HLSL_INTRINSIC* table)
+{
+  for (const HLSL_INTRINSIC_NAME_INDEX &index : g_IntrinsicNameIndexes) {
+    if (index.pTable == table)
+      return &index;
+  }
+  return nullptr;
+}
+
 static
 void GetIntrinsicMethods(ArBasicKind kind, _Outptr_result_buffer_(*intrinsicCount) const HLSL_INTRINSIC** intrinsics, _Out_ size_t* intrinsicCount)
 {
@@ -3045,10 +3057,17 @@ private:
   TypedefDecl* m_hlslStringTypedef;
 
   // Built-in object types declarations, indexed by basic kind constant.
+  // Created on first use; see GetOrCreateObjectTypeDecl.
   CXXRecordDecl* m_objectTypeDecls[_countof(g_ArBasicKindsAsTypes)];
+  // Deprecated effect object declarations, indexed like g_DeprecatedEffectObjectNames.
+  CXXRecordDecl* m_effectObjectDecls[_countof(g_DeprecatedEffectObjectNames)];
+  // 'sampler' alias for SamplerState.
+  TypedefDecl* m_samplerTypedef;
   // Map from object decl to the object index.
-  using ObjectTypeDeclMapType = std::array<std::pair<CXXRecordDecl*,unsigned>, _countof(g_ArBasicKindsAsTypes)+_countof(g_DeprecatedEffectObjectNames)>;
-  ObjectTypeDeclMapType m_objectTypeDeclsMap;
+  llvm::DenseMap<const CXXRecordDecl*, unsigned> m_objectTypeDeclsMap;
+  // Map from the name of a built-in object type, alias or global to the
+  // index it is created by, so lookups can fault it in.
+  llvm::StringMap<unsigned> m_objectTypeNames;
   // Mask for object which not has methods created.
   uint64_t m_objectTypeLazyInitMask;
 
@@ -3418,22 +3437,11 @@ private:
     }
   }
 
-  static bool ObjectTypeDeclMapTypeCmp(const std::pair<CXXRecordDecl*,unsigned> &a,
-                           const std::pair<CXXRecordDecl*,unsigned> &b) {
-    return a.first < b.first;
-  };
-
   int FindObjectBasicKindIndex(const CXXRecordDecl* recordDecl) {
-    auto begin = m_objectTypeDeclsMap.begin();
-    auto end = m_objectTypeDeclsMap.end();
-    auto val = std::make_pair(const_cast<CXXRecordDecl*>(recordDecl), 0);
-    auto low = std::lower_bound(begin, end, val, ObjectTypeDeclMapTypeCmp);
-    if (low == end)
-      return -1;
-    if (recordDecl == low->first)
-      return low->second;
-    else
+    auto it = m_objectTypeDeclsMap.find(recordDecl);
+    if (it == m_objectTypeDeclsMap.end())
       return -1;
+    return it->second;
   }
 
 
@@ -3494,128 +3502,192 @@ private:
   }
 #endif // ENABLE_SPIRV_CODEGEN
 
-  // Adds all built-in HLSL object types.
+  // Values in m_objectTypeNames past the object type indices.
+  static const unsigned SamplerAliasNameIndex = _countof(g_ArBasicKindsAsTypes);
+  static const unsigned EffectObjectNameIndexBase = SamplerAliasNameIndex + 1;
+
+  // Registers the names of all built-in HLSL object types. The declarations
+  // are created on first use, so a shader only pays for the types it names.
   void AddObjectTypes()
   {
     DXASSERT(m_context != nullptr, "otherwise caller hasn't initialized context yet");
 
-    QualType float4Type = LookupVectorType(HLSLScalarType_float, 4);
-    TypeSourceInfo *float4TypeSourceInfo = m_context->getTrivialTypeSourceInfo(float4Type, NoLoc);
     m_objectTypeLazyInitMask = 0;
-    unsigned effectKindIndex = 0;
     for (unsigned i = 0; i < _countof(g_ArBasicKindsAsTypes); i++)
     {
       ArBasicKind kind = g_ArBasicKindsAsTypes[i];
-      if (kind == AR_OBJECT_WAVE) { // wave objects are currently unused
-        continue;
-      }
-      if (kind == AR_OBJECT_LEGACY_EFFECT)
-        effectKindIndex = i;
-
       DXASSERT(kind < _countof(g_ArBasicTypeNames), "g_ArBasicTypeNames has the wrong number of entries");
       _Analysis_assume_(kind < _countof(g_ArBasicTypeNames));
-      const char* typeName = g_ArBasicTypeNames[kind];
-      uint8_t templateArgCount = g_ArBasicKindsTemplateCount[i];
-      CXXRecordDecl* recordDecl = nullptr;
-      if (kind == AR_OBJECT_RAY_DESC) {
-        QualType float3Ty = LookupVectorType(HLSLScalarType::HLSLScalarType_float, 3);
-        recordDecl = CreateRayDescStruct(*m_context, float3Ty);
-      } else if (kind == AR_OBJECT_TRIANGLE_INTERSECTION_ATTRIBUTES) {
-        QualType float2Type = LookupVectorType(HLSLScalarType::HLSLScalarType_float, 2);
-        recordDecl = AddBuiltInTriangleIntersectionAttributes(*m_context, float2Type);
-      } else if (IsSubobjectBasicKind(kind)) {
-        switch (kind) {
-        case AR_OBJECT_STATE_OBJECT_CONFIG:
-          recordDecl = CreateSubobjectStateObjectConfig(*m_context);
-          break;
-        case AR_OBJECT_GLOBAL_ROOT_SIGNATURE:
-          recordDecl = CreateSubobjectRootSignature(*m_context, true);
-          break;
-        case AR_OBJECT_LOCAL_ROOT_SIGNATURE:
-          recordDecl = CreateSubobjectRootSignature(*m_context, false);
-          break;
-        case AR_OBJECT_SUBOBJECT_TO_EXPORTS_ASSOC:
-          recordDecl = CreateSubobjectSubobjectToExportsAssoc(*m_context);
-          break;
-        case AR_OBJECT_RAYTRACING_SHADER_CONFIG:
-          recordDecl = CreateSubobjectRaytracingShaderConfig(*m_context);
-          break;
-        case AR_OBJECT_RAYTRACING_PIPELINE_CONFIG:
-          recordDecl = CreateSubobjectRaytracingPipelineConfig(*m_context);
-          break;
-        case AR_OBJECT_TRIANGLE_HIT_GROUP:
-          recordDecl = CreateSubobjectTriangleHitGroup(*m_context);
-          break;
-        case AR_OBJECT_PROCEDURAL_PRIMITIVE_HIT_GROUP:
-          recordDecl = CreateSubobjectProceduralPrimitiveHitGroup(*m_context);
-          break;
-        case AR_OBJECT_RAYTRACING_PIPELINE_CONFIG1:
-          recordDecl = CreateSubobjectRaytracingPipelineConfig1(*m_context);
-          break;
-        }
-      } else if (kind == AR_OBJECT_CONSTANT_BUFFER) {
-        recordDecl = DeclareConstantBufferViewType(*m_context, /*bTBuf*/false);
-      } else if (kind == AR_OBJECT_TEXTURE_BUFFER) {
-        recordDecl = DeclareConstantBufferViewType(*m_context, /*bTBuf*/true);
-      } else if (kind == AR_OBJECT_RAY_QUERY) {
-        recordDecl = DeclareRayQueryType(*m_context);
-      } else if (kind == AR_OBJECT_HEAP_RESOURCE) {
-        recordDecl = DeclareResourceType(*m_context, /*bSampler*/false);
-        // create Resource ResourceDescriptorHeap;
-        DeclareBuiltinGlobal("ResourceDescriptorHeap",
-                             m_context->getRecordType(recordDecl), *m_context);
-      } else if (kind == AR_OBJECT_HEAP_SAMPLER) {
-        recordDecl = DeclareResourceType(*m_context, /*bSampler*/true);
-        // create Resource SamplerDescriptorHeap;
-        DeclareBuiltinGlobal("SamplerDescriptorHeap",
-                             m_context->getRecordType(recordDecl), *m_context);
-
-      }
-      else if (kind == AR_OBJECT_FEEDBACKTEXTURE2D) {
-        recordDecl = DeclareUIntTemplatedTypeWithHandle(*m_context, "FeedbackTexture2D", "kind");
+      if (kind == AR_OBJECT_WAVE || // wave objects are currently unused
+          kind == AR_OBJECT_LEGACY_EFFECT) { // only named through the aliases below
+        continue;
       }
-      else if (kind == AR_OBJECT_FEEDBACKTEXTURE2D_ARRAY) {
-        recordDecl = DeclareUIntTemplatedTypeWithHandle(*m_context, "FeedbackTexture2DArray", "kind");
+      if (kind == AR_OBJECT_HEAP_RESOURCE) {
+        m_objectTypeNames["ResourceDescriptorHeap"] = i;
+      } else if (kind == AR_OBJECT_HEAP_SAMPLER) {
+        m_objectTypeNames["SamplerDescriptorHeap"] = i;
+      } else {
+        m_objectTypeNames[g_ArBasicTypeNames[kind]] = i;
       }
-      else if (templateArgCount == 0) {
-        recordDecl = DeclareRecordTypeWithHandle(*m_context, typeName);
+    }
+
+    // 'sampler' is a very commonly used alias for SamplerState.
+    m_objectTypeNames["sampler"] = SamplerAliasNameIndex;
+    for (unsigned i = 0; i < _countof(g_DeprecatedEffectObjectNames); i++) {
+      m_objectTypeNames[g_DeprecatedEffectObjectNames[i]] = EffectObjectNameIndexBase + i;
+    }
+  }
+
+  // Returns the declaration of the built-in object type at index i of
+  // g_ArBasicKindsAsTypes, creating it along with its intrinsic table methods
+  // if this is its first use.
+  CXXRecordDecl* GetOrCreateObjectTypeDecl(unsigned i)
+  {
+    DXASSERT_NOMSG(i < _countof(g_ArBasicKindsAsTypes));
+    if (m_objectTypeDecls[i] != nullptr)
+      return m_objectTypeDecls[i];
+
+    ArBasicKind kind = g_ArBasicKindsAsTypes[i];
+    if (kind == AR_OBJECT_WAVE) { // wave objects are currently unused
+      return nullptr;
+    }
+
+    const char* typeName = g_ArBasicTypeNames[kind];
+    uint8_t templateArgCount = g_ArBasicKindsTemplateCount[i];
+    CXXRecordDecl* recordDecl = nullptr;
+    if (kind == AR_OBJECT_RAY_DESC) {
+      QualType float3Ty = LookupVectorType(HLSLScalarType::HLSLScalarType_float, 3);
+      recordDecl = CreateRayDescStruct(*m_context, float3Ty);
+    } else if (kind == AR_OBJECT_TRIANGLE_INTERSECTION_ATTRIBUTES) {
+      QualType float2Type = LookupVectorType(HLSLScalarType::HLSLScalarType_float, 2);
+      recordDecl = AddBuiltInTriangleIntersectionAttributes(*m_context, float2Type);
+    } else if (IsSubobjectBasicKind(kind)) {
+      switch (kind) {
+      case AR_OBJECT_STATE_OBJECT_CONFIG:
+        recordDecl = CreateSubobjectStateObjectConfig(*m_context);
+        break;
+      case AR_OBJECT_GLOBAL_ROOT_SIGNATURE:
+        recordDecl = CreateSubobjectRootSignature(*m_context, true);
+        break;
+      case AR_OBJECT_LOCAL_ROOT_SIGNATURE:
+        recordDecl = CreateSubobjectRootSignature(*m_context, false);
+        break;
+      case AR_OBJECT_SUBOBJECT_TO_EXPORTS_ASSOC:
+        recordDecl = CreateSubobjectSubobjectToExportsAssoc(*m_context);
+        break;
+      case AR_OBJECT_RAYTRACING_SHADER_CONFIG:
+        recordDecl = CreateSubobjectRaytracingShaderConfig(*m_context);
+        break;
+      case AR_OBJECT_RAYTRACING_PIPELINE_CONFIG:
+        recordDecl = CreateSubobjectRaytracingPipelineConfig(*m_context);
+        break;
+      case AR_OBJECT_TRIANGLE_HIT_GROUP:
+        recordDecl = CreateSubobjectTriangleHitGroup(*m_context);
+        break;
+      case AR_OBJECT_PROCEDURAL_PRIMITIVE_HIT_GROUP:
+        recordDecl = CreateSubobjectProceduralPrimitiveHitGroup(*m_context);
+        break;
+      case AR_OBJECT_RAYTRACING_PIPELINE_CONFIG1:
+        recordDecl = CreateSubobjectRaytracingPipelineConfig1(*m_context);
+        break;
       }
-      else
-      {
-        DXASSERT(templateArgCount == 1 || templateArgCount == 2, "otherwise a new case has been added");
+    } else if (kind == AR_OBJECT_CONSTANT_BUFFER) {
+      recordDecl = DeclareConstantBufferViewType(*m_context, /*bTBuf*/false);
+    } else if (kind == AR_OBJECT_TEXTURE_BUFFER) {
+      recordDecl = DeclareConstantBufferViewType(*m_context, /*bTBuf*/true);
+    } else if (kind == AR_OBJECT_RAY_QUERY) {
+      recordDecl = DeclareRayQueryType(*m_context);
+    } else if (kind == AR_OBJECT_HEAP_RESOURCE) {
+      recordDecl = DeclareResourceType(*m_context, /*bSampler*/false);
+      // create Resource ResourceDescriptorHeap;
+      DeclareBuiltinGlobal("ResourceDescriptorHeap",
+                           m_context->getRecordType(recordDecl), *m_context);
+    } else if (kind == AR_OBJECT_HEAP_SAMPLER) {
+      recordDecl = DeclareResourceType(*m_context, /*bSampler*/true);
+      // create Resource SamplerDescriptorHeap;
+      DeclareBuiltinGlobal("SamplerDescriptorHeap",
+                           m_context->getRecordType(recordDecl), *m_context);
+
+    }
+    else if (kind == AR_OBJECT_FEEDBACKTEXTURE2D) {
+      recordDecl = DeclareUIntTemplatedTypeWithHandle(*m_context, "FeedbackTexture2D", "kind");
+    }
+    else if (kind == AR_OBJECT_FEEDBACKTEXTURE2D_ARRAY) {
+      recordDecl = DeclareUIntTemplatedTypeWithHandle(*m_context, "FeedbackTexture2DArray", "kind");
+    }
+    else if (templateArgCount == 0) {
+      recordDecl = DeclareRecordTypeWithHandle(*m_context, typeName);
+    }
+    else
+    {
+      DXASSERT(templateArgCount == 1 || templateArgCount == 2, "otherwise a new case has been added");
 
-        TypeSourceInfo* typeDefault = TemplateHasDefaultType(kind) ? float4TypeSourceInfo : nullptr;
-        recordDecl = DeclareTemplateTypeWithHandle(*m_context, typeName, templateArgCount, typeDefault);
+      TypeSourceInfo* typeDefault = nullptr;
+      if (TemplateHasDefaultType(kind)) {
+        QualType float4Type = LookupVectorType(HLSLScalarType_float, 4);
+        typeDefault = m_context->getTrivialTypeSourceInfo(float4Type, NoLoc);
       }
-      m_objectTypeDecls[i] = recordDecl;
-      m_objectTypeDeclsMap[i] = std::make_pair(recordDecl, i);
-      m_objectTypeLazyInitMask |= ((uint64_t)1)<<i;
+      recordDecl = DeclareTemplateTypeWithHandle(*m_context, typeName, templateArgCount, typeDefault);
     }
+    m_objectTypeDecls[i] = recordDecl;
+    m_objectTypeDeclsMap[recordDecl] = i;
+    m_objectTypeLazyInitMask |= ((uint64_t)1)<<i;
 
-    // Create an alias for SamplerState. 'sampler' is very commonly used.
-    {
+    for (auto && intrinsic : m_intrinsicTables) {
+      AddIntrinsicTableMethods(intrinsic, i);
+    }
+    return recordDecl;
+  }
+
+  TypedefDecl* GetSamplerTypedef()
+  {
+    if (m_samplerTypedef == nullptr) {
       DeclContext* currentDeclContext = m_context->getTranslationUnitDecl();
       IdentifierInfo& samplerId = m_context->Idents.get(StringRef("sampler"), tok::TokenKind::identifier);
       TypeSourceInfo* samplerTypeSource = m_context->getTrivialTypeSourceInfo(GetBasicKindType(AR_OBJECT_SAMPLER));
-      TypedefDecl* samplerDecl = TypedefDecl::Create(*m_context, currentDeclContext, NoLoc, NoLoc, &samplerId, samplerTypeSource);
-      currentDeclContext->addDecl(samplerDecl);
-      samplerDecl->setImplicit(true);
+      m_samplerTypedef = TypedefDecl::Create(*m_context, currentDeclContext, NoLoc, NoLoc, &samplerId, samplerTypeSource);
+      currentDeclContext->addDecl(m_samplerTypedef);
+      m_samplerTypedef->setImplicit(true);
+    }
+    return m_samplerTypedef;
+  }
 
-      // Create decls for each deprecated effect object type:
-      unsigned effectObjBase = _countof(g_ArBasicKindsAsTypes);
-      // TypeSourceInfo* effectObjTypeSource = m_context->getTrivialTypeSourceInfo(GetBasicKindType(AR_OBJECT_LEGACY_EFFECT));
-      for (unsigned i = 0; i < _countof(g_DeprecatedEffectObjectNames); i++) {
-        IdentifierInfo& idInfo = m_context->Idents.get(StringRef(g_DeprecatedEffectObjectNames[i]), tok::TokenKind::identifier);
-        //TypedefDecl* effectObjDecl = TypedefDecl::Create(*m_context, currentDeclContext, NoLoc, NoLoc, &idInfo, effectObjTypeSource);
-        CXXRecordDecl *effectObjDecl = CXXRecordDecl::Create(*m_context, TagTypeKind::TTK_Struct, currentDeclContext, NoLoc, NoLoc, &idInfo);
-        currentDeclContext->addDecl(effectObjDecl);
-        effectObjDecl->setImplicit(true);
-        m_objectTypeDeclsMap[i+effectObjBase] = std::make_pair(effectObjDecl, effectKindIndex);
-      }
+  // Returns the declaration for a deprecated effect object type, which all
+  // map to the AR_OBJECT_LEGACY_EFFECT kind.
+  CXXRecordDecl* GetOrCreateEffectObjectDecl(unsigned i)
+  {
+    DXASSERT_NOMSG(i < _countof(g_DeprecatedEffectObjectNames));
+    if (m_effectObjectDecls[i] == nullptr) {
+      const ArBasicKind* match = std::find(g_ArBasicKindsAsTypes, &g_ArBasicKindsAsTypes[_countof(g_ArBasicKindsAsTypes)], AR_OBJECT_LEGACY_EFFECT);
+      unsigned effectKindIndex = match - g_ArBasicKindsAsTypes;
+      GetOrCreateObjectTypeDecl(effectKindIndex);
+
+      DeclContext* currentDeclContext = m_context->getTranslationUnitDecl();
+      IdentifierInfo& idInfo = m_context->Idents.get(StringRef(g_DeprecatedEffectObjectNames[i]), tok::TokenKind::identifier);
+      CXXRecordDecl *effectObjDecl = CXXRecordDecl::Create(*m_context, TagTypeKind::TTK_Struct, currentDeclContext, NoLoc, NoLoc, &idInfo);
+      currentDeclContext->addDecl(effectObjDecl);
+      effectObjDecl->setImplicit(true);
+      m_effectObjectDecls[i] = effectObjDecl;
+      m_objectTypeDeclsMap[effectObjDecl] = effectKindIndex;
     }
+    return m_effectObjectDecls[i];
+  }
 
-    // Make sure it's in order.
-    std::sort(m_objectTypeDeclsMap.begin(), m_objectTypeDeclsMap.end(), ObjectTypeDeclMapTypeCmp);
+  // Creates the built-in object type, alias or global with the given name if
+  // it doesn't exist yet. Returns false if no built-in has the name.
+  bool CreateObjectTypeForName(StringRef name)
+  {
+    auto it = m_objectTypeNames.find(name);
+    if (it == m_objectTypeNames.end())
+      return false;
+    unsigned index = it->second;
+    if (index < _countof(g_ArBasicKindsAsTypes))
+      GetOrCreateObjectTypeDecl(index);
+    else if (index == SamplerAliasNameIndex)
+      GetSamplerTypedef();
+    else
+      GetOrCreateEffectObjectDecl(index - EffectObjectNameIndexBase);
+    return true;
   }
 
   FunctionDecl* AddSubscriptSpecialization(
@@ -3671,8 +3743,12 @@ public:
     m_vkNSDecl(nullptr),
     m_context(nullptr),
     m_sema(nullptr),
-    m_hlslStringTypedef(nullptr)
+    m_hlslStringTypedef(nullptr),
+    m_samplerTypedef(nullptr),
+    m_objectTypeLazyInitMask(0)
   {
+    memset(m_objectTypeDecls, 0, sizeof(m_objectTypeDecls));
+    memset(m_effectObjectDecls, 0, sizeof(m_effectObjectDecls));
     memset(m_matrixTypes, 0, sizeof(m_matrixTypes));
     memset(m_matrixShorthandTypes, 0, sizeof(m_matrixShorthandTypes));
     memset(m_vectorTypes, 0, sizeof(m_vectorTypes));
@@ -3703,9 +3779,6 @@ public:
 
     AddObjectTypes();
     AddStdIsEqualImplementation(context, S);
-    for (auto && intrinsic : m_intrinsicTables) {
-      AddIntrinsicTableMethods(intrinsic);
-    }
 
 #ifdef ENABLE_SPIRV_CODEGEN
     if (m_sema->getLangOpts().SPIRV) {
@@ -3903,6 +3976,15 @@ public:
       TypedefDecl *strDecl = GetStringTypedef();
       R.addDecl(strDecl);
     }
+    // built-in object types, aliases and globals
+    else if (CreateObjectTypeForName(nameIdentifier)) {
+      for (NamedDecl *decl : m_context->getTranslationUnitDecl()->lookup(declName.getName())) {
+        if (decl->isInIdentifierNamespace(R.getIdentifierNamespace()))
+          R.addDecl(decl);
+      }
+      R.resolveKind();
+      return !R.empty();
+    }
     return false;
   }
 
@@ -4135,47 +4217,47 @@ public:
     return AR_BASIC_UNKNOWN;
   }
 
-  void AddIntrinsicTableMethods(_In_ IDxcIntrinsicTable *table) {
+  // Adds the methods of table to the object type at index i of
+  // g_ArBasicKindsAsTypes, which must already have been created.
+  void AddIntrinsicTableMethods(_In_ IDxcIntrinsicTable *table, unsigned i) {
     DXASSERT_NOMSG(table != nullptr);
 
     // Function intrinsics are added on-demand, objects get template methods.
-    for (unsigned i = 0; i < _countof(g_ArBasicKindsAsTypes); i++) {
-      // Grab information already processed by AddObjectTypes.
-      ArBasicKind kind = g_ArBasicKindsAsTypes[i];
-      const char *typeName = g_ArBasicTypeNames[kind];
-      uint8_t templateArgCount = g_ArBasicKindsTemplateCount[i];
-      DXASSERT(templateArgCount <= 2, "otherwise a new case has been added");
-      int startDepth = (templateArgCount == 0) ? 0 : 1;
-      CXXRecordDecl *recordDecl = m_objectTypeDecls[i];
-      if (recordDecl == nullptr) {
-        DXASSERT(kind == AR_OBJECT_WAVE, "else objects other than reserved not initialized");
-        continue;
-      }
+    ArBasicKind kind = g_ArBasicKindsAsTypes[i];
+    const char *typeName = g_ArBasicTypeNames[kind];
+    uint8_t templateArgCount = g_ArBasicKindsTemplateCount[i];
+    DXASSERT(templateArgCount <= 2, "otherwise a new case has been added");
+    int startDepth = (templateArgCount == 0) ? 0 : 1;
+    CXXRecordDecl *recordDecl = m_objectTypeDecls[i];
+    DXASSERT_NOMSG(recordDecl != nullptr);
 
-      // This is a variation of AddObjectMethods using the new table.
-      const HLSL_INTRINSIC *pIntrinsic = nullptr;
-      const HLSL_INTRINSIC *pPrior = nullptr;
-      UINT64 lookupCookie = 0;
-      CA2W wideTypeName(typeName, CP_UTF8);
-      HRESULT found = table->LookupIntrinsic(wideTypeName, L"*", &pIntrinsic, &lookupCookie);
-      while (pIntrinsic != nullptr && SUCCEEDED(found)) {
-        if (!AreIntrinsicTemplatesEquivalent(pIntrinsic, pPrior)) {
-          AddObjectIntrinsicTemplate(recordDecl, startDepth, pIntrinsic);
-          // NOTE: this only works with the current implementation because
-          // intrinsics are alive as long as the table is alive.
-          pPrior = pIntrinsic;
-        }
-        found = table->LookupIntrinsic(wideTypeName, L"*", &pIntrinsic, &lookupCookie);
+    // This is a variation of AddObjectMethods using the new table.
+    const HLSL_INTRINSIC *pIntrinsic = nullptr;
+    const HLSL_INTRINSIC *pPrior = nullptr;
+    UINT64 lookupCookie = 0;
+    CA2W wideTypeName(typeName, CP_UTF8);
+    HRESULT found = table->LookupIntrinsic(wideTypeName, L"*", &pIntrinsic, &lookupCookie);
+    while (pIntrinsic != nullptr && SUCCEEDED(found)) {
+      if (!AreIntrinsicTemplatesEquivalent(pIntrinsic, pPrior)) {
+        AddObjectIntrinsicTemplate(recordDecl, startDepth, pIntrinsic);
+        // NOTE: this only works with the current implementation because
+        // intrinsics are alive as long as the table is alive.
+        pPrior = pIntrinsic;
       }
+      found = table->LookupIntrinsic(wideTypeName, L"*", &pIntrinsic, &lookupCookie);
     }
   }
 
   void RegisterIntrinsicTable(_In_ IDxcIntrinsicTable *table) {
     DXASSERT_NOMSG(table != nullptr);
     m_intrinsicTables.push_back(table);
-    // If already initialized, add methods immediately.
+    // Object types created from here on get the table's methods as they are
+    // created; add them to those that already exist.
     if (m_sema != nullptr) {
-      AddIntrinsicTableMethods(table);
+      for (unsigned i = 0; i < _countof(g_ArBasicKindsAsTypes); i++) {
+        if (m_objectTypeDecls[i] != nullptr)
+          AddIntrinsicTableMethods(table, i);
+      }
     }
   }
 
@@ -4298,7 +4380,7 @@ public:
         const ArBasicKind* match = std::find(g_ArBasicKindsAsTypes, &g_ArBasicKindsAsTypes[_countof(g_ArBasicKindsAsTypes)], kind);
         DXASSERT(match != &g_ArBasicKindsAsTypes[_countof(g_ArBasicKindsAsTypes)], "otherwise can't find constant in basic kinds");
         size_t index = match - g_ArBasicKindsAsTypes;
-        return m_context->getTagDeclType(this->m_objectTypeDecls[index]);
+        return m_context->getTagDeclType(GetOrCreateObjectTypeDecl(index));
     }
 
     case AR_OBJECT_SAMPLER1D:
@@ -4423,17 +4505,30 @@ public:
     StringRef nameIdentifier,
     size_t argumentCount)
   {
-    // This is implemented by a linear scan for now.
-    // We tested binary search on tables, and there was no performance gain on
-    // samples probably for the following reasons.
-    // 1. The tables are not big enough to make noticable difference
-    // 2. The user of this function assumes that it returns the first entry in
-    // the table that matches name and argument count. So even in the binary
-    // search, we have to scan backwards until the entry does not match the name
-    // or arg count. For linear search this is not a problem
-    for (unsigned int i = 0; i < tableSize; i++) {
-      const HLSL_INTRINSIC* pIntrinsic = &table[i];
+    // The user of this function assumes that it returns the first entry in
+    // the table that matches name and argument count. Entries that share a
+    // name are adjacent, so scanning just those in table order finds the same
+    // entry as scanning the whole table.
+    const HLSL_INTRINSIC *pStart = table;
+    const HLSL_INTRINSIC *pEnd = table + tableSize;
+    if (const HLSL_INTRINSIC_NAME_INDEX *pIndex = GetIntrinsicNameIndex(table)) {
+      const HLSL_INTRINSIC_NAME_RANGE *pRangesEnd =
+          pIndex->pRanges + pIndex->uRangeCount;
+      const HLSL_INTRINSIC_NAME_RANGE *pRange = std::lower_bound(
+          pIndex->pRanges, pRangesEnd, nameIdentifier,
+          [](const HLSL_INTRINSIC_NAME_RANGE &range, StringRef name) {
+            return name.compare(range.pName) > 0;
+          });
+      if (pRange != pRangesEnd && nameIdentifier.equals(pRange->pName)) {
+        pStart = table + pRange->uFirst;
+        pEnd = pStart + pRange->uCount;
+      } else {
+        pStart = pEnd;
+      }
+    }
 
+    for (const HLSL_INTRINSIC *pIntrinsic = pStart; pIntrinsic != pEnd;
+         ++pIntrinsic) {
       const bool isVariadicFn = IsVariadicIntrinsicFunction(pIntrinsic);
 
       // Do some quick checks to verify size and name.
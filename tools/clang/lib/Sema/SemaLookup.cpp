@@ -1764,6 +1764,14 @@ bool Sema::LookupQualifiedName(LookupResult &R, DeclContext *LookupCtx,
     return true;
   }
 
+  // HLSL Change Starts - built-in types are declared the first time they are
+  // named, so a name qualified with the global scope gets the same chance as
+  // an unqualified one.
+  if (!InUnqualifiedLookup && LookupCtx->isTranslationUnit() &&
+      ExternalSource && ExternalSource->LookupUnqualified(R, TUScope))
+    return true;
+  // HLSL Change Ends
+
   // Don't descend into implied contexts for redeclarations.
   // C++98 [namespace.qual]p6:
   //   In a declaration for a namespace member in which the
@@ -1944,6 +1944,224 @@ static const HLSL_INTRINSIC g_Intrinsics[] =
     {(UINT)hlsl::IntrinsicOp::IOP_unpack_u8u32, false, true, false, -1, 2, g_Intrinsics_Args248},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_Intrinsics_Names[] =
+{
+    {"$hidden$AllocateRayQuery", 4, 1},
+    {"$hidden$CreateResourceFromHeap", 7, 1},
+    {"AcceptHitAndEndSearch", 0, 1},
+    {"AddUint64", 1, 1},
+    {"AllMemoryBarrier", 2, 1},
+    {"AllMemoryBarrierWithGroupSync", 3, 1},
+    {"CallShader", 5, 1},
+    {"CheckAccessFullyMapped", 6, 1},
+    {"D3DCOLORtoUBYTE4", 8, 1},
+    {"DeviceMemoryBarrier", 9, 1},
+    {"DeviceMemoryBarrierWithGroupSync", 10, 1},
+    {"DispatchMesh", 11, 1},
+    {"DispatchRaysDimensions", 12, 1},
+    {"DispatchRaysIndex", 13, 1},
+    {"EvaluateAttributeAtSample", 14, 1},
+    {"EvaluateAttributeCentroid", 15, 1},
+    {"EvaluateAttributeSnapped", 16, 1},
+    {"GeometryIndex", 17, 1},
+    {"GetAttributeAtVertex", 18, 1},
+    {"GetRenderTargetSampleCount", 19, 1},
+    {"GetRenderTargetSamplePosition", 20, 1},
+    {"GroupMemoryBarrier", 21, 1},
+    {"GroupMemoryBarrierWithGroupSync", 22, 1},
+    {"HitKind", 23, 1},
+    {"IgnoreHit", 24, 1},
+    {"InstanceID", 25, 1},
+    {"InstanceIndex", 26, 1},
+    {"InterlockedAdd", 27, 4},
+    {"InterlockedAnd", 31, 4},
+    {"InterlockedCompareExchange", 35, 2},
+    {"InterlockedCompareExchangeFloatBitwise", 37, 1},
+    {"InterlockedCompareStore", 38, 2},
+    {"InterlockedCompareStoreFloatBitwise", 40, 1},
+    {"InterlockedExchange", 41, 3},
+    {"InterlockedMax", 44, 4},
+    {"InterlockedMin", 48, 4},
+    {"InterlockedOr", 52, 4},
+    {"InterlockedXor", 56, 4},
+    {"IsHelperLane", 60, 1},
+    {"NonUniformResourceIndex", 61, 1},
+    {"ObjectRayDirection", 62, 1},
+    {"ObjectRayOrigin", 63, 1},
+    {"ObjectToWorld", 64, 1},
+    {"ObjectToWorld3x4", 65, 1},
+    {"ObjectToWorld4x3", 66, 1},
+    {"PrimitiveIndex", 67, 1},
+    {"Process2DQuadTessFactorsAvg", 68, 1},
+    {"Process2DQuadTessFactorsMax", 69, 1},
+    {"Process2DQuadTessFactorsMin", 70, 1},
+    {"ProcessIsolineTessFactors", 71, 1},
+    {"ProcessQuadTessFactorsAvg", 72, 1},
+    {"ProcessQuadTessFactorsMax", 73, 1},
+    {"ProcessQuadTessFactorsMin", 74, 1},
+    {"ProcessTriTessFactorsAvg", 75, 1},
+    {"ProcessTriTessFactorsMax", 76, 1},
+    {"ProcessTriTessFactorsMin", 77, 1},
+    {"QuadReadAcrossDiagonal", 78, 1},
+    {"QuadReadAcrossX", 79, 1},
+    {"QuadReadAcrossY", 80, 1},
+    {"QuadReadLaneAt", 81, 1},
+    {"RayFlags", 82, 1},
+    {"RayTCurrent", 83, 1},
+    {"RayTMin", 84, 1},
+    {"ReportHit", 85, 1},
+    {"SetMeshOutputCounts", 86, 1},
+    {"TraceRay", 87, 1},
+    {"WaveActiveAllEqual", 88, 1},
+    {"WaveActiveAllTrue", 89, 1},
+    {"WaveActiveAnyTrue", 90, 1},
+    {"WaveActiveBallot", 91, 1},
+    {"WaveActiveBitAnd", 92, 1},
+    {"WaveActiveBitOr", 93, 1},
+    {"WaveActiveBitXor", 94, 1},
+    {"WaveActiveCountBits", 95, 1},
+    {"WaveActiveMax", 96, 1},
+    {"WaveActiveMin", 97, 1},
+    {"WaveActiveProduct", 98, 1},
+    {"WaveActiveSum", 99, 1},
+    {"WaveGetLaneCount", 100, 1},
+    {"WaveGetLaneIndex", 101, 1},
+    {"WaveIsFirstLane", 102, 1},
+    {"WaveMatch", 103, 1},
+    {"WaveMultiPrefixBitAnd", 104, 1},
+    {"WaveMultiPrefixBitOr", 105, 1},
+    {"WaveMultiPrefixBitXor", 106, 1},
+    {"WaveMultiPrefixCountBits", 107, 1},
+    {"WaveMultiPrefixProduct", 108, 1},
+    {"WaveMultiPrefixSum", 109, 1},
+    {"WavePrefixCountBits", 110, 1},
+    {"WavePrefixProduct", 111, 1},
+    {"WavePrefixSum", 112, 1},
+    {"WaveReadLaneAt", 113, 1},
+    {"WaveReadLaneFirst", 114, 1},
+    {"WorldRayDirection", 115, 1},
+    {"WorldRayOrigin", 116, 1},
+    {"WorldToObject", 117, 1},
+    {"WorldToObject3x4", 118, 1},
+    {"WorldToObject4x3", 119, 1},
+    {"abort", 120, 1},
+    {"abs", 121, 1},
+    {"acos", 122, 1},
+    {"all", 123, 1},
+    {"any", 124, 1},
+    {"asdouble", 125, 1},
+    {"asfloat", 126, 1},
+    {"asfloat16", 127, 1},
+    {"asin", 128, 1},
+    {"asint", 129, 1},
+    {"asint16", 130, 1},
+    {"asuint", 131, 2},
+    {"asuint16", 133, 1},
+    {"atan", 134, 1},
+    {"atan2", 135, 1},
+    {"ceil", 136, 1},
+    {"clamp", 137, 1},
+    {"clip", 138, 1},
+    {"cos", 139, 1},
+    {"cosh", 140, 1},
+    {"countbits", 141, 1},
+    {"cross", 142, 1},
+    {"ddx", 143, 1},
+    {"ddx_coarse", 144, 1},
+    {"ddx_fine", 145, 1},
+    {"ddy", 146, 1},
+    {"ddy_coarse", 147, 1},
+    {"ddy_fine", 148, 1},
+    {"degrees", 149, 1},
+    {"determinant", 150, 1},
+    {"distance", 151, 1},
+    {"dot", 152, 1},
+    {"dot2add", 153, 1},
+    {"dot4add_i8packed", 154, 1},
+    {"dot4add_u8packed", 155, 1},
+    {"dst", 156, 1},
+    {"exp", 157, 1},
+    {"exp2", 158, 1},
+    {"f16tof32", 159, 1},
+    {"f32tof16", 160, 1},
+    {"faceforward", 161, 1},
+    {"firstbithigh", 162, 1},
+    {"firstbitlow", 163, 1},
+    {"floor", 164, 1},
+    {"fma", 165, 1},
+    {"fmod", 166, 1},
+    {"frac", 167, 1},
+    {"frexp", 168, 1},
+    {"fwidth", 169, 1},
+    {"isfinite", 170, 1},
+    {"isinf", 171, 1},
+    {"isnan", 172, 1},
+    {"ldexp", 173, 1},
+    {"length", 174, 1},
+    {"lerp", 175, 1},
+    {"lit", 176, 1},
+    {"log", 177, 1},
+    {"log10", 178, 1},
+    {"log2", 179, 1},
+    {"mad", 180, 1},
+    {"max", 181, 1},
+    {"min", 182, 1},
+    {"modf", 183, 1},
+    {"msad4", 184, 1},
+    {"mul", 185, 9},
+    {"normalize", 194, 1},
+    {"pack_clamp_s8", 195, 1},
+    {"pack_clamp_u8", 196, 1},
+    {"pack_s8", 197, 1},
+    {"pack_u8", 198, 1},
+    {"pow", 199, 1},
+    {"printf", 200, 1},
+    {"radians", 201, 1},
+    {"rcp", 202, 1},
+    {"reflect", 203, 1},
+    {"refract", 204, 1},
+    {"reversebits", 205, 1},
+    {"round", 206, 1},
+    {"rsqrt", 207, 1},
+    {"saturate", 208, 1},
+    {"sign", 209, 1},
+    {"sin", 210, 1},
+    {"sincos", 211, 1},
+    {"sinh", 212, 1},
+    {"smoothstep", 213, 1},
+    {"source_mark", 214, 1},
+    {"sqrt", 215, 1},
+    {"step", 216, 1},
+    {"tan", 217, 1},
+    {"tanh", 218, 1},
+    {"tex1D", 219, 2},
+    {"tex1Dbias", 221, 1},
+    {"tex1Dgrad", 222, 1},
+    {"tex1Dlod", 223, 1},
+    {"tex1Dproj", 224, 1},
+    {"tex2D", 225, 2},
+    {"tex2Dbias", 227, 1},
+    {"tex2Dgrad", 228, 1},
+    {"tex2Dlod", 229, 1},
+    {"tex2Dproj", 230, 1},
+    {"tex3D", 231, 2},
+    {"tex3Dbias", 233, 1},
+    {"tex3Dgrad", 234, 1},
+    {"tex3Dlod", 235, 1},
+    {"tex3Dproj", 236, 1},
+    {"texCUBE", 237, 2},
+    {"texCUBEbias", 239, 1},
+    {"texCUBEgrad", 240, 1},
+    {"texCUBElod", 241, 1},
+    {"texCUBEproj", 242, 1},
+    {"transpose", 243, 1},
+    {"trunc", 244, 1},
+    {"unpack_s8s16", 245, 1},
+    {"unpack_s8s32", 246, 1},
+    {"unpack_u8u16", 247, 1},
+    {"unpack_u8u32", 248, 1},
+};
+
 //
 // Start of VkIntrinsics
 //
@@ -1961,6 +2179,11 @@ static const HLSL_INTRINSIC g_VkIntrinsics[] =
     {(UINT)hlsl::IntrinsicOp::IOP_VkReadClock, false, false, false, -1, 2, g_VkIntrinsics_Args0},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_VkIntrinsics_Names[] =
+{
+    {"ReadClock", 0, 1},
+};
+
 #endif // ENABLE_SPIRV_CODEGEN
 
 //
@@ -1984,6 +2207,12 @@ static const HLSL_INTRINSIC g_StreamMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_RestartStrip, false, false, false, -1, 1, g_StreamMethods_Args1},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_StreamMethods_Names[] =
+{
+    {"Append", 0, 1},
+    {"RestartStrip", 1, 1},
+};
+
 //
 // Start of Texture1DMethods
 //
@@ -2292,6 +2521,20 @@ static const HLSL_INTRINSIC g_Texture1DMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_SampleLevel, false, false, false, -1, 6, g_Texture1DMethods_Args30},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_Texture1DMethods_Names[] =
+{
+    {"CalculateLevelOfDetail", 0, 1},
+    {"CalculateLevelOfDetailUnclamped", 1, 1},
+    {"GetDimensions", 2, 4},
+    {"Load", 6, 3},
+    {"Sample", 9, 4},
+    {"SampleBias", 13, 4},
+    {"SampleCmp", 17, 4},
+    {"SampleCmpLevelZero", 21, 3},
+    {"SampleGrad", 24, 4},
+    {"SampleLevel", 28, 3},
+};
+
 //
 // Start of Texture1DArrayMethods
 //
@@ -2604,6 +2847,20 @@ static const HLSL_INTRINSIC g_Texture1DArrayMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_SampleLevel, false, false, false, -1, 6, g_Texture1DArrayMethods_Args30},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_Texture1DArrayMethods_Names[] =
+{
+    {"CalculateLevelOfDetail", 0, 1},
+    {"CalculateLevelOfDetailUnclamped", 1, 1},
+    {"GetDimensions", 2, 4},
+    {"Load", 6, 3},
+    {"Sample", 9, 4},
+    {"SampleBias", 13, 4},
+    {"SampleCmp", 17, 4},
+    {"SampleCmpLevelZero", 21, 3},
+    {"SampleGrad", 24, 4},
+    {"SampleLevel", 28, 3},
+};
+
 //
 // Start of Texture2DMethods
 //
@@ -3409,6 +3666,30 @@ static const HLSL_INTRINSIC g_Texture2DMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_SampleLevel, false, false, false, -1, 6, g_Texture2DMethods_Args76},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_Texture2DMethods_Names[] =
+{
+    {"CalculateLevelOfDetail", 0, 1},
+    {"CalculateLevelOfDetailUnclamped", 1, 1},
+    {"Gather", 2, 3},
+    {"GatherAlpha", 5, 5},
+    {"GatherBlue", 10, 5},
+    {"GatherCmp", 15, 3},
+    {"GatherCmpAlpha", 18, 5},
+    {"GatherCmpBlue", 23, 5},
+    {"GatherCmpGreen", 28, 5},
+    {"GatherCmpRed", 33, 5},
+    {"GatherGreen", 38, 5},
+    {"GatherRed", 43, 5},
+    {"GetDimensions", 48, 4},
+    {"Load", 52, 3},
+    {"Sample", 55, 4},
+    {"SampleBias", 59, 4},
+    {"SampleCmp", 63, 4},
+    {"SampleCmpLevelZero", 67, 3},
+    {"SampleGrad", 70, 4},
+    {"SampleLevel", 74, 3},
+};
+
 //
 // Start of Texture2DMSMethods
 //
@@ -3469,6 +3750,13 @@ static const HLSL_INTRINSIC g_Texture2DMSMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 5, g_Texture2DMSMethods_Args5},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_Texture2DMSMethods_Names[] =
+{
+    {"GetDimensions", 0, 2},
+    {"GetSamplePosition", 2, 1},
+    {"Load", 3, 3},
+};
+
 //
 // Start of Texture2DArrayMethods
 //
@@ -4278,6 +4566,30 @@ static const HLSL_INTRINSIC g_Texture2DArrayMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_SampleLevel, false, false, false, -1, 6, g_Texture2DArrayMethods_Args76},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_Texture2DArrayMethods_Names[] =
+{
+    {"CalculateLevelOfDetail", 0, 1},
+    {"CalculateLevelOfDetailUnclamped", 1, 1},
+    {"Gather", 2, 3},
+    {"GatherAlpha", 5, 5},
+    {"GatherBlue", 10, 5},
+    {"GatherCmp", 15, 3},
+    {"GatherCmpAlpha", 18, 5},
+    {"GatherCmpBlue", 23, 5},
+    {"GatherCmpGreen", 28, 5},
+    {"GatherCmpRed", 33, 5},
+    {"GatherGreen", 38, 5},
+    {"GatherRed", 43, 5},
+    {"GetDimensions", 48, 4},
+    {"Load", 52, 3},
+    {"Sample", 55, 4},
+    {"SampleBias", 59, 4},
+    {"SampleCmp", 63, 4},
+    {"SampleCmpLevelZero", 67, 3},
+    {"SampleGrad", 70, 4},
+    {"SampleLevel", 74, 3},
+};
+
 //
 // Start of Texture2DArrayMSMethods
 //
@@ -4340,6 +4652,13 @@ static const HLSL_INTRINSIC g_Texture2DArrayMSMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 5, g_Texture2DArrayMSMethods_Args5},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_Texture2DArrayMSMethods_Names[] =
+{
+    {"GetDimensions", 0, 2},
+    {"GetSamplePosition", 2, 1},
+    {"Load", 3, 3},
+};
+
 //
 // Start of Texture3DMethods
 //
@@ -4584,6 +4903,18 @@ static const HLSL_INTRINSIC g_Texture3DMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_SampleLevel, false, false, false, -1, 6, g_Texture3DMethods_Args23},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_Texture3DMethods_Names[] =
+{
+    {"CalculateLevelOfDetail", 0, 1},
+    {"CalculateLevelOfDetailUnclamped", 1, 1},
+    {"GetDimensions", 2, 4},
+    {"Load", 6, 3},
+    {"Sample", 9, 4},
+    {"SampleBias", 13, 4},
+    {"SampleGrad", 17, 4},
+    {"SampleLevel", 21, 3},
+};
+
 //
 // Start of TextureCUBEMethods
 //
@@ -4982,6 +5313,29 @@ static const HLSL_INTRINSIC g_TextureCUBEMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_SampleLevel, false, false, false, -1, 5, g_TextureCUBEMethods_Args41},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_TextureCUBEMethods_Names[] =
+{
+    {"CalculateLevelOfDetail", 0, 1},
+    {"CalculateLevelOfDetailUnclamped", 1, 1},
+    {"Gather", 2, 2},
+    {"GatherAlpha", 4, 2},
+    {"GatherBlue", 6, 2},
+    {"GatherCmp", 8, 2},
+    {"GatherCmpAlpha", 10, 2},
+    {"GatherCmpBlue", 12, 2},
+    {"GatherCmpGreen", 14, 2},
+    {"GatherCmpRed", 16, 2},
+    {"GatherGreen", 18, 2},
+    {"GatherRed", 20, 2},
+    {"GetDimensions", 22, 4},
+    {"Sample", 26, 3},
+    {"SampleBias", 29, 3},
+    {"SampleCmp", 32, 3},
+    {"SampleCmpLevelZero", 35, 2},
+    {"SampleGrad", 37, 3},
+    {"SampleLevel", 40, 2},
+};
+
 //
 // Start of TextureCUBEArrayMethods
 //
@@ -5384,6 +5738,29 @@ static const HLSL_INTRINSIC g_TextureCUBEArrayMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_SampleLevel, false, false, false, -1, 5, g_TextureCUBEArrayMethods_Args41},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_TextureCUBEArrayMethods_Names[] =
+{
+    {"CalculateLevelOfDetail", 0, 1},
+    {"CalculateLevelOfDetailUnclamped", 1, 1},
+    {"Gather", 2, 2},
+    {"GatherAlpha", 4, 2},
+    {"GatherBlue", 6, 2},
+    {"GatherCmp", 8, 2},
+    {"GatherCmpAlpha", 10, 2},
+    {"GatherCmpBlue", 12, 2},
+    {"GatherCmpGreen", 14, 2},
+    {"GatherCmpRed", 16, 2},
+    {"GatherGreen", 18, 2},
+    {"GatherRed", 20, 2},
+    {"GetDimensions", 22, 4},
+    {"Sample", 26, 3},
+    {"SampleBias", 29, 3},
+    {"SampleCmp", 32, 3},
+    {"SampleCmpLevelZero", 35, 2},
+    {"SampleGrad", 37, 3},
+    {"SampleLevel", 40, 2},
+};
+
 //
 // Start of BufferMethods
 //
@@ -5414,6 +5791,12 @@ static const HLSL_INTRINSIC g_BufferMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 3, g_BufferMethods_Args2},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_BufferMethods_Names[] =
+{
+    {"GetDimensions", 0, 1},
+    {"Load", 1, 2},
+};
+
 //
 // Start of RWTexture1DMethods
 //
@@ -5451,6 +5834,12 @@ static const HLSL_INTRINSIC g_RWTexture1DMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 3, g_RWTexture1DMethods_Args3},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_RWTexture1DMethods_Names[] =
+{
+    {"GetDimensions", 0, 2},
+    {"Load", 2, 2},
+};
+
 //
 // Start of RWTexture1DArrayMethods
 //
@@ -5490,6 +5879,12 @@ static const HLSL_INTRINSIC g_RWTexture1DArrayMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 3, g_RWTexture1DArrayMethods_Args3},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_RWTexture1DArrayMethods_Names[] =
+{
+    {"GetDimensions", 0, 2},
+    {"Load", 2, 2},
+};
+
 //
 // Start of RWTexture2DMethods
 //
@@ -5529,6 +5924,12 @@ static const HLSL_INTRINSIC g_RWTexture2DMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 3, g_RWTexture2DMethods_Args3},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_RWTexture2DMethods_Names[] =
+{
+    {"GetDimensions", 0, 2},
+    {"Load", 2, 2},
+};
+
 //
 // Start of RWTexture2DArrayMethods
 //
@@ -5570,6 +5971,12 @@ static const HLSL_INTRINSIC g_RWTexture2DArrayMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 3, g_RWTexture2DArrayMethods_Args3},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_RWTexture2DArrayMethods_Names[] =
+{
+    {"GetDimensions", 0, 2},
+    {"Load", 2, 2},
+};
+
 //
 // Start of RWTexture3DMethods
 //
@@ -5611,6 +6018,12 @@ static const HLSL_INTRINSIC g_RWTexture3DMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 3, g_RWTexture3DMethods_Args3},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_RWTexture3DMethods_Names[] =
+{
+    {"GetDimensions", 0, 2},
+    {"Load", 2, 2},
+};
+
 //
 // Start of RWBufferMethods
 //
@@ -5641,6 +6054,12 @@ static const HLSL_INTRINSIC g_RWBufferMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 3, g_RWBufferMethods_Args2},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_RWBufferMethods_Names[] =
+{
+    {"GetDimensions", 0, 1},
+    {"Load", 1, 2},
+};
+
 //
 // Start of ByteAddressBufferMethods
 //
@@ -5716,6 +6135,15 @@ static const HLSL_INTRINSIC g_ByteAddressBufferMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load4, false, false, false, -1, 3, g_ByteAddressBufferMethods_Args8},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_ByteAddressBufferMethods_Names[] =
+{
+    {"GetDimensions", 0, 1},
+    {"Load", 1, 2},
+    {"Load2", 3, 2},
+    {"Load3", 5, 2},
+    {"Load4", 7, 2},
+};
+
 //
 // Start of RWByteAddressBufferMethods
 //
@@ -6111,6 +6539,40 @@ static const HLSL_INTRINSIC g_RWByteAddressBufferMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Store4, false, false, false, -1, 3, g_RWByteAddressBufferMethods_Args45},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_RWByteAddressBufferMethods_Names[] =
+{
+    {"GetDimensions", 0, 1},
+    {"InterlockedAdd", 1, 2},
+    {"InterlockedAdd64", 3, 2},
+    {"InterlockedAnd", 5, 2},
+    {"InterlockedAnd64", 7, 2},
+    {"InterlockedCompareExchange", 9, 1},
+    {"InterlockedCompareExchange64", 10, 1},
+    {"InterlockedCompareExchangeFloatBitwise", 11, 1},
+    {"InterlockedCompareStore", 12, 1},
+    {"InterlockedCompareStore64", 13, 1},
+    {"InterlockedCompareStoreFloatBitwise", 14, 1},
+    {"InterlockedExchange", 15, 1},
+    {"InterlockedExchange64", 16, 1},
+    {"InterlockedExchangeFloat", 17, 1},
+    {"InterlockedMax", 18, 2},
+    {"InterlockedMax64", 20, 2},
+    {"InterlockedMin", 22, 2},
+    {"InterlockedMin64", 24, 2},
+    {"InterlockedOr", 26, 2},
+    {"InterlockedOr64", 28, 2},
+    {"InterlockedXor", 30, 2},
+    {"InterlockedXor64", 32, 2},
+    {"Load", 34, 2},
+    {"Load2", 36, 2},
+    {"Load3", 38, 2},
+    {"Load4", 40, 2},
+    {"Store", 42, 1},
+    {"Store2", 43, 1},
+    {"Store3", 44, 1},
+    {"Store4", 45, 1},
+};
+
 //
 // Start of StructuredBufferMethods
 //
@@ -6142,6 +6604,12 @@ static const HLSL_INTRINSIC g_StructuredBufferMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 3, g_StructuredBufferMethods_Args2},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_StructuredBufferMethods_Names[] =
+{
+    {"GetDimensions", 0, 1},
+    {"Load", 1, 2},
+};
+
 //
 // Start of RWStructuredBufferMethods
 //
@@ -6185,6 +6653,14 @@ static const HLSL_INTRINSIC g_RWStructuredBufferMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_Load, false, false, false, -1, 3, g_RWStructuredBufferMethods_Args4},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_RWStructuredBufferMethods_Names[] =
+{
+    {"DecrementCounter", 0, 1},
+    {"GetDimensions", 1, 1},
+    {"IncrementCounter", 2, 1},
+    {"Load", 3, 2},
+};
+
 //
 // Start of AppendStructuredBufferMethods
 //
@@ -6208,6 +6684,12 @@ static const HLSL_INTRINSIC g_AppendStructuredBufferMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_GetDimensions, false, false, false, -1, 3, g_AppendStructuredBufferMethods_Args1},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_AppendStructuredBufferMethods_Names[] =
+{
+    {"Append", 0, 1},
+    {"GetDimensions", 1, 1},
+};
+
 //
 // Start of ConsumeStructuredBufferMethods
 //
@@ -6230,6 +6712,12 @@ static const HLSL_INTRINSIC g_ConsumeStructuredBufferMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_GetDimensions, false, false, false, -1, 3, g_ConsumeStructuredBufferMethods_Args1},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_ConsumeStructuredBufferMethods_Names[] =
+{
+    {"Consume", 0, 1},
+    {"GetDimensions", 1, 1},
+};
+
 //
 // Start of FeedbackTexture2DMethods
 //
@@ -6311,6 +6799,14 @@ static const HLSL_INTRINSIC g_FeedbackTexture2DMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_WriteSamplerFeedbackLevel, false, false, false, -1, 5, g_FeedbackTexture2DMethods_Args6},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_FeedbackTexture2DMethods_Names[] =
+{
+    {"WriteSamplerFeedback", 0, 2},
+    {"WriteSamplerFeedbackBias", 2, 2},
+    {"WriteSamplerFeedbackGrad", 4, 2},
+    {"WriteSamplerFeedbackLevel", 6, 1},
+};
+
 //
 // Start of FeedbackTexture2DArrayMethods
 //
@@ -6392,6 +6888,14 @@ static const HLSL_INTRINSIC g_FeedbackTexture2DArrayMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_WriteSamplerFeedbackLevel, false, false, false, -1, 5, g_FeedbackTexture2DArrayMethods_Args6},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_FeedbackTexture2DArrayMethods_Names[] =
+{
+    {"WriteSamplerFeedback", 0, 2},
+    {"WriteSamplerFeedbackBias", 2, 2},
+    {"WriteSamplerFeedbackGrad", 4, 2},
+    {"WriteSamplerFeedbackLevel", 6, 1},
+};
+
 //
 // Start of RayQueryMethods
 //
@@ -6645,6 +7149,50 @@ static const HLSL_INTRINSIC g_RayQueryMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_WorldRayOrigin, true, false, false, -1, 1, g_RayQueryMethods_Args39},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_RayQueryMethods_Names[] =
+{
+    {"Abort", 0, 1},
+    {"CandidateGeometryIndex", 1, 1},
+    {"CandidateInstanceContributionToHitGroupIndex", 2, 1},
+    {"CandidateInstanceID", 3, 1},
+    {"CandidateInstanceIndex", 4, 1},
+    {"CandidateObjectRayDirection", 5, 1},
+    {"CandidateObjectRayOrigin", 6, 1},
+    {"CandidateObjectToWorld3x4", 7, 1},
+    {"CandidateObjectToWorld4x3", 8, 1},
+    {"CandidatePrimitiveIndex", 9, 1},
+    {"CandidateProceduralPrimitiveNonOpaque", 10, 1},
+    {"CandidateTriangleBarycentrics", 11, 1},
+    {"CandidateTriangleFrontFace", 12, 1},
+    {"CandidateTriangleRayT", 13, 1},
+    {"CandidateType", 14, 1},
+    {"CandidateWorldToObject3x4", 15, 1},
+    {"CandidateWorldToObject4x3", 16, 1},
+    {"CommitNonOpaqueTriangleHit", 17, 1},
+    {"CommitProceduralPrimitiveHit", 18, 1},
+    {"CommittedGeometryIndex", 19, 1},
+    {"CommittedInstanceContributionToHitGroupIndex", 20, 1},
+    {"CommittedInstanceID", 21, 1},
+    {"CommittedInstanceIndex", 22, 1},
+    {"CommittedObjectRayDirection", 23, 1},
+    {"CommittedObjectRayOrigin", 24, 1},
+    {"CommittedObjectToWorld3x4", 25, 1},
+    {"CommittedObjectToWorld4x3", 26, 1},
+    {"CommittedPrimitiveIndex", 27, 1},
+    {"CommittedRayT", 28, 1},
+    {"CommittedStatus", 29, 1},
+    {"CommittedTriangleBarycentrics", 30, 1},
+    {"CommittedTriangleFrontFace", 31, 1},
+    {"CommittedWorldToObject3x4", 32, 1},
+    {"CommittedWorldToObject4x3", 33, 1},
+    {"Proceed", 34, 1},
+    {"RayFlags", 35, 1},
+    {"RayTMin", 36, 1},
+    {"TraceRayInline", 37, 1},
+    {"WorldRayDirection", 38, 1},
+    {"WorldRayOrigin", 39, 1},
+};
+
 //
 // Start of VkSubpassInputMethods
 //
@@ -6661,6 +7209,11 @@ static const HLSL_INTRINSIC g_VkSubpassInputMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_SubpassLoad, false, false, false, -1, 1, g_VkSubpassInputMethods_Args0},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_VkSubpassInputMethods_Names[] =
+{
+    {"SubpassLoad", 0, 1},
+};
+
 #endif // ENABLE_SPIRV_CODEGEN
 
 //
@@ -6680,7 +7233,52 @@ static const HLSL_INTRINSIC g_VkSubpassInputMSMethods[] =
     {(UINT)hlsl::IntrinsicOp::MOP_SubpassLoad, false, false, false, -1, 2, g_VkSubpassInputMSMethods_Args0},
 };
 
+static const HLSL_INTRINSIC_NAME_RANGE g_VkSubpassInputMSMethods_Names[] =
+{
+    {"SubpassLoad", 0, 1},
+};
+
+#endif // ENABLE_SPIRV_CODEGEN
+
+static const HLSL_INTRINSIC_NAME_INDEX g_IntrinsicNameIndexes[] =
+{
+    {g_Intrinsics, g_Intrinsics_Names, _countof(g_Intrinsics_Names)},
+#ifdef ENABLE_SPIRV_CODEGEN
+    {g_VkIntrinsics, g_VkIntrinsics_Names, _countof(g_VkIntrinsics_Names)},
 #endif // ENABLE_SPIRV_CODEGEN
+    {g_StreamMethods, g_StreamMethods_Names, _countof(g_StreamMethods_Names)},
+    {g_Texture1DMethods, g_Texture1DMethods_Names, _countof(g_Texture1DMethods_Names)},
+    {g_Texture1DArrayMethods, g_Texture1DArrayMethods_Names, _countof(g_Texture1DArrayMethods_Names)},
+    {g_Texture2DMethods, g_Texture2DMethods_Names, _countof(g_Texture2DMethods_Names)},
+    {g_Texture2DMSMethods, g_Texture2DMSMethods_Names, _countof(g_Texture2DMSMethods_Names)},
+    {g_Texture2DArrayMethods, g_Texture2DArrayMethods_Names, _countof(g_Texture2DArrayMethods_Names)},
+    {g_Texture2DArrayMSMethods, g_Texture2DArrayMSMethods_Names, _countof(g_Texture2DArrayMSMethods_Names)},
+    {g_Texture3DMethods, g_Texture3DMethods_Names, _countof(g_Texture3DMethods_Names)},
+    {g_TextureCUBEMethods, g_TextureCUBEMethods_Names, _countof(g_TextureCUBEMethods_Names)},
+    {g_TextureCUBEArrayMethods, g_TextureCUBEArrayMethods_Names, _countof(g_TextureCUBEArrayMethods_Names)},
+    {g_BufferMethods, g_BufferMethods_Names, _countof(g_BufferMethods_Names)},
+    {g_RWTexture1DMethods, g_RWTexture1DMethods_Names, _countof(g_RWTexture1DMethods_Names)},
+    {g_RWTexture1DArrayMethods, g_RWTexture1DArrayMethods_Names, _countof(g_RWTexture1DArrayMethods_Names)},
+    {g_RWTexture2DMethods, g_RWTexture2DMethods_Names, _countof(g_RWTexture2DMethods_Names)},
+    {g_RWTexture2DArrayMethods, g_RWTexture2DArrayMethods_Names, _countof(g_RWTexture2DArrayMethods_Names)},
+    {g_RWTexture3DMethods, g_RWTexture3DMethods_Names, _countof(g_RWTexture3DMethods_Names)},
+    {g_RWBufferMethods, g_RWBufferMethods_Names, _countof(g_RWBufferMethods_Names)},
+    {g_ByteAddressBufferMethods, g_ByteAddressBufferMethods_Names, _countof(g_ByteAddressBufferMethods_Names)},
+    {g_RWByteAddressBufferMethods, g_RWByteAddressBufferMethods_Names, _countof(g_RWByteAddressBufferMethods_Names)},
+    {g_StructuredBufferMethods, g_StructuredBufferMethods_Names, _countof(g_StructuredBufferMethods_Names)},
+    {g_RWStructuredBufferMethods, g_RWStructuredBufferMethods_Names, _countof(g_RWStructuredBufferMethods_Names)},
+    {g_AppendStructuredBufferMethods, g_AppendStructuredBufferMethods_Names, _countof(g_AppendStructuredBufferMethods_Names)},
+    {g_ConsumeStructuredBufferMethods, g_ConsumeStructuredBufferMethods_Names, _countof(g_ConsumeStructuredBufferMethods_Names)},
+    {g_FeedbackTexture2DMethods, g_FeedbackTexture2DMethods_Names, _countof(g_FeedbackTexture2DMethods_Names)},
+    {g_FeedbackTexture2DArrayMethods, g_FeedbackTexture2DArrayMethods_Names, _countof(g_FeedbackTexture2DArrayMethods_Names)},
+    {g_RayQueryMethods, g_RayQueryMethods_Names, _countof(g_RayQueryMethods_Names)},
+#ifdef ENABLE_SPIRV_CODEGEN
+    {g_VkSubpassInputMethods, g_VkSubpassInputMethods_Names, _countof(g_VkSubpassInputMethods_Names)},
+#endif // ENABLE_SPIRV_CODEGEN
+#ifdef ENABLE_SPIRV_CODEGEN
+    {g_VkSubpassInputMSMethods, g_VkSubpassInputMSMethods_Names, _countof(g_VkSubpassInputMSMethods_Names)},
+#endif // ENABLE_SPIRV_CODEGEN
+};
 // HLSL-INTRINSICS:END
 
 /* <py::lines('HLSL-INTRINSIC-STATS')>hctdb_instrhelp.get_hlsl_intrinsic_stats()</py>*/
@@ -0,0 +1,37 @@
+// Run: %dxc -T lib_6_3 -E main -fspv-parallel-entry-points
+
+// Each entry point is optimized in its own module with only its own execution
+// modes, then linked back in declaration order.
+
+// CHECK:      OpEntryPoint GLCompute %entryA "entryA"
+// CHECK-NEXT: OpEntryPoint GLCompute %entryB "entryB"
+// CHECK:      OpExecutionMode %entryA LocalSize 8 1 1
+// CHECK-NEXT: OpExecutionMode %entryB LocalSize 16 1 1
+
+// Linking does not merge resources, so each entry point keeps its own copy
+// of the buffer, with the same descriptor set and binding.
+// CHECK:      OpDecorate %output DescriptorSet 0
+// CHECK-NEXT: OpDecorate %output Binding 0
+// CHECK:      OpDecorate %output_0 DescriptorSet 0
+// CHECK-NEXT: OpDecorate %output_0 Binding 0
+// CHECK:      %output = OpVariable
+// CHECK:      %output_0 = OpVariable
+
+// CHECK:      %entryA = OpFunction
+// CHECK:      %entryB = OpFunction
+
+RWStructuredBuffer<float> output;
+
+float square(float x) { return x * x; }
+
+[shader("compute")]
+[numthreads(8, 1, 1)]
+void entryA(uint3 id : SV_DispatchThreadID) {
+  output[id.x] = square(id.x);
+}
+
+[shader("compute")]
+[numthreads(16, 1, 1)]
+void entryB(uint3 id : SV_DispatchThreadID) {
+  output[id.x] = square(id.y) + 1;
+}
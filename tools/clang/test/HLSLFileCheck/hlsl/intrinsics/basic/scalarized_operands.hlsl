@@ -0,0 +1,16 @@
+// RUN: %dxc -E main -T ps_6_0 -Od %s | FileCheck %s
+
+// Intrinsics over the result of another vector intrinsic take its scalar
+// results directly, without extracting them from a rebuilt vector.
+
+// CHECK: [[A0:%.*]] = call float @dx.op.unary.f32(i32 6, float
+// CHECK: [[A1:%.*]] = call float @dx.op.unary.f32(i32 6, float
+// CHECK: [[A2:%.*]] = call float @dx.op.unary.f32(i32 6, float
+// CHECK: [[S0:%.*]] = call float @dx.op.unary.f32(i32 24, float [[A0]])
+// CHECK: [[S1:%.*]] = call float @dx.op.unary.f32(i32 24, float [[A1]])
+// CHECK: [[S2:%.*]] = call float @dx.op.unary.f32(i32 24, float [[A2]])
+// CHECK: call float @dx.op.dot3.f32(i32 55, float [[S0]], float [[S1]], float [[S2]],
+
+float main(float3 y : Y) : SV_Target {
+  return dot(sqrt(abs(y)), y);
+}
@@ -0,0 +1,27 @@
+// RUN: %dxc -EFlowControlPS -Tps_6_0 %s -Od | %opt -S -dxil-annotate-with-virtual-regs -hlsl-dxil-debug-instrumentation,compact=1 | %FileCheck %s
+
+// With the compact encoding, each block reserves space for its steps once,
+// just before its terminator. The phi values on each edge are written as a
+// single record in the added edge block:
+
+// CHECK: PIXDebug0:
+// CHECK: call i32 @dx.op.atomicBinOp.i32(i32 78
+// CHECK-NOT: call i32 @dx.op.atomicBinOp.i32(i32 78
+// CHECK: br label
+
+// CHECK: PIXDebug1:
+// CHECK: call i32 @dx.op.atomicBinOp.i32(i32 78
+// CHECK-NOT: call i32 @dx.op.atomicBinOp.i32(i32 78
+// CHECK: br label
+
+
+float4 FlowControlPS(in uint value : value ) : SV_Target
+{
+  float4 ret = float4(0, 0, 0, 0);
+  if (value > 1) {
+    ret = float4(0, 0, 0, 2);
+  } else {
+    ret = float4(0, 0, 0, 1);
+  }
+  return ret;
+}
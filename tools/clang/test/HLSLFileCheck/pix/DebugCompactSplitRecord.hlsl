@@ -0,0 +1,32 @@
+// RUN: %dxc -Emain -Tcs_6_0 %s -Od | %opt -S -dxil-annotate-with-virtual-regs -hlsl-dxil-debug-instrumentation,compact=1 | %FileCheck %s
+
+// The single block here has more steps than fit in one record. Its first
+// record is as long as records get, 128 dwords, so it reserves 512 bytes and
+// its header is RecordType << 8 | 128 << 16, with RecordType 250:
+
+// CHECK: mul i32 512,
+// CHECK: call i32 @dx.op.atomicBinOp.i32(i32 78
+// CHECK: call void @dx.op.bufferStore.i32(i32 69, {{.*}}, i32 undef, i32 8452608, i32 undef, i32 undef, i32 undef, i8 1)
+
+// The steps that did not fit follow in a second record for the same block,
+// block 0, starting with the header and invocation UID:
+
+// CHECK: call i32 @dx.op.atomicBinOp.i32(i32 78
+// CHECK: call void @dx.op.bufferStore.i32(i32 69, {{.*}}, i32 undef, i32 {{[0-9]+}}, i32 undef, i32 undef, i32 undef, i8 1)
+// CHECK: call void @dx.op.bufferStore.i32(i32 69, {{.*}}, i32 undef, i32 %{{.*}}, i32 undef, i32 undef, i32 undef, i8 1)
+// CHECK: call void @dx.op.bufferStore.i32(i32 69, {{.*}}, i32 undef, i32 0, i32 undef, i32 undef, i32 undef, i8 1)
+// CHECK: ret void
+
+RWStructuredBuffer<float> buf : register(u0);
+
+#define STEP(i) v = v * v + buf[tid + i];
+#define STEP4(i) STEP(i) STEP(i + 1) STEP(i + 2) STEP(i + 3)
+#define STEP16(i) STEP4(i) STEP4(i + 4) STEP4(i + 8) STEP4(i + 12)
+
+[numthreads(1, 1, 1)]
+void main(uint tid : SV_DispatchThreadID)
+{
+  float v = buf[tid];
+  STEP16(0) STEP16(16) STEP16(32) STEP16(48)
+  buf[tid] = v;
+}
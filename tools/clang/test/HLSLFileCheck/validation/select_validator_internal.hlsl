@@ -0,0 +1,11 @@
+// RUN: %dxc -E main -T ps_6_0 -select-validator internal %s | FileCheck %s
+// RUN: %dxc -E main -T ps_6_0 -select-validator internal -Zi %s | FileCheck %s
+
+// Validation runs directly on the in-memory module and still reports errors.
+// CHECK: Instructions should not read uninitialized value
+
+float main(snorm float b : B) : SV_DEPTH
+{
+  float a;
+  return b + a;
+}
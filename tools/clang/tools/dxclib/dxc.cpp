@@ -204,6 +204,19 @@ static void WriteDxcOutputToFile(DXC_OUT_KIND kind, IDxcResult *pResult, UINT32
   }
 }
 
+// Writes the -ftime-report output to its -Ftr file, or to stderr.
+static void WriteDxcTimeReport(IDxcResult *pResult, UINT32 textCodePage) {
+  if (!pResult->HasOutput(DXC_OUT_TIME_REPORT))
+    return;
+  CComPtr<IDxcBlob> pData;
+  CComPtr<IDxcBlobUtf16> pName;
+  IFT(pResult->GetOutput(DXC_OUT_TIME_REPORT, IID_PPV_ARGS(&pData), &pName));
+  if (pName && pName->GetStringLength() > 0)
+    WriteBlobToFile(pData, pName->GetStringPointer(), textCodePage);
+  else
+    WriteBlobToConsole(pData, STD_ERROR_HANDLE);
+}
+
 static bool StringBlobEqualUtf16(IDxcBlobUtf16 *pBlob, const WCHAR *pStr) {
   size_t uSize = wcslen(pStr);
   if (pBlob && pBlob->GetStringLength() == uSize) {
@@ -810,6 +823,13 @@ int DxcContext::Compile() {
     WriteOperationErrorsToConsole(pCompileResult, m_Opts.OutputWarnings);
   }
 
+  // Time reports are written for failed compiles too.
+  if (m_Opts.TimeReport) {
+    CComPtr<IDxcResult> pResult;
+    if (SUCCEEDED(pCompileResult->QueryInterface(&pResult)))
+      WriteDxcTimeReport(pResult, m_Opts.DefaultTextCodePage);
+  }
+
   HRESULT status;
   IFT(pCompileResult->GetStatus(&status));
   if (SUCCEEDED(status) || m_Opts.AstDump || m_Opts.OptDump) {
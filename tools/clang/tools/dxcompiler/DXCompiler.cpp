@@ -47,12 +47,21 @@ void  __CRTDECL operator delete (void* ptr, const std::nothrow_t& nothrow_consta
 }
 #endif
 
+// Managed statics outlive the compile that first uses them, which may be
+// running on an arena (-arena-alloc) or a caller-provided allocator.
+static void *CreateManagedStaticWithDefaultMalloc(void *(*Creator)()) {
+  DxcThreadMalloc TM(nullptr);
+  return Creator();
+}
+
 static HRESULT InitMaybeFail() throw() {
   HRESULT hr;
   bool fsSetup = false, memSetup = false;
   IFC(DxcInitThreadMalloc());
   DxcSetThreadMallocToDefault();
   memSetup = true;
+  ::llvm::llvm_set_managed_static_creator_wrapper(
+      CreateManagedStaticWithDefaultMalloc);
   if (::llvm::sys::fs::SetupPerThreadFileSystem()) {
     hr = E_FAIL;
     goto Cleanup;
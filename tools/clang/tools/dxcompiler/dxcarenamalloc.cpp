@@ -0,0 +1,262 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// dxcarenamalloc.cpp                                                        //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Implements an arena allocator for the lifetime of a single compile.       //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/Support/WinIncludes.h"
+#include "dxc/Support/Global.h"
+#include "dxc/Support/microcom.h"
+#include "llvm/Support/Mutex.h"
+#include "dxcarenamalloc.h"
+#include <cstring>
+
+using namespace llvm;
+
+namespace {
+
+const size_t kChunkSize = 1024 * 1024;
+// Larger blocks get a chunk of their own so that they can be returned as soon
+// as they are freed; these are mostly buffers that grow by doubling.
+const size_t kMaxSmallBlockSize = kChunkSize / 4;
+// Block headers are padded to this size, which keeps blocks aligned as well
+// as the chunks pBacking returns.
+const size_t kHeaderSize = 16;
+
+struct ArenaBlockHeader {
+  size_t Size;
+};
+
+static_assert(sizeof(ArenaBlockHeader) <= kHeaderSize,
+              "block header too large");
+
+// The address range of a chunk taken from pBacking. Whether a block belongs
+// to the arena is decided by looking its address up in these, since blocks
+// pBacking allocated have no arena header to inspect.
+struct ArenaChunk {
+  char *Begin;
+  char *End;
+  bool Large;
+};
+
+size_t AlignSize(size_t cb) {
+  return (cb + kHeaderSize - 1) & ~(kHeaderSize - 1);
+}
+
+ArenaBlockHeader *GetHeader(void *pv) {
+  return (ArenaBlockHeader *)((char *)pv - kHeaderSize);
+}
+
+class DxcArenaMalloc : public IMalloc {
+private:
+  DXC_MICROCOM_TM_REF_FIELDS()
+  sys::Mutex m_Lock;
+  // Sorted by address. The array itself comes from pBacking, so that growing
+  // it never reenters the arena.
+  ArenaChunk *m_pChunks = nullptr;
+  size_t m_NumChunks = 0;
+  size_t m_ChunkCapacity = 0;
+  char *m_pCur = nullptr;
+  char *m_pEnd = nullptr;
+
+  void *InitBlock(char *pBlock, size_t cb) {
+    ((ArenaBlockHeader *)pBlock)->Size = cb;
+    return pBlock + kHeaderSize;
+  }
+
+  // Returns the index of the first chunk that starts after p.
+  size_t UpperBound(const void *p) {
+    size_t lo = 0, hi = m_NumChunks;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (m_pChunks[mid].Begin <= (const char *)p)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo;
+  }
+
+  // Returns the chunk that holds pv, or null if pBacking allocated it.
+  // Requires m_Lock.
+  ArenaChunk *FindChunk(void *pv) {
+    size_t i = UpperBound(pv);
+    if (i == 0 || (char *)pv >= m_pChunks[i - 1].End)
+      return nullptr;
+    return &m_pChunks[i - 1];
+  }
+
+  // Requires m_Lock.
+  char *NewChunk(size_t cb, bool large) {
+    if (m_NumChunks == m_ChunkCapacity) {
+      size_t newCapacity = m_ChunkCapacity ? m_ChunkCapacity * 2 : 64;
+      ArenaChunk *pNew = (ArenaChunk *)m_pMalloc->Realloc(
+          m_pChunks, newCapacity * sizeof(ArenaChunk));
+      if (pNew == nullptr)
+        return nullptr;
+      m_pChunks = pNew;
+      m_ChunkCapacity = newCapacity;
+    }
+    char *pChunk = (char *)m_pMalloc->Alloc(cb);
+    if (pChunk == nullptr)
+      return nullptr;
+    size_t i = UpperBound(pChunk);
+    memmove(m_pChunks + i + 1, m_pChunks + i,
+            (m_NumChunks - i) * sizeof(ArenaChunk));
+    m_pChunks[i].Begin = pChunk;
+    m_pChunks[i].End = pChunk + cb;
+    m_pChunks[i].Large = large;
+    ++m_NumChunks;
+    return pChunk;
+  }
+
+  // Requires m_Lock.
+  void FreeChunk(ArenaChunk *pChunk) {
+    m_pMalloc->Free(pChunk->Begin);
+    size_t i = pChunk - m_pChunks;
+    memmove(m_pChunks + i, m_pChunks + i + 1,
+            (m_NumChunks - i - 1) * sizeof(ArenaChunk));
+    --m_NumChunks;
+  }
+
+  void *AllocLarge(size_t cb) {
+    if (cb > SIZE_MAX - kHeaderSize)
+      return nullptr;
+    sys::ScopedLock Lock(m_Lock);
+    char *pChunk = NewChunk(cb + kHeaderSize, /*large*/ true);
+    if (pChunk == nullptr)
+      return nullptr;
+    return InitBlock(pChunk, cb);
+  }
+
+  // Grows the most recent small block in place if the chunk has room.
+  // Requires m_Lock.
+  bool TryExtend(void *pv, size_t cb) {
+    ArenaBlockHeader *pHeader = GetHeader(pv);
+    char *pBlockEnd = (char *)pv + AlignSize(pHeader->Size);
+    if (pBlockEnd != m_pCur ||
+        (size_t)(m_pEnd - (char *)pv) < AlignSize(cb))
+      return false;
+    m_pCur = (char *)pv + AlignSize(cb);
+    pHeader->Size = cb;
+    return true;
+  }
+
+public:
+  DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
+  DXC_MICROCOM_TM_CTOR(DxcArenaMalloc)
+
+  ~DxcArenaMalloc() {
+    for (size_t i = 0; i < m_NumChunks; ++i)
+      m_pMalloc->Free(m_pChunks[i].Begin);
+    m_pMalloc->Free(m_pChunks);
+  }
+
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid,
+                                           void **ppvObject) override {
+    return DoBasicQueryInterface<IMalloc>(this, iid, ppvObject);
+  }
+
+  void *STDMETHODCALLTYPE Alloc(SIZE_T cb) override {
+    if (cb > kMaxSmallBlockSize)
+      return AllocLarge(cb);
+    size_t needed = kHeaderSize + AlignSize(cb);
+    sys::ScopedLock Lock(m_Lock);
+    if ((size_t)(m_pEnd - m_pCur) < needed) {
+      char *pChunk = NewChunk(kChunkSize, /*large*/ false);
+      if (pChunk == nullptr)
+        return nullptr;
+      m_pCur = pChunk;
+      m_pEnd = pChunk + kChunkSize;
+    }
+    char *pBlock = m_pCur;
+    m_pCur += needed;
+    return InitBlock(pBlock, cb);
+  }
+
+  void *STDMETHODCALLTYPE Realloc(void *pv, SIZE_T cb) override {
+    if (pv == nullptr)
+      return Alloc(cb);
+    if (cb == 0) {
+      Free(pv);
+      return nullptr;
+    }
+    size_t oldSize;
+    {
+      sys::ScopedLock Lock(m_Lock);
+      ArenaChunk *pChunk = FindChunk(pv);
+      if (pChunk == nullptr)
+        return m_pMalloc->Realloc(pv, cb);
+      oldSize = GetHeader(pv)->Size;
+      if (cb <= oldSize) {
+        GetHeader(pv)->Size = cb;
+        return pv;
+      }
+      if (cb <= kMaxSmallBlockSize && !pChunk->Large && TryExtend(pv, cb))
+        return pv;
+    }
+    void *pNew = Alloc(cb);
+    if (pNew == nullptr)
+      return nullptr;
+    memcpy(pNew, pv, oldSize);
+    Free(pv);
+    return pNew;
+  }
+
+  void STDMETHODCALLTYPE Free(void *pv) override {
+    if (pv == nullptr)
+      return;
+    {
+      sys::ScopedLock Lock(m_Lock);
+      ArenaChunk *pChunk = FindChunk(pv);
+      if (pChunk != nullptr) {
+        if (pChunk->Large)
+          FreeChunk(pChunk);
+        return;
+      }
+    }
+    m_pMalloc->Free(pv);
+  }
+
+#ifdef _WIN32
+  SIZE_T STDMETHODCALLTYPE GetSize(void *pv) override {
+    if (pv == nullptr)
+      return 0;
+    {
+      sys::ScopedLock Lock(m_Lock);
+      if (FindChunk(pv) != nullptr)
+        return GetHeader(pv)->Size;
+    }
+    return m_pMalloc->GetSize(pv);
+  }
+  int STDMETHODCALLTYPE DidAlloc(void *pv) override {
+    if (pv == nullptr)
+      return 0;
+    sys::ScopedLock Lock(m_Lock);
+    return FindChunk(pv) != nullptr;
+  }
+  void STDMETHODCALLTYPE HeapMinimize() override {}
+#endif
+};
+
+} // namespace
+
+namespace dxcutil {
+
+HRESULT CreateArenaMalloc(IMalloc *pBacking, IMalloc **ppArena) {
+  if (pBacking == nullptr || ppArena == nullptr)
+    return E_INVALIDARG;
+  *ppArena = nullptr;
+  CComPtr<DxcArenaMalloc> pArena = DxcArenaMalloc::Alloc(pBacking);
+  if (pArena == nullptr)
+    return E_OUTOFMEMORY;
+  *ppArena = pArena.Detach();
+  return S_OK;
+}
+
+} // namespace dxcutil
@@ -0,0 +1,25 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// dxcarenamalloc.h                                                          //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Provides an arena allocator for the lifetime of a single compile.         //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "dxc/Support/WinIncludes.h"
+
+namespace dxcutil {
+
+// Creates an allocator that carves blocks out of large chunks taken from
+// pBacking. Freeing a block only returns memory to pBacking if the block was
+// big enough to get a chunk of its own; everything else is returned at once
+// when the arena is released. Blocks that pBacking allocated may also be
+// freed through the arena.
+HRESULT CreateArenaMalloc(IMalloc *pBacking, IMalloc **ppArena);
+
+} // namespace dxcutil
@@ -0,0 +1,515 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// dxccompilecache.cpp                                                       //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Implements the on-disk cache of compile results for dxcompiler.           //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/Support/WinIncludes.h"
+#include "dxc/Support/Global.h"
+#include "dxc/Support/Unicode.h"
+#include "dxc/Support/FileIOHelper.h"
+#include "dxc/Support/dxcapi.impl.h"
+#include "dxc/Support/dxcfilesystem.h"
+#include "dxc/Support/HLSLOptions.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Option/Arg.h"
+#include "llvm/Option/ArgList.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/MSFileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "dxccompilecache.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+using namespace llvm;
+using namespace hlsl;
+
+namespace {
+
+// Bump when the entry layout or the key composition changes.
+const uint32_t kCacheEntryMagic = DXC_FOURCC('D', 'X', 'C', 'C');
+const uint32_t kCacheEntryVersion = 2;
+
+const char kEntryExtension[] = ".dxcc";
+const char kTempExtension[] = ".tmp";
+const char kStatsFileName[] = "stats.txt";
+
+// Temporary files older than this are assumed to belong to a process that
+// died before publishing its entry.
+const uint64_t kStaleTempSeconds = 60 * 60;
+
+struct CacheEntryHeader {
+  uint32_t Magic;
+  uint32_t Version;
+  uint32_t PayloadSize;
+  uint8_t PayloadHash[16];
+};
+
+// Installs a disk file system for the current thread for the duration of a
+// cache operation; the compile may have its own file system installed.
+class DiskFileSystemScope {
+  std::unique_ptr<sys::fs::MSFileSystem> m_pFS;
+  std::unique_ptr<sys::fs::AutoPerThreadSystem> m_pPTS;
+
+public:
+  DiskFileSystemScope() {
+    sys::fs::MSFileSystem *pFS;
+    if (FAILED(CreateMSFileSystemForDisk(&pFS)))
+      return;
+    m_pFS.reset(pFS);
+    m_pPTS.reset(new sys::fs::AutoPerThreadSystem(pFS));
+  }
+  bool IsValid() const { return m_pPTS && !m_pPTS->error_code(); }
+};
+
+class PayloadWriter {
+  std::string m_Data;
+
+public:
+  void WriteUInt32(uint32_t Value) {
+    m_Data.append((const char *)&Value, sizeof(Value));
+  }
+  void WriteBytes(const void *pData, size_t Size) {
+    WriteUInt32((uint32_t)Size);
+    m_Data.append((const char *)pData, Size);
+  }
+  void WriteString(StringRef Str) { WriteBytes(Str.data(), Str.size()); }
+  void WriteHash(const MD5::MD5Result &Hash) {
+    m_Data.append((const char *)Hash, sizeof(Hash));
+  }
+  const std::string &GetData() const { return m_Data; }
+};
+
+class PayloadReader {
+  StringRef m_Data;
+
+public:
+  PayloadReader(StringRef Data) : m_Data(Data) {}
+  bool ReadUInt32(uint32_t &Value) {
+    if (m_Data.size() < sizeof(Value))
+      return false;
+    memcpy(&Value, m_Data.data(), sizeof(Value));
+    m_Data = m_Data.drop_front(sizeof(Value));
+    return true;
+  }
+  bool ReadBytes(StringRef &Bytes) {
+    uint32_t Size;
+    if (!ReadUInt32(Size) || m_Data.size() < Size)
+      return false;
+    Bytes = m_Data.substr(0, Size);
+    m_Data = m_Data.drop_front(Size);
+    return true;
+  }
+  bool ReadHash(MD5::MD5Result &Hash) {
+    if (m_Data.size() < sizeof(Hash))
+      return false;
+    memcpy(Hash, m_Data.data(), sizeof(Hash));
+    m_Data = m_Data.drop_front(sizeof(Hash));
+    return true;
+  }
+  bool AtEnd() const { return m_Data.empty(); }
+};
+
+void HashUtf8Blob(IDxcBlobUtf8 *pBlob, MD5::MD5Result &Hash) {
+  MD5 Hasher;
+  Hasher.update(StringRef(pBlob->GetStringPointer(), pBlob->GetStringLength()));
+  Hasher.final(Hash);
+}
+
+bool IsSameHash(const MD5::MD5Result &LHS, const MD5::MD5Result &RHS) {
+  return 0 == memcmp(LHS, RHS, sizeof(MD5::MD5Result));
+}
+
+// Writes Data to a uniquely named temporary file next to Path and renames it
+// into place, so concurrent readers only ever observe complete files.
+bool WriteFileAtomically(StringRef Path, StringRef Data) {
+  int FD;
+  SmallString<128> TempPath;
+  if (sys::fs::createUniqueFile(Path + "-%%%%%%%%" + kTempExtension, FD,
+                                TempPath))
+    return false;
+  bool Written;
+  {
+    raw_fd_ostream OS(FD, /*shouldClose*/ true);
+    OS << Data;
+    OS.close();
+    Written = !OS.has_error();
+    OS.clear_error();
+  }
+  if (!Written || sys::fs::rename(TempPath, Path)) {
+    sys::fs::remove(TempPath);
+    return false;
+  }
+  return true;
+}
+
+struct BuildId {
+  bool Valid;
+  MD5::MD5Result Hash;
+};
+
+// Identifies the binary this code is running from by the hash of its file, so
+// results are only reused by the exact compiler that produced them, however
+// it was built. Holds no heap memory, since it lives for the whole process.
+BuildId ComputeBuildId() {
+  BuildId Id = {};
+  std::string ModulePath;
+#ifdef _WIN32
+  HMODULE hModule;
+  wchar_t Path[MAX_PATH];
+  if (GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                             GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                         (LPCWSTR)&ComputeBuildId, &hModule)) {
+    DWORD Size = GetModuleFileNameW(hModule, Path, _countof(Path));
+    if (Size > 0 && Size < _countof(Path))
+      Unicode::UTF16ToUTF8String(Path, &ModulePath);
+  }
+#else
+  Dl_info Info;
+  if (dladdr((void *)&ComputeBuildId, &Info) && Info.dli_fname)
+    ModulePath = Info.dli_fname;
+#endif
+  if (ModulePath.empty())
+    return Id;
+
+  DiskFileSystemScope FS;
+  if (!FS.IsValid())
+    return Id;
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer = MemoryBuffer::getFile(
+      ModulePath, -1, /*RequiresNullTerminator*/ false);
+  if (!Buffer)
+    return Id;
+  MD5 Hasher;
+  Hasher.update((*Buffer)->getBuffer());
+  Hasher.final(Id.Hash);
+  Id.Valid = true;
+  return Id;
+}
+
+void TouchFile(StringRef Path) {
+  int FD;
+  if (sys::fs::openFileForWrite(Path, FD, sys::fs::F_Append))
+    return;
+  sys::fs::setLastModificationAndAccessTime(FD, sys::TimeValue::now());
+  sys::fs::msf_close(FD);
+}
+
+} // namespace
+
+namespace dxcutil {
+
+CompileCache::CompileCache(StringRef Dir, unsigned MaxSizeInMB)
+    : m_Dir(Dir), m_MaxSize((uint64_t)MaxSizeInMB * 1024 * 1024),
+      m_bEnabled(false) {
+  uint32_t Header[] = {kCacheEntryMagic, kCacheEntryVersion};
+  m_KeyHash.update(ArrayRef<uint8_t>((const uint8_t *)Header, sizeof(Header)));
+  // Hashing the binary takes a moment, so it is only done once.
+  static const BuildId Id = ComputeBuildId();
+  if (Id.Valid) {
+    AddToKey(StringRef((const char *)Id.Hash, sizeof(Id.Hash)));
+    m_bEnabled = true;
+  }
+}
+
+void CompileCache::AddToKey(StringRef Data) {
+  DXASSERT(m_EntryPath.empty(), "else key changed after it was used");
+  uint32_t Size = Data.size();
+  m_KeyHash.update(ArrayRef<uint8_t>((const uint8_t *)&Size, sizeof(Size)));
+  m_KeyHash.update(Data);
+}
+
+void CompileCache::AddArgsToKey(const opt::InputArgList &Args) {
+  for (const opt::Arg *A : Args) {
+    // The cache settings do not affect the result.
+    if (A->getOption().matches(options::OPT_cache_dir) ||
+        A->getOption().matches(options::OPT_cache_max_size))
+      continue;
+    AddToKey(A->getSpelling());
+    for (const char *Value : A->getValues())
+      AddToKey(Value);
+  }
+}
+
+const std::string &CompileCache::GetEntryPath() {
+  if (m_EntryPath.empty()) {
+    MD5::MD5Result Hash;
+    m_KeyHash.final(Hash);
+    SmallString<32> HashStr;
+    MD5::stringifyResult(Hash, HashStr);
+    SmallString<128> Path(m_Dir);
+    sys::path::append(Path, Twine(HashStr) + kEntryExtension);
+    m_EntryPath = Path.str();
+  }
+  return m_EntryPath;
+}
+
+bool CompileCache::Lookup(IDxcIncludeHandler *pIncludeHandler,
+                          DxcResult *pResult) {
+  if (!m_bEnabled)
+    return false;
+  DiskFileSystemScope FS;
+  if (!FS.IsValid())
+    return false;
+
+  if (sys::fs::create_directories(m_Dir))
+    return false;
+
+  const std::string &EntryPath = GetEntryPath();
+  bool Hit = false;
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer =
+      MemoryBuffer::getFile(EntryPath, -1, /*RequiresNullTerminator*/ false);
+  if (Buffer) {
+    Hit = ReadEntry((*Buffer)->getBuffer(), pIncludeHandler, pResult);
+    if (Hit) {
+      TouchFile(EntryPath);
+    } else {
+      pResult->ClearAllOutputs();
+    }
+  }
+  UpdateStats(Hit ? 1 : 0, Hit ? 0 : 1, 0, 0);
+  return Hit;
+}
+
+bool CompileCache::ReadEntry(StringRef Data,
+                             IDxcIncludeHandler *pIncludeHandler,
+                             DxcResult *pResult) {
+  CacheEntryHeader Header;
+  if (Data.size() < sizeof(Header))
+    return false;
+  memcpy(&Header, Data.data(), sizeof(Header));
+  StringRef Payload = Data.drop_front(sizeof(Header));
+  if (Header.Magic != kCacheEntryMagic ||
+      Header.Version != kCacheEntryVersion ||
+      Header.PayloadSize != Payload.size())
+    return false;
+  MD5::MD5Result PayloadHash;
+  MD5 Hasher;
+  Hasher.update(Payload);
+  Hasher.final(PayloadHash);
+  if (!IsSameHash(PayloadHash, Header.PayloadHash))
+    return false;
+
+  PayloadReader Reader(Payload);
+
+  // Every include must still resolve the way it did when the entry was made.
+  uint32_t NumDeps;
+  if (!Reader.ReadUInt32(NumDeps))
+    return false;
+  for (uint32_t i = 0; i < NumDeps; ++i) {
+    uint32_t Found;
+    StringRef Name;
+    if (!Reader.ReadUInt32(Found) || !Reader.ReadBytes(Name))
+      return false;
+    MD5::MD5Result RecordedHash;
+    if (Found && !Reader.ReadHash(RecordedHash))
+      return false;
+    if (pIncludeHandler == nullptr)
+      return false;
+    std::wstring WideName = Unicode::UTF8ToUTF16StringOrThrow(Name.str().c_str());
+    CComPtr<IDxcBlob> pBlob;
+    HRESULT hr = pIncludeHandler->LoadSource(WideName.c_str(), &pBlob);
+    bool IsFound = SUCCEEDED(hr) && pBlob != nullptr;
+    if (IsFound != (Found != 0))
+      return false;
+    if (IsFound) {
+      CComPtr<IDxcBlobUtf8> pUtf8Blob;
+      if (FAILED(DxcGetBlobAsUtf8(pBlob, DxcGetThreadMallocNoRef(), &pUtf8Blob)))
+        return false;
+      MD5::MD5Result CurrentHash;
+      HashUtf8Blob(pUtf8Blob, CurrentHash);
+      if (!IsSameHash(CurrentHash, RecordedHash))
+        return false;
+    }
+  }
+
+  uint32_t PrimaryKind, NumOutputs;
+  if (!Reader.ReadUInt32(PrimaryKind) || !Reader.ReadUInt32(NumOutputs))
+    return false;
+  for (uint32_t i = 0; i < NumOutputs; ++i) {
+    uint32_t Kind, CodePage;
+    StringRef Name, Bytes;
+    if (!Reader.ReadUInt32(Kind) || !Reader.ReadUInt32(CodePage) ||
+        !Reader.ReadBytes(Name) || !Reader.ReadBytes(Bytes))
+      return false;
+    if (Kind <= DXC_OUT_NONE || Kind > kNumDxcOutputTypes)
+      return false;
+    CComPtr<IDxcBlob> pBlob;
+    if (DxcGetOutputType((DXC_OUT_KIND)Kind) == DxcOutputType_Text) {
+      CComPtr<IDxcBlobEncoding> pText;
+      IFT(DxcCreateBlobWithEncodingOnHeapCopy(Bytes.data(), Bytes.size(),
+                                              CodePage, &pText));
+      pBlob = pText;
+    } else {
+      IFT(DxcCreateBlobOnHeapCopy(Bytes.data(), Bytes.size(), &pBlob));
+    }
+    IFT(pResult->SetOutputObject((DXC_OUT_KIND)Kind, pBlob));
+    if (!Name.empty())
+      IFT(pResult->SetOutputName((DXC_OUT_KIND)Kind, Name));
+  }
+  if (!Reader.AtEnd() || PrimaryKind > kNumDxcOutputTypes)
+    return false;
+  IFT(pResult->SetStatusAndPrimaryResult(S_OK, (DXC_OUT_KIND)PrimaryKind));
+  return true;
+}
+
+void CompileCache::Store(ArrayRef<DxcIncludeDependency> Deps,
+                         DxcResult *pResult) {
+  HRESULT Status;
+  if (!m_bEnabled || FAILED(pResult->GetStatus(&Status)) || FAILED(Status))
+    return;
+
+  PayloadWriter Writer;
+  Writer.WriteUInt32(Deps.size());
+  for (const DxcIncludeDependency &Dep : Deps) {
+    Writer.WriteUInt32(Dep.Content != nullptr);
+    Writer.WriteString(Unicode::UTF16ToUTF8StringOrThrow(Dep.Name.c_str()));
+    if (Dep.Content != nullptr) {
+      MD5::MD5Result Hash;
+      HashUtf8Blob(Dep.Content, Hash);
+      Writer.WriteHash(Hash);
+    }
+  }
+
+  Writer.WriteUInt32(pResult->PrimaryOutput());
+  Writer.WriteUInt32(pResult->GetNumOutputs());
+  for (unsigned i = 1; i <= kNumDxcOutputTypes; ++i) {
+    DXC_OUT_KIND Kind = (DXC_OUT_KIND)i;
+    if (!pResult->HasOutput(Kind))
+      continue;
+    CComPtr<IDxcBlob> pBlob;
+    CComPtr<IDxcBlobUtf16> pName;
+    // Outputs that are not blobs, such as extra outputs, cannot be stored.
+    if (FAILED(pResult->GetOutput(Kind, IID_PPV_ARGS(&pBlob), &pName)))
+      return;
+    UINT32 CodePage = DXC_CP_ACP;
+    CComPtr<IDxcBlobEncoding> pEncoding;
+    BOOL Known = FALSE;
+    if (SUCCEEDED(pBlob.QueryInterface(&pEncoding)) &&
+        SUCCEEDED(pEncoding->GetEncoding(&Known, &CodePage)) && !Known)
+      CodePage = DXC_CP_ACP;
+    Writer.WriteUInt32(Kind);
+    Writer.WriteUInt32(CodePage);
+    Writer.WriteString(pName ? Unicode::UTF16ToUTF8StringOrThrow(
+                                   pName->GetStringPointer())
+                             : std::string());
+    Writer.WriteBytes(pBlob->GetBufferPointer(), pBlob->GetBufferSize());
+  }
+
+  const std::string &Payload = Writer.GetData();
+  CacheEntryHeader Header;
+  Header.Magic = kCacheEntryMagic;
+  Header.Version = kCacheEntryVersion;
+  Header.PayloadSize = Payload.size();
+  MD5 Hasher;
+  Hasher.update(Payload);
+  Hasher.final(Header.PayloadHash);
+
+  std::string Entry((const char *)&Header, sizeof(Header));
+  Entry += Payload;
+
+  DiskFileSystemScope FS;
+  if (!FS.IsValid() || !WriteFileAtomically(GetEntryPath(), Entry))
+    return;
+  unsigned Evicted = EvictIfNeeded();
+  UpdateStats(0, 0, 1, Evicted);
+}
+
+// Removes the least recently used entries until the directory is at 90% of
+// the size limit. Entries being read by other processes may fail to delete;
+// they are simply retried on a later store.
+unsigned CompileCache::EvictIfNeeded() {
+  struct EntryInfo {
+    std::string Path;
+    uint64_t Size;
+    sys::TimeValue LastUsed;
+  };
+  std::vector<EntryInfo> Entries;
+  uint64_t TotalSize = 0;
+  sys::TimeValue Now = sys::TimeValue::now();
+  std::error_code EC;
+  for (sys::fs::directory_iterator It(m_Dir, EC), End; It != End && !EC;
+       It.increment(EC)) {
+    sys::fs::file_status Status;
+    if (It->status(Status) || !sys::fs::is_regular_file(Status))
+      continue;
+    StringRef Ext = sys::path::extension(It->path());
+    if (Ext == kTempExtension) {
+      if ((Now - Status.getLastModificationTime()).seconds() >
+          (int64_t)kStaleTempSeconds)
+        sys::fs::remove(It->path());
+      continue;
+    }
+    if (Ext != kEntryExtension)
+      continue;
+    Entries.push_back({It->path(), Status.getSize(),
+                       Status.getLastModificationTime()});
+    TotalSize += Status.getSize();
+  }
+  if (TotalSize <= m_MaxSize)
+    return 0;
+
+  std::sort(Entries.begin(), Entries.end(),
+            [](const EntryInfo &LHS, const EntryInfo &RHS) {
+              return LHS.LastUsed < RHS.LastUsed;
+            });
+  uint64_t TargetSize = m_MaxSize / 10 * 9;
+  unsigned Evicted = 0;
+  for (const EntryInfo &E : Entries) {
+    if (TotalSize <= TargetSize)
+      break;
+    if (E.Path == m_EntryPath || sys::fs::remove(E.Path))
+      continue;
+    TotalSize -= E.Size;
+    ++Evicted;
+  }
+  return Evicted;
+}
+
+// Accumulates hit/miss/store/eviction counts in a text file in the cache
+// directory. Concurrent updates may lose counts; the numbers are a guide to
+// the cache's effectiveness, not an exact record.
+void CompileCache::UpdateStats(unsigned Hits, unsigned Misses, unsigned Stores,
+                               unsigned Evictions) {
+  const char *Names[] = {"hits", "misses", "stores", "evictions"};
+  uint64_t Counts[] = {0, 0, 0, 0};
+  SmallString<128> StatsPath(m_Dir);
+  sys::path::append(StatsPath, kStatsFileName);
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer = MemoryBuffer::getFile(StatsPath);
+  if (Buffer) {
+    SmallVector<StringRef, 4> Lines;
+    (*Buffer)->getBuffer().split(Lines, "\n", -1, false);
+    for (StringRef Line : Lines) {
+      std::pair<StringRef, StringRef> NameValue = Line.split(' ');
+      for (unsigned i = 0; i < array_lengthof(Names); ++i) {
+        if (NameValue.first == Names[i])
+          NameValue.second.trim().getAsInteger(10, Counts[i]);
+      }
+    }
+  }
+  Counts[0] += Hits;
+  Counts[1] += Misses;
+  Counts[2] += Stores;
+  Counts[3] += Evictions;
+
+  std::string Stats;
+  raw_string_ostream OS(Stats);
+  for (unsigned i = 0; i < array_lengthof(Names); ++i)
+    OS << Names[i] << ' ' << Counts[i] << '\n';
+  OS.flush();
+  WriteFileAtomically(StatsPath, Stats);
+}
+
+} // namespace dxcutil
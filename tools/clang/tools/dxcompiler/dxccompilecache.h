@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// dxccompilecache.h                                                         //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Provides an on-disk cache of compile results for dxcompiler.              //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "dxc/dxcapi.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MD5.h"
+#include <string>
+
+class DxcResult;
+
+namespace llvm {
+namespace opt {
+class InputArgList;
+}
+} // namespace llvm
+
+namespace dxcutil {
+
+struct DxcIncludeDependency;
+
+// Content-addressed cache of successful compile results kept in a directory.
+//
+// An entry is keyed on everything that determines the result apart from the
+// include files: the hash of the compiler binary, the validator version, the
+// parsed arguments, the main source and any language extension state added
+// by the caller. If the compiler binary cannot be read, nothing is cached. The
+// include files read during the compile, and the include probes that failed,
+// are recorded in the entry and re-resolved through the include handler on
+// lookup, so editing a header invalidates the entry without preprocessing.
+//
+// Entries are published with an atomic rename, so any number of processes
+// may share a directory. Lookups refresh the entry's modification time, and
+// stores evict the least recently used entries once the directory grows past
+// the size limit.
+class CompileCache {
+public:
+  CompileCache(llvm::StringRef Dir, unsigned MaxSizeInMB);
+
+  void AddToKey(llvm::StringRef Data);
+  void AddArgsToKey(const llvm::opt::InputArgList &Args);
+
+  // Fills pResult and returns true if there is an entry for the key whose
+  // recorded includes still resolve to the same contents.
+  bool Lookup(_In_opt_ IDxcIncludeHandler *pIncludeHandler,
+              _In_ DxcResult *pResult);
+
+  // Stores the outputs of pResult under the key. Only successful results are
+  // stored; I/O failures are ignored, since the cache is only an accelerator.
+  void Store(llvm::ArrayRef<DxcIncludeDependency> Deps,
+             _In_ DxcResult *pResult);
+
+private:
+  std::string m_Dir;
+  uint64_t m_MaxSize;
+  bool m_bEnabled;
+  llvm::MD5 m_KeyHash;
+  std::string m_EntryPath;
+
+  const std::string &GetEntryPath();
+  bool ReadEntry(llvm::StringRef Data, IDxcIncludeHandler *pIncludeHandler,
+                 DxcResult *pResult);
+  unsigned EvictIfNeeded();
+  void UpdateStats(unsigned Hits, unsigned Misses, unsigned Stores,
+                   unsigned Evictions);
+};
+
+} // namespace dxcutil
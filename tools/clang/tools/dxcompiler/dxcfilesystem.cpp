@@ -20,6 +20,7 @@
 #include "dxc/Support/dxcfilesystem.h"
 #include "dxc/Support/Unicode.h"
 #include "clang/Frontend/CompilerInstance.h"
+#include <algorithm>
 
 #ifndef _WIN32
 #include <sys/stat.h>
@@ -241,6 +242,8 @@ private:
       : Blob(pBlob), BlobStream(pStream), Name(name) { }
   };
   llvm::SmallVector<IncludedFile, 4> m_includedFiles;
+  // Names the include handler could not provide, in probe order.
+  std::vector<std::wstring> m_missingFiles;
 
   static bool IsDirOf(LPCWSTR lpDir, size_t dirLen, const std::wstring &fileName) {
     if (fileName.size() <= dirLen) return false;
@@ -276,6 +279,12 @@ private:
     }
     return INVALID_HANDLE_VALUE;
   }
+  void RecordMissingFile(LPCWSTR lpFileName) {
+    if (std::find(m_missingFiles.begin(), m_missingFiles.end(), lpFileName) ==
+        m_missingFiles.end()) {
+      m_missingFiles.emplace_back(lpFileName);
+    }
+  }
   DWORD TryFindOrOpen(LPCWSTR lpFileName, size_t &index) {
     for (size_t i = 0; i < m_includedFiles.size(); ++i) {
       if (0 == wcscmp(lpFileName, m_includedFiles[i].Name.data())) {
@@ -292,6 +301,7 @@ private:
       CComPtr<::IDxcBlob> fileBlob;
       HRESULT hr = m_includeLoader->LoadSource(lpFileName, &fileBlob);
       if (FAILED(hr)) {
+        RecordMissingFile(lpFileName);
         return ERROR_UNHANDLED_EXCEPTION;
       }
       if (fileBlob.p != nullptr) {
@@ -319,6 +329,7 @@ private:
         }
         return ERROR_SUCCESS;
       }
+      RecordMissingFile(lpFileName);
     }
     return ERROR_NOT_FOUND;
   }
@@ -414,6 +425,16 @@ public:
     return S_OK;
   }
 
+  void GetIncludeDependencies(std::vector<DxcIncludeDependency> &deps) override {
+    // Entry 0 is the main source, which was not loaded through the handler.
+    for (size_t i = 1; i < m_includedFiles.size(); ++i) {
+      deps.push_back({m_includedFiles[i].Name, m_includedFiles[i].Blob});
+    }
+    for (const std::wstring &name : m_missingFiles) {
+      deps.push_back({name, nullptr});
+    }
+  }
+
   ~DxcArgsFileSystemImpl() override { };
   BOOL FindNextFileW(
     _In_   HANDLE hFindFile,
@@ -31,7 +31,7 @@ using namespace hlsl;
 #ifdef _WIN32
 // Temporary: Define these here until a better header location is found.
 namespace hlsl {
-HRESULT CreateDxilShaderReflection(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject);
+HRESULT CreateDxilShaderReflection(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, const DxilPartHeader *pTablesPart, REFIID iid, void **ppvObject);
 HRESULT CreateDxilLibraryReflection(const DxilPartHeader *pModulePart, const DxilPartHeader *pRDATPart, REFIID iid, void **ppvObject);
 }
 #endif
@@ -354,6 +354,7 @@ public:
       CComPtr<IDxcBlob> pPdbContainerBlob;
       const DxilPartHeader *pModulePart = nullptr;
       const DxilPartHeader *pRDATPart = nullptr;
+      const DxilPartHeader *pTablesPart = nullptr;
 
       const DxilContainerHeader *pHeader = IsDxilContainerLike(pData->Ptr, pData->Size);
       if (!pHeader) {
@@ -393,6 +394,10 @@ public:
             IFRBOOL(!pRDATPart, DXC_E_DUPLICATE_PART);  // Should only be one
             pRDATPart = pPart;
             break;
+          case DFCC_ReflectionTables:
+            IFRBOOL(!pTablesPart, DXC_E_DUPLICATE_PART);  // Should only be one
+            pTablesPart = pPart;
+            break;
           }
         }
 
@@ -412,15 +417,22 @@ public:
           return E_INVALIDARG;
         pModulePart = pPart;
         UINT32 SizeRemaining = pData->Size - (sizeof(DxilPartHeader) + pPart->PartSize);
-        if (SizeRemaining > sizeof(DxilPartHeader)) {
-          // Looks like we also have an RDAT part
+        while (SizeRemaining > sizeof(DxilPartHeader)) {
+          // Looks like we also have an RDAT or reflection tables part
           pPart = (DxilPartHeader*)(GetDxilPartData(pPart) + pPart->PartSize);
           if (pPart->PartSize < /*sizeof(RuntimeDataHeader)*/8 ||
               pPart->PartSize + sizeof(DxilPartHeader) > SizeRemaining)
             return E_INVALIDARG;
-          if (pPart->PartFourCC != DFCC_RuntimeData)
+          if (pPart->PartFourCC == DFCC_RuntimeData) {
+            IFRBOOL(!pRDATPart, DXC_E_DUPLICATE_PART);  // Should only be one
+            pRDATPart = pPart;
+          } else if (pPart->PartFourCC == DFCC_ReflectionTables) {
+            IFRBOOL(!pTablesPart, DXC_E_DUPLICATE_PART);  // Should only be one
+            pTablesPart = pPart;
+          } else {
             return E_INVALIDARG;
-          pRDATPart = pPart;
+          }
+          SizeRemaining -= sizeof(DxilPartHeader) + pPart->PartSize;
         }
       }
 
@@ -451,7 +463,7 @@ public:
       if (bIsLibrary) {
         IFR(hlsl::CreateDxilLibraryReflection(pModulePart, pRDATPart, iid, ppvReflection));
       } else {
-        IFR(hlsl::CreateDxilShaderReflection(pModulePart, pRDATPart, iid, ppvReflection));
+        IFR(hlsl::CreateDxilShaderReflection(pModulePart, pRDATPart, pTablesPart, iid, ppvReflection));
       }
 
       return S_OK;
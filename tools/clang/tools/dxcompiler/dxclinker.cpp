@@ -14,6 +14,7 @@
 #include "dxc/Support/ErrorCodes.h"
 #include "dxc/Support/Global.h"
 #include "dxc/Support/FileIOHelper.h"
+#include "dxc/Support/WorkerThreads.h"
 #include "dxc/Support/dxcapi.impl.h"
 #include "dxc/Support/microcom.h"
 #include "dxc/dxcapi.h"
@@ -21,6 +22,8 @@
 
 #include "llvm/ADT/SmallVector.h"
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "dxc/HLSL/DxilLinker.h"
 #include "dxc/HLSL/DxilValidation.h"
@@ -43,7 +46,9 @@ using namespace llvm;
 // This declaration is used for the locally-linked validator.
 HRESULT CreateDxcValidator(_In_ REFIID riid, _Out_ LPVOID *ppv);
 
-class DxcLinker : public IDxcLinker, public IDxcContainerEvent {
+class DxcLinker : public IDxcLinker,
+                  public IDxcLinkerBatch,
+                  public IDxcContainerEvent {
 public:
   DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
   DXC_MICROCOM_TM_CTOR(DxcLinker)
@@ -69,6 +74,14 @@ public:
           *ppResult // Linker output status, buffer, and errors
   ) override;
 
+  // Links a batch of jobs on a pool of worker threads.
+  HRESULT STDMETHODCALLTYPE LinkBatch(
+      _In_count_(jobCount) const DxcLinkJob *pJobs, // Jobs to link
+      _In_ UINT32 jobCount,                         // Number of jobs
+      _In_ UINT32 threadCount, // Maximum worker threads; 0 for one per hardware thread
+      _In_ IDxcLinkBatchCallback *pCallback // Receives each result
+  ) override;
+
   HRESULT STDMETHODCALLTYPE RegisterDxilContainerEventHandler(
       IDxcContainerEventsHandler *pHandler, UINT64 *pCookie) override {
     DxcThreadMalloc TM(m_pMalloc);
@@ -88,7 +101,8 @@ public:
   }
 
   HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void **ppvObject) {
-    return DoBasicQueryInterface<IDxcLinker>(this, riid, ppvObject);
+    return DoBasicQueryInterface<IDxcLinker, IDxcLinkerBatch>(this, riid,
+                                                              ppvObject);
   }
 
   void Initialize() {
@@ -107,23 +121,22 @@ private:
   LLVMContext m_Ctx;
   std::unique_ptr<DxilLinker> m_pLinker;
   CComPtr<IDxcContainerEventsHandler> m_pDxcContainerEventsHandler;
-  std::vector<CComPtr<IDxcBlob>> m_blobs; // Keep blobs live for lazy load.
+  // Registered library names and blobs. Keeps blobs live for lazy load, and
+  // lets batch workers load the libraries into their own contexts.
+  std::vector<std::pair<std::string, CComPtr<IDxcBlob>>> m_libs;
+
+  HRESULT LinkWithLinker(DxilLinker &Linker, LLVMContext &Ctx,
+                         LPCWSTR pEntryName, LPCWSTR pTargetProfile,
+                         const LPCWSTR *pLibNames, UINT32 libCount,
+                         const LPCWSTR *pArguments, UINT32 argCount,
+                         IDxcOperationResult **ppResult);
+  HRESULT RegisterJobLibraries(DxilLinker &Linker, LLVMContext &Ctx,
+                               const DxcLinkJob &job);
 };
 
-HRESULT
-DxcLinker::RegisterLibrary(_In_opt_ LPCWSTR pLibName, // Name of the library.
-                           _In_ IDxcBlob *pBlob       // Library to add.
-) {
-  if (!pLibName || !pBlob)
-    return E_INVALIDARG;
-  DXASSERT(m_pLinker.get(), "else Initialize() not called or failed silently");
-  DxcThreadMalloc TM(m_pMalloc);
-  // Prepare UTF8-encoded versions of API values.
-  CW2A pUtf8LibName(pLibName, CP_UTF8);
-  // Already exist lib with same name.
-  if (m_pLinker->HasLibNameRegistered(pUtf8LibName.m_psz))
-    return E_INVALIDARG;
-
+// Loads a library lazily into Ctx and registers it with Linker.
+static HRESULT RegisterLibraryBlob(DxilLinker &Linker, LLVMContext &Ctx,
+                                   StringRef name, IDxcBlob *pBlob) {
   try {
     std::unique_ptr<llvm::Module> pModule, pDebugModule;
 
@@ -137,20 +150,41 @@ DxcLinker::RegisterLibrary(_In_opt_ LPCWSTR pLibName, // Name of the library.
 
     IFR(ValidateLoadModuleFromContainerLazy(
         pBlob->GetBufferPointer(), pBlob->GetBufferSize(), pModule,
-        pDebugModule, m_Ctx, m_Ctx, DiagStream));
+        pDebugModule, Ctx, Ctx, DiagStream));
 
-    if (m_pLinker->RegisterLib(pUtf8LibName.m_psz, std::move(pModule),
-                               std::move(pDebugModule))) {
-      m_blobs.emplace_back(pBlob);
+    if (Linker.RegisterLib(name, std::move(pModule), std::move(pDebugModule)))
       return S_OK;
-    } else {
-      return E_INVALIDARG;
-    }
+    return E_INVALIDARG;
   } catch (hlsl::Exception &) {
     return E_INVALIDARG;
   }
 }
 
+HRESULT
+DxcLinker::RegisterLibrary(_In_opt_ LPCWSTR pLibName, // Name of the library.
+                           _In_ IDxcBlob *pBlob       // Library to add.
+) {
+  if (!pLibName || !pBlob)
+    return E_INVALIDARG;
+  DXASSERT(m_pLinker.get(), "else Initialize() not called or failed silently");
+  DxcThreadMalloc TM(m_pMalloc);
+  // Prepare UTF8-encoded versions of API values.
+  CW2A pUtf8LibName(pLibName, CP_UTF8);
+  // Already exist lib with same name.
+  if (m_pLinker->HasLibNameRegistered(pUtf8LibName.m_psz))
+    return E_INVALIDARG;
+
+  HRESULT hr =
+      RegisterLibraryBlob(*m_pLinker, m_Ctx, pUtf8LibName.m_psz, pBlob);
+  if (SUCCEEDED(hr)) {
+    try {
+      m_libs.emplace_back(pUtf8LibName.m_psz, pBlob);
+    }
+    CATCH_CPP_ASSIGN_HRESULT();
+  }
+  return hr;
+}
+
 // Links the shader and produces a shader blob that the Direct3D runtime can
 // use.
 HRESULT STDMETHODCALLTYPE DxcLinker::Link(
@@ -168,6 +202,15 @@ HRESULT STDMETHODCALLTYPE DxcLinker::Link(
   if (!pTargetProfile || !pLibNames || libCount == 0 || !ppResult)
     return E_INVALIDARG;
   DxcThreadMalloc TM(m_pMalloc);
+  return LinkWithLinker(*m_pLinker, m_Ctx, pEntryName, pTargetProfile,
+                        pLibNames, libCount, pArguments, argCount, ppResult);
+}
+
+HRESULT DxcLinker::LinkWithLinker(DxilLinker &Linker, LLVMContext &Ctx,
+                                  LPCWSTR pEntryName, LPCWSTR pTargetProfile,
+                                  const LPCWSTR *pLibNames, UINT32 libCount,
+                                  const LPCWSTR *pArguments, UINT32 argCount,
+                                  IDxcOperationResult **ppResult) {
   // Prepare UTF8-encoded versions of API values.
   CW2A pUtf8TargetProfile(pTargetProfile, CP_UTF8);
   CW2A pUtf8EntryPoint(pEntryName, CP_UTF8);
@@ -175,7 +218,7 @@ HRESULT STDMETHODCALLTYPE DxcLinker::Link(
   CComPtr<AbstractMemoryStream> pOutputStream;
 
   // Detach previous libraries.
-  m_pLinker->DetachAll();
+  Linker.DetachAll();
 
   HRESULT hr = S_OK;
   try {
@@ -210,11 +253,11 @@ HRESULT STDMETHODCALLTYPE DxcLinker::Link(
     raw_stream_ostream DiagStream(pDiagStream);
     llvm::DiagnosticPrinterRawOStream DiagPrinter(DiagStream);
     PrintDiagnosticContext DiagContext(DiagPrinter);
-    m_Ctx.setDiagnosticHandler(PrintDiagnosticContext::PrintDiagnosticHandler,
+    Ctx.setDiagnosticHandler(PrintDiagnosticContext::PrintDiagnosticHandler,
                                &DiagContext, true);
 
     if (opts.ValVerMajor != UINT32_MAX) {
-      m_pLinker->SetValidatorVersion(opts.ValVerMajor, opts.ValVerMinor);
+      Linker.SetValidatorVersion(opts.ValVerMajor, opts.ValVerMinor);
     }
 
     bool needsValidation = !opts.DisableValidation;
@@ -230,7 +273,7 @@ HRESULT STDMETHODCALLTYPE DxcLinker::Link(
     bool bSuccess = true;
     for (unsigned i = 0; i < libCount; i++) {
       CW2A pUtf8LibName(pLibNames[i], CP_UTF8);
-      bSuccess &= m_pLinker->AttachLib(pUtf8LibName.m_psz);
+      bSuccess &= Linker.AttachLib(pUtf8LibName.m_psz);
     }
 
     dxilutil::ExportMap exportMap;
@@ -238,7 +281,7 @@ HRESULT STDMETHODCALLTYPE DxcLinker::Link(
 
     bool hasErrorOccurred = !bSuccess;
     if (bSuccess) {
-      std::unique_ptr<Module> pM = m_pLinker->Link(
+      std::unique_ptr<Module> pM = Linker.Link(
           opts.EntryPoint, pUtf8TargetProfile.m_psz, exportMap);
       if (pM) {
         const IntrusiveRefCntPtr<clang::DiagnosticIDs> Diags(
@@ -272,6 +315,7 @@ HRESULT STDMETHODCALLTYPE DxcLinker::Link(
           std::move(pM), pOutputBlob, pMalloc, SerializeFlags,
           pOutputStream,
           opts.DebugInfo, opts.DebugFile, &Diag);
+        inputs.SelectValidator = opts.SelectValidator;
         if (needsValidation) {
           valHR = dxcutil::ValidateAndAssembleToContainer(inputs);
         } else {
@@ -305,6 +349,93 @@ HRESULT STDMETHODCALLTYPE DxcLinker::Link(
   return hr;
 }
 
+// Registers the libraries a batch job names that Linker does not have yet.
+HRESULT DxcLinker::RegisterJobLibraries(DxilLinker &Linker, LLVMContext &Ctx,
+                                        const DxcLinkJob &job) {
+  for (UINT32 i = 0; i < job.LibCount; ++i) {
+    CW2A pUtf8LibName(job.pLibNames[i], CP_UTF8);
+    if (Linker.HasLibNameRegistered(pUtf8LibName.m_psz))
+      continue;
+    // Unknown names are left for the link to report.
+    for (auto &lib : m_libs) {
+      if (lib.first == pUtf8LibName.m_psz) {
+        IFR(RegisterLibraryBlob(Linker, Ctx, lib.first, lib.second));
+        break;
+      }
+    }
+  }
+  return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE DxcLinker::LinkBatch(
+    _In_count_(jobCount) const DxcLinkJob *pJobs, // Jobs to link
+    _In_ UINT32 jobCount,                         // Number of jobs
+    _In_ UINT32 threadCount, // Maximum worker threads; 0 for one per hardware thread
+    _In_ IDxcLinkBatchCallback *pCallback // Receives each result
+) {
+  if ((jobCount > 0 && pJobs == nullptr) || pCallback == nullptr)
+    return E_INVALIDARG;
+  for (UINT32 i = 0; i < jobCount; ++i) {
+    if (!pJobs[i].pTargetProfile || !pJobs[i].pLibNames ||
+        pJobs[i].LibCount == 0)
+      return E_INVALIDARG;
+  }
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  threadCount = std::min(threadCount, jobCount);
+
+  // The registered libraries live in m_Ctx, which only one thread may use at
+  // a time, and IR cannot be shared between contexts. So each worker links
+  // in a context of its own, loading the libraries its jobs name from their
+  // blobs the first time they are needed; loading is lazy, so only the
+  // functions a job links are materialized. Later jobs on a worker reuse the
+  // libraries it has loaded.
+  struct WorkerLinker {
+    // Declared before the linker so that the linker is released first.
+    std::unique_ptr<LLVMContext> pCtx;
+    std::unique_ptr<DxilLinker> pLinker;
+  };
+  std::atomic<HRESULT> callbackHR(S_OK);
+  try {
+    DxcThreadMalloc TM(m_pMalloc);
+    std::vector<WorkerLinker> workers(threadCount);
+    RunOnWorkerThreads(
+        jobCount, threadCount, m_pMalloc,
+        [&](size_t jobIndex, unsigned threadIndex) {
+          // Once the callback fails, the remaining jobs are skipped.
+          if (FAILED(callbackHR.load()))
+            return;
+          WorkerLinker &worker = workers[threadIndex];
+          const DxcLinkJob &job = pJobs[jobIndex];
+          CComPtr<IDxcOperationResult> pResult;
+          HRESULT hr = S_OK;
+          try {
+            if (!worker.pLinker) {
+              if (!worker.pCtx)
+                worker.pCtx.reset(new LLVMContext());
+              UINT32 valMajor, valMinor;
+              dxcutil::GetValidatorVersion(&valMajor, &valMinor);
+              worker.pLinker.reset(
+                  DxilLinker::CreateLinker(*worker.pCtx, valMajor, valMinor));
+            }
+            IFT(RegisterJobLibraries(*worker.pLinker, *worker.pCtx, job));
+            IFT(LinkWithLinker(*worker.pLinker, *worker.pCtx, job.pEntryName,
+                               job.pTargetProfile, job.pLibNames, job.LibCount,
+                               job.pArguments, job.ArgCount, &pResult));
+          }
+          CATCH_CPP_ASSIGN_HRESULT();
+          HRESULT cbHR =
+              pCallback->OnJobCompleted((UINT32)jobIndex, hr, pResult);
+          if (FAILED(cbHR)) {
+            HRESULT expected = S_OK;
+            callbackHR.compare_exchange_strong(expected, cbHR);
+          }
+        });
+  }
+  CATCH_CPP_RETURN_HRESULT();
+  return callbackHR.load();
+}
+
 HRESULT CreateDxcLinker(_In_ REFIID riid, _Out_ LPVOID *ppv) {
   *ppv = nullptr;
   try {
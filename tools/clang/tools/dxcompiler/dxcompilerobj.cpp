@@ -24,6 +24,7 @@
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/CodeGen/CodeGenAction.h"
 #include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/HLSL/HLSLExtensionsCodegenHelper.h"
@@ -39,6 +40,7 @@
 #include "dxc/Support/dxcapi.use.h"
 #include "dxc/Support/Global.h"
 #include "dxc/Support/Unicode.h"
+#include "dxc/Support/WorkerThreads.h"
 #include "dxc/Support/microcom.h"
 #include "dxc/Support/FileIOHelper.h"
 #include "dxc/Support/dxcapi.impl.h"
@@ -51,8 +53,13 @@
 #include "dxillib.h"
 #include "dxcshadersourceinfo.h"
 #include "dxcompileradapter.h"
+#include "dxccompilecache.h"
+#include "dxcpreamblecache.h"
+#include "dxcarenamalloc.h"
 #include <algorithm>
+#include <atomic>
 #include <cfloat>
+#include <thread>
 
 // SPIRV change starts
 #ifdef ENABLE_SPIRV_CODEGEN
@@ -376,6 +383,99 @@ struct DefaultFPEnvScope {
 
 #endif  // _WIN32
 
+// Forwards to another allocator, reporting each request to the time profiler
+// of the calling thread so allocations can be attributed to compile phases.
+// Blocks are not tagged, so memory may be released through either allocator.
+class DxcTimeReportMalloc : public IMalloc {
+private:
+  DXC_MICROCOM_TM_REF_FIELDS()
+public:
+  DXC_MICROCOM_TM_ADDREF_RELEASE_IMPL()
+  DXC_MICROCOM_TM_CTOR(DxcTimeReportMalloc)
+
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
+    return DoBasicQueryInterface<IMalloc>(this, iid, ppvObject);
+  }
+
+  void *STDMETHODCALLTYPE Alloc(SIZE_T cb) override {
+    llvm::timeTraceProfilerRecordAlloc(cb);
+    return m_pMalloc->Alloc(cb);
+  }
+  void *STDMETHODCALLTYPE Realloc(void *pv, SIZE_T cb) override {
+#ifdef _WIN32
+    if (pv)
+      llvm::timeTraceProfilerRecordFree(m_pMalloc->GetSize(pv));
+#endif
+    llvm::timeTraceProfilerRecordAlloc(cb);
+    return m_pMalloc->Realloc(pv, cb);
+  }
+  void STDMETHODCALLTYPE Free(void *pv) override {
+#ifdef _WIN32
+    if (pv)
+      llvm::timeTraceProfilerRecordFree(m_pMalloc->GetSize(pv));
+#endif
+    m_pMalloc->Free(pv);
+  }
+#ifdef _WIN32
+  SIZE_T STDMETHODCALLTYPE GetSize(void *pv) override {
+    return m_pMalloc->GetSize(pv);
+  }
+  int STDMETHODCALLTYPE DidAlloc(void *pv) override {
+    return m_pMalloc->DidAlloc(pv);
+  }
+  void STDMETHODCALLTYPE HeapMinimize() override { m_pMalloc->HeapMinimize(); }
+#endif
+};
+
+// Profiles the current thread for -ftime-report while in scope. The whole
+// compile is recorded as an outer "Compile" span, and the thread allocator is
+// wrapped to count allocations. Only Windows routes operator new through the
+// thread allocator (see DXCompiler.cpp) and can report block sizes for frees,
+// so elsewhere the counts cover IMalloc requests only and peak live bytes are
+// not reported; the -ftime-report help says as much.
+class DxcTimeReportScope {
+  CComPtr<DxcTimeReportMalloc> m_pMalloc;
+  std::unique_ptr<DxcThreadMalloc> m_pThreadMalloc;
+  bool m_bSpanOpen = false;
+
+public:
+  DxcTimeReportScope(bool enabled, IMalloc *pMalloc, StringRef detail) {
+    if (!enabled || llvm::timeTraceProfilerEnabled())
+      return;
+    m_pMalloc = DxcTimeReportMalloc::Alloc(pMalloc);
+    IFTOOM(m_pMalloc.p);
+    m_pThreadMalloc.reset(new DxcThreadMalloc(m_pMalloc));
+#ifdef _WIN32
+    llvm::timeTraceProfilerInitialize(/*TrackLiveBytes*/ true);
+#else
+    llvm::timeTraceProfilerInitialize(/*TrackLiveBytes*/ false);
+#endif
+    llvm::timeTraceProfilerBegin("Compile", detail);
+    m_bSpanOpen = true;
+  }
+  ~DxcTimeReportScope() {
+    if (m_pMalloc)
+      llvm::timeTraceProfilerCleanup();
+  }
+
+  // Closes the outer span and adds the report to the result.
+  void WriteReport(DxcResult *pResult, StringRef outputName) {
+    if (!m_pMalloc)
+      return;
+    if (m_bSpanOpen) {
+      llvm::timeTraceProfilerEnd();
+      m_bSpanOpen = false;
+    }
+    std::string report;
+    raw_string_ostream OS(report);
+    llvm::timeTraceProfilerWrite(OS);
+    OS.flush();
+    IFT(pResult->SetOutputString(DXC_OUT_TIME_REPORT, report.c_str(),
+                                 report.size()));
+    IFT(pResult->SetOutputName(DXC_OUT_TIME_REPORT, outputName));
+  }
+};
+
 class HLSLExtensionsCodegenHelperImpl : public HLSLExtensionsCodegenHelper {
 private:
   CompilerInstance &m_CI;
@@ -533,6 +633,7 @@ static void CreateDefineStrings(
 }
 
 class DxcCompiler : public IDxcCompiler3,
+                    public IDxcCompilerBatch,
                     public IDxcLangExtensions2,
                     public IDxcContainerEvent,
 #ifdef SUPPORT_QUERY_GIT_COMMIT_INFO
@@ -568,6 +669,7 @@ public:
   HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void **ppvObject) override {
     HRESULT hr = DoBasicQueryInterface<
       IDxcCompiler3,
+      IDxcCompilerBatch,
       IDxcLangExtensions,
       IDxcLangExtensions2,
       IDxcContainerEvent,
@@ -599,6 +701,16 @@ public:
       return E_INVALIDARG;
 
     *ppResult = nullptr;
+    return CompileWithMalloc(m_pMalloc, pSource, pArguments, argCount,
+                             pIncludeHandler, riid, ppResult);
+  }
+
+  // Compiles with every allocation, including those of the result, made with
+  // pMalloc; this is the compiler's allocator, or an arena for -arena-alloc.
+  HRESULT CompileWithMalloc(IMalloc *pMalloc, const DxcBuffer *pSource,
+                            LPCWSTR *pArguments, UINT32 argCount,
+                            IDxcIncludeHandler *pIncludeHandler, REFIID riid,
+                            LPVOID *ppResult) {
 
     HRESULT hr = S_OK;
     CComPtr<IDxcBlobUtf8> utf8Source;
@@ -607,12 +719,12 @@ public:
     bool bCompileStarted = false;
     bool bPreprocessStarted = false;
     DxilShaderHash ShaderHashContent;
-    DxcThreadMalloc TM(m_pMalloc);
+    DxcThreadMalloc TM(pMalloc);
 
     try {
       DefaultFPEnvScope fpEnvScope;
 
-      IFT(CreateMemoryStream(m_pMalloc, &pOutputStream));
+      IFT(CreateMemoryStream(pMalloc, &pOutputStream));
 
       // Parse command-line options into DxcOpts
       int argCountInt;
@@ -624,7 +736,7 @@ public:
       {
         bool finished = false;
         CComPtr<AbstractMemoryStream> pOptionErrorStream;
-        IFT(CreateMemoryStream(m_pMalloc, &pOptionErrorStream));
+        IFT(CreateMemoryStream(pMalloc, &pOptionErrorStream));
         dxcutil::ReadOptsAndValidate(mainArgs, opts, pOptionErrorStream, &pDxcOperationResult, finished);
         if (finished) {
           IFT(pDxcOperationResult->QueryInterface(riid, ppResult));
@@ -636,6 +748,15 @@ public:
         }
       }
 
+      if (opts.ArenaAlloc && pMalloc == m_pMalloc) {
+        hr = CompileInArena(pSource, pArguments, argCount, pIncludeHandler,
+                            riid, ppResult);
+        goto Cleanup;
+      }
+
+      DxcTimeReportScope timeReport(opts.TimeReport, pMalloc,
+                                    opts.TargetProfile);
+
       bool isPreprocessing = !opts.Preprocess.empty();
       if (isPreprocessing) {
         DxcEtw_DXCompilerPreprocess_Start();
@@ -645,7 +766,7 @@ public:
         bCompileStarted = true;
       }
 
-      CComPtr<DxcResult> pResult = DxcResult::Alloc(m_pMalloc);
+      CComPtr<DxcResult> pResult = DxcResult::Alloc(pMalloc);
       IFT(pResult->SetEncoding(opts.DefaultTextCodePage));
       DxcOutputObject primaryOutput;
 
@@ -683,7 +804,7 @@ public:
         PreprocessArgs.assign(pArguments, pArguments + argCount);
         PreprocessArgs.push_back(L"-P");
         PreprocessArgs.push_back(L"preprocessed.hlsl");
-        IFT(Compile(pSource, PreprocessArgs.data(), PreprocessArgs.size(), pIncludeHandler, IID_PPV_ARGS(&pSrcCodeResult)));
+        IFT(CompileWithMalloc(pMalloc, pSource, PreprocessArgs.data(), PreprocessArgs.size(), pIncludeHandler, IID_PPV_ARGS(&pSrcCodeResult)));
         HRESULT status;
         IFT(pSrcCodeResult->GetStatus(&status));
         if (SUCCEEDED(status)) {
@@ -694,7 +815,15 @@ public:
 #endif // ENABLE_SPIRV_CODEGEN
 
       // Convert source code encoding
-      IFC(hlsl::DxcGetBlobAsUtf8(pSourceEncoding, m_pMalloc, &utf8Source));
+      IFC(hlsl::DxcGetBlobAsUtf8(pSourceEncoding, pMalloc, &utf8Source));
+
+      std::unique_ptr<dxcutil::CompileCache> compileCache =
+          CreateCompileCache(opts, utf8Source);
+      if (compileCache && compileCache->Lookup(pIncludeHandler, pResult)) {
+        IFT(pResult->QueryInterface(riid, ppResult));
+        hr = S_OK;
+        goto Cleanup;
+      }
 
       CComPtr<IDxcBlob> pOutputBlob;
       dxcutil::DxcArgsFileSystem *msfPtr =
@@ -721,7 +850,7 @@ public:
         msfPtr->EnableDisplayIncludeProcess();
 
       IFT(msfPtr->RegisterOutputStream(L"output.bc", pOutputStream));
-      IFT(msfPtr->CreateStdStreams(m_pMalloc));
+      IFT(msfPtr->CreateStdStreams(pMalloc));
 
       StringRef Data(utf8Source->GetStringPointer(),
                      utf8Source->GetStringLength());
@@ -732,6 +861,8 @@ public:
 
       // Setup a compiler instance.
       raw_stream_ostream outStream(pOutputStream.p);
+      // The compiler's preprocessor options refer to the preamble cache.
+      std::unique_ptr<dxcutil::PreambleCache> preambleCache;
       llvm::LLVMContext llvmContext; // LLVMContext should outlive CompilerInstance
       std::unique_ptr<llvm::Module> compiledModule;
       CompilerInstance compiler;
@@ -740,6 +871,11 @@ public:
       SetupCompilerForCompile(compiler, &m_langExtensionsHelper, pUtf8SourceName, diagPrinter.get(), defines, opts, pArguments, argCount);
       msfPtr->SetupForCompilerInstance(compiler);
 
+      if (opts.PreambleCache && !isPreprocessing) {
+        preambleCache = CreatePreambleCache(opts, Data);
+        preambleCache->Apply(compiler.getPreprocessorOpts());
+      }
+
       // The clang entry point (cc1_main) would now create a compiler invocation
       // from arguments, but depending on the Preprocess option, we either compile
       // to LLVM bitcode and then package that into a DXBC blob, or preprocess to
@@ -775,6 +911,7 @@ public:
 
         FrontendInputFile file(pUtf8SourceName, IK_HLSL);
         clang::PrintPreprocessedAction action;
+        llvm::TimeTraceScope timeScope("Preprocess");
         if (action.BeginSourceFile(compiler, file)) {
           action.Execute();
           action.EndSourceFile();
@@ -817,7 +954,8 @@ public:
         } else {
           // Version from dxil.dll, or internal validator if unavailable
           dxcutil::GetValidatorVersion(&compiler.getCodeGenOpts().HLSLValidatorMajorVer,
-                                      &compiler.getCodeGenOpts().HLSLValidatorMinorVer);
+                                      &compiler.getCodeGenOpts().HLSLValidatorMinorVer,
+                                      opts.SelectValidator);
         }
 
         // Root signature-only container validation is only supported on 1.5 and above.
@@ -860,7 +998,7 @@ public:
           auto rootSigHandle = action.takeRootSigHandle();
 
           CComPtr<AbstractMemoryStream> pContainerStream;
-          IFT(CreateMemoryStream(m_pMalloc, &pContainerStream));
+          IFT(CreateMemoryStream(pMalloc, &pContainerStream));
           SerializeDxilContainerForRootSignature(rootSigHandle.get(),
                                                  pContainerStream);
 
@@ -952,14 +1090,18 @@ public:
 
           std::unique_ptr<llvm::Module> serializeModule( action.takeModule() );
 
-          // Clone and save the copy.
-          compiledModule.reset(llvm::CloneModule(serializeModule.get()));
+          // Clone and save the copy with debug info; it is only needed to
+          // write the PDB, and doubles as the validator's debug module.
+          if (opts.IsDebugInfoEnabled())
+            compiledModule.reset(llvm::CloneModule(serializeModule.get()));
 
           dxcutil::AssembleInputs inputs(
-                std::move(serializeModule), pOutputBlob, m_pMalloc, SerializeFlags,
+                std::move(serializeModule), pOutputBlob, pMalloc, SerializeFlags,
                 pOutputStream, opts.IsDebugInfoEnabled(),
                 opts.GetPDBName(), &compiler.getDiagnostics(),
                 &ShaderHashContent, pReflectionStream, pRootSigStream);
+          inputs.SelectValidator = opts.SelectValidator;
+          inputs.pDebugModule = compiledModule.get();
 
           if (needsValidation) {
             valHR = dxcutil::ValidateAndAssembleToContainer(inputs);
@@ -1034,6 +1176,7 @@ public:
       // SPIRV change ends
 
       if (!hasErrorOccurred && writePDB) {
+        llvm::TimeTraceScope timeScope("WritePDB");
         CComPtr<IDxcBlob> pStrippedContainer;
 
         {
@@ -1076,7 +1219,7 @@ public:
           }
 
           IFT(CreateContainerForPDB(
-            m_pMalloc,
+            pMalloc,
             compiledModule.get(),
             pOutputBlob, pDebugProgramBlob,
             static_cast<IDxcVersionInfo *>(this), pSourceInfo,
@@ -1086,13 +1229,25 @@ public:
 
         // Create the final PDB Blob
         CComPtr<IDxcBlob> pPdbBlob;
-        IFT(hlsl::pdb::WriteDxilPDB(m_pMalloc, pStrippedContainer, ShaderHashContent.Digest, &pPdbBlob));
+        IFT(hlsl::pdb::WriteDxilPDB(pMalloc, pStrippedContainer, ShaderHashContent.Digest, &pPdbBlob));
         IFT(pResult->SetOutputObject(DXC_OUT_PDB, pPdbBlob));
       }
 
+      timeReport.WriteReport(pResult, opts.OutputTimeReportFile);
+
       IFT(primaryOutput.SetObject(pOutputBlob, opts.DefaultTextCodePage));
       IFT(pResult->SetOutput(primaryOutput));
       IFT(pResult->SetStatusAndPrimaryResult(hasErrorOccurred ? E_FAIL : S_OK, primaryOutput.kind));
+
+      if (preambleCache && !hasErrorOccurred && compiler.hasPreprocessor())
+        preambleCache->Store(compiler.getPreprocessor());
+
+      if (compileCache && !hasErrorOccurred) {
+        std::vector<dxcutil::DxcIncludeDependency> includeDeps;
+        msfPtr->GetIncludeDependencies(includeDeps);
+        compileCache->Store(includeDeps, pResult);
+      }
+
       IFT(pResult->QueryInterface(riid, ppResult));
 
       hr = S_OK;
@@ -1122,6 +1277,105 @@ public:
     return hr;
   }
 
+  // Runs a compile with an arena as its allocator, copies the outputs to the
+  // compiler's allocator and then releases the arena with everything the
+  // compile left in it.
+  HRESULT CompileInArena(const DxcBuffer *pSource, LPCWSTR *pArguments,
+                         UINT32 argCount, IDxcIncludeHandler *pIncludeHandler,
+                         REFIID riid, LPVOID *ppResult) {
+    CComPtr<IMalloc> pArena;
+    IFR(dxcutil::CreateArenaMalloc(m_pMalloc, &pArena));
+    CComPtr<IDxcResult> pArenaResult;
+    {
+      DxcThreadMalloc TM(pArena);
+      IFR(CompileWithMalloc(pArena, pSource, pArguments, argCount,
+                            pIncludeHandler, IID_PPV_ARGS(&pArenaResult)));
+    }
+
+    HRESULT status;
+    IFR(pArenaResult->GetStatus(&status));
+    CComPtr<DxcResult> pResult = DxcResult::Alloc(m_pMalloc);
+    IFROOM(pResult.p);
+    IFR(pResult->SetStatusAndPrimaryResult(status,
+                                           pArenaResult->PrimaryOutput()));
+    for (unsigned i = DXC_OUT_NONE + 1; i <= kNumDxcOutputTypes; ++i) {
+      DXC_OUT_KIND kind = (DXC_OUT_KIND)i;
+      if (!pArenaResult->HasOutput(kind))
+        continue;
+      CComPtr<IDxcBlob> pBlob;
+      CComPtr<IDxcBlobUtf16> pName;
+      IFR(pArenaResult->GetOutput(kind, IID_PPV_ARGS(&pBlob), &pName));
+      DxcOutputObject output;
+      output.kind = kind;
+      CComPtr<IDxcBlobEncoding> pEncoding;
+      BOOL known = FALSE;
+      UINT32 codePage = 0;
+      if (SUCCEEDED(pBlob.QueryInterface(&pEncoding)))
+        IFR(pEncoding->GetEncoding(&known, &codePage));
+      if (known) {
+        CComPtr<IDxcBlobEncoding> pCopy;
+        IFR(DxcCreateBlobWithEncodingOnHeapCopy(
+            pBlob->GetBufferPointer(), pBlob->GetBufferSize(), codePage,
+            &pCopy));
+        output.object = pCopy;
+      } else {
+        CComPtr<IDxcBlob> pCopy;
+        IFR(DxcCreateBlobOnHeapCopy(pBlob->GetBufferPointer(),
+                                    pBlob->GetBufferSize(), &pCopy));
+        output.object = pCopy;
+      }
+      if (pName)
+        IFR(output.SetName(pName->GetStringPointer()));
+      IFR(pResult->SetOutput(output));
+    }
+    return pResult->QueryInterface(riid, ppResult);
+  }
+
+  // Compile a batch of jobs on a pool of worker threads.
+  HRESULT STDMETHODCALLTYPE CompileBatch(
+    _In_count_(jobCount) const DxcCompileJob *pJobs, // Jobs to compile
+    _In_ UINT32 jobCount,                         // Number of jobs
+    _In_ UINT32 threadCount,                      // Maximum worker threads; 0 for one per hardware thread
+    _In_ IDxcCompileBatchCallback *pCallback      // Receives each result
+  ) override {
+    if ((jobCount > 0 && pJobs == nullptr) || pCallback == nullptr)
+      return E_INVALIDARG;
+    if (threadCount == 0)
+      threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, jobCount);
+
+    // Each job sets up its own compiler instance, builtins and validator.
+    // What workers do share is the registered language extensions: the
+    // intrinsic tables and the semantic define validator are called from
+    // several threads at once, which IDxcCompilerBatch documents.
+    std::atomic<HRESULT> callbackHR(S_OK);
+    try {
+      DxcThreadMalloc TM(m_pMalloc);
+      RunOnWorkerThreads(
+          jobCount, threadCount, m_pMalloc, [&](size_t jobIndex, unsigned) {
+            // Once the callback fails, the remaining jobs are skipped.
+            if (FAILED(callbackHR.load()))
+              return;
+            const DxcCompileJob &job = pJobs[jobIndex];
+            CComPtr<IDxcResult> pResult;
+            HRESULT hr = S_OK;
+            try {
+              hr = Compile(&job.Source, job.pArguments, job.ArgCount,
+                           job.pIncludeHandler, IID_PPV_ARGS(&pResult));
+            }
+            CATCH_CPP_ASSIGN_HRESULT();
+            HRESULT cbHR =
+                pCallback->OnJobCompleted((UINT32)jobIndex, hr, pResult);
+            if (FAILED(cbHR)) {
+              HRESULT expected = S_OK;
+              callbackHR.compare_exchange_strong(expected, cbHR);
+            }
+          });
+    }
+    CATCH_CPP_RETURN_HRESULT();
+    return callbackHR.load();
+  }
+
   // Disassemble a program.
   virtual HRESULT STDMETHODCALLTYPE Disassemble(
     _In_ const DxcBuffer *pObject,                // Program to disassemble: dxil container or bitcode.
@@ -1373,6 +1627,53 @@ public:
     }
   }
 
+  // Returns a cache keyed on everything but the include files for this
+  // compile, or null if the compile does not use -cache-dir or its result
+  // depends on state that cannot be captured in the key.
+  std::unique_ptr<dxcutil::CompileCache>
+  CreateCompileCache(hlsl::options::DxcOpts &opts, IDxcBlobUtf8 *pSource) {
+    // A cached result would carry a time report for a different compile.
+    if (opts.CacheDir.empty() || !opts.Preprocess.empty() || opts.TimeReport)
+      return nullptr;
+    // Intrinsic tables, semantic define validators and container event
+    // handlers are arbitrary code whose behavior cannot be hashed.
+    if (!m_langExtensionsHelper.GetIntrinsicTables().empty() ||
+        !m_langExtensionsHelper.GetSemanticDefines().empty() ||
+        m_pDxcContainerEventsHandler != nullptr)
+      return nullptr;
+
+    std::unique_ptr<dxcutil::CompileCache> cache(
+        new dxcutil::CompileCache(opts.CacheDir, opts.CacheMaxSize));
+    unsigned valMajor, valMinor;
+    dxcutil::GetValidatorVersion(&valMajor, &valMinor, opts.SelectValidator);
+    cache->AddToKey(StringRef((const char *)&valMajor, sizeof(valMajor)));
+    cache->AddToKey(StringRef((const char *)&valMinor, sizeof(valMinor)));
+    for (const std::string &define : m_langExtensionsHelper.GetDefines())
+      cache->AddToKey(define);
+    for (const std::string &exclusion :
+         m_langExtensionsHelper.GetSemanticDefineExclusions())
+      cache->AddToKey(exclusion);
+    cache->AddToKey(m_langExtensionsHelper.GetTargetTriple());
+    cache->AddArgsToKey(opts.Args);
+    cache->AddToKey(StringRef(pSource->GetStringPointer(),
+                              pSource->GetStringLength()));
+    return cache;
+  }
+
+  // Returns a preamble cache keyed on the preamble of the main source and
+  // the options that change which include files are found or how they are
+  // tokenized.
+  std::unique_ptr<dxcutil::PreambleCache>
+  CreatePreambleCache(hlsl::options::DxcOpts &opts, StringRef source) {
+    std::string keyState;
+    llvm::raw_string_ostream keyStream(keyState);
+    keyStream << (unsigned)opts.HLSLVersion << ' ' << opts.Enable16BitTypes << '\n';
+    for (const llvm::opt::Arg *A : opts.Args.filtered(options::OPT_I))
+      keyStream << A->getValue() << '\n';
+    keyStream.flush();
+    return llvm::make_unique<dxcutil::PreambleCache>(source, keyState);
+  }
+
   // IDxcVersionInfo
   HRESULT STDMETHODCALLTYPE GetVersion(_Out_ UINT32 *pMajor, _Out_ UINT32 *pMinor) override {
     if (pMajor == nullptr || pMinor == nullptr)
@@ -0,0 +1,224 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// dxcpreamblecache.cpp                                                      //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Implements the in-process cache of pre-tokenized include files.           //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "dxc/Support/WinIncludes.h"
+#include "dxc/Support/Global.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Frontend/Utils.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/Lex/Preprocessor.h"
+#include "clang/Lex/PreprocessorOptions.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/raw_ostream.h"
+#include "dxcpreamblecache.h"
+#include <algorithm>
+#include <vector>
+
+using namespace llvm;
+using namespace clang;
+
+namespace {
+
+// Limits on the entries kept by the process. Entries are replaced rather
+// than merged when a compile reads different files, so a handful per shader
+// family is enough.
+const size_t kMaxEntries = 16;
+const size_t kMaxTotalSize = 256 * 1024 * 1024;
+
+// Preambles shorter than this do not include anything worth caching.
+const unsigned kMinPreambleSize = 8;
+
+std::string HashToString(MD5 &Hash) {
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Str;
+  MD5::stringifyResult(Result, Str);
+  return Str.str();
+}
+
+std::string HashContents(StringRef Contents) {
+  MD5 Hash;
+  Hash.update(Contents);
+  return HashToString(Hash);
+}
+
+} // namespace
+
+namespace dxcutil {
+
+struct PreambleCacheEntry {
+  std::string Key;
+  std::unique_ptr<MemoryBuffer> Tokens;
+  // Hash of the contents of each file at the time its tokens were recorded.
+  StringMap<std::string> FileHashes;
+  uint64_t LastUse = 0;
+
+  size_t GetSize() const { return Tokens->getBufferSize(); }
+};
+
+} // namespace dxcutil
+
+using namespace dxcutil;
+
+namespace {
+
+// Entries outlive the compiles that create them, so they are allocated and
+// freed with the default allocator rather than the caller's.
+class PreambleCacheStore {
+  sys::Mutex m_Lock;
+  std::vector<std::shared_ptr<PreambleCacheEntry>> m_Entries;
+  uint64_t m_Clock = 0;
+
+public:
+  std::shared_ptr<PreambleCacheEntry> Lookup(StringRef Key) {
+    sys::ScopedLock Lock(m_Lock);
+    for (std::shared_ptr<PreambleCacheEntry> &Entry : m_Entries) {
+      if (Entry->Key == Key) {
+        Entry->LastUse = ++m_Clock;
+        return Entry;
+      }
+    }
+    return nullptr;
+  }
+
+  void Insert(std::shared_ptr<PreambleCacheEntry> NewEntry) {
+    sys::ScopedLock Lock(m_Lock);
+    NewEntry->LastUse = ++m_Clock;
+    m_Entries.erase(std::remove_if(m_Entries.begin(), m_Entries.end(),
+                                   [&](const std::shared_ptr<PreambleCacheEntry> &E) {
+                                     return E->Key == NewEntry->Key;
+                                   }),
+                    m_Entries.end());
+    m_Entries.push_back(std::move(NewEntry));
+
+    // Evict the least recently used entries; compiles still using one keep
+    // their reference until they finish.
+    size_t TotalSize = 0;
+    for (const std::shared_ptr<PreambleCacheEntry> &E : m_Entries)
+      TotalSize += E->GetSize();
+    while (m_Entries.size() > 1 &&
+           (m_Entries.size() > kMaxEntries || TotalSize > kMaxTotalSize)) {
+      auto Oldest = std::min_element(
+          m_Entries.begin(), m_Entries.end(),
+          [](const std::shared_ptr<PreambleCacheEntry> &A,
+             const std::shared_ptr<PreambleCacheEntry> &B) {
+            return A->LastUse < B->LastUse;
+          });
+      TotalSize -= (*Oldest)->GetSize();
+      m_Entries.erase(Oldest);
+    }
+  }
+};
+
+ManagedStatic<PreambleCacheStore> g_PreambleCacheStore;
+
+} // namespace
+
+PreambleCache::PreambleCache(StringRef MainSource, StringRef KeyState) {
+  LangOptions LangOpts;
+  unsigned PreambleSize =
+      Lexer::ComputePreamble(MainSource, LangOpts).first;
+  if (PreambleSize < kMinPreambleSize)
+    return;
+
+  MD5 Hash;
+  Hash.update(MainSource.substr(0, PreambleSize));
+  Hash.update(KeyState);
+  m_Key = HashToString(Hash);
+}
+
+PreambleCache::~PreambleCache() {
+  DxcThreadMalloc TM(nullptr);
+  m_pEntry.reset();
+}
+
+void PreambleCache::Apply(PreprocessorOptions &PPOpts) {
+  if (!IsEnabled())
+    return;
+  {
+    DxcThreadMalloc TM(nullptr);
+    m_pEntry = g_PreambleCacheStore->Lookup(m_Key);
+  }
+  if (!m_pEntry)
+    return;
+  PPOpts.TokenCacheBuffer = m_pEntry->Tokens.get();
+  PPOpts.TokenCacheFileFilter = [this](const FileEntry *FE,
+                                       const MemoryBuffer *Buf) {
+    return AcceptFile(FE, Buf);
+  };
+}
+
+bool PreambleCache::AcceptFile(const FileEntry *FE, const MemoryBuffer *Buf) {
+  if (!Buf)
+    return false;
+  auto It = m_pEntry->FileHashes.find(FE->getName());
+  bool Unchanged = It != m_pEntry->FileHashes.end() &&
+                   It->getValue() == HashContents(Buf->getBuffer());
+  // Mark the outcome in the time report, so hits and misses can be counted.
+  TimeTraceScope TimeScope(Unchanged ? "PreambleCacheHit" : "PreambleCacheMiss",
+                           FE->getName());
+  if (!Unchanged)
+    return false;
+  m_Reused.insert(FE);
+  return true;
+}
+
+void PreambleCache::Store(Preprocessor &PP) {
+  if (!IsEnabled())
+    return;
+
+  SourceManager &SM = PP.getSourceManager();
+  if (m_pEntry) {
+    bool AllReused = true;
+    for (auto It = SM.fileinfo_begin(), End = SM.fileinfo_end(); It != End;
+         ++It) {
+      if (It->second->OrigEntry && !m_Reused.count(It->second->OrigEntry)) {
+        AllReused = false;
+        break;
+      }
+    }
+    if (AllReused)
+      return;
+  }
+
+  DxcThreadMalloc TM(nullptr);
+  std::shared_ptr<PreambleCacheEntry> NewEntry =
+      std::make_shared<PreambleCacheEntry>();
+  NewEntry->Key = m_Key;
+  for (auto It = SM.fileinfo_begin(), End = SM.fileinfo_end(); It != End;
+       ++It) {
+    const SrcMgr::ContentCache &C = *It->second;
+    if (!C.OrigEntry)
+      continue;
+    bool Invalid = false;
+    const MemoryBuffer *Buf = C.getBuffer(PP.getDiagnostics(), SM,
+                                          SourceLocation(), &Invalid);
+    if (Buf && !Invalid)
+      NewEntry->FileHashes[C.OrigEntry->getName()] =
+          HashContents(Buf->getBuffer());
+  }
+
+  SmallString<0> Tokens;
+  {
+    raw_svector_ostream OS(Tokens);
+    CacheTokensForLoadedFiles(PP, &OS);
+  }
+  NewEntry->Tokens = MemoryBuffer::getMemBufferCopy(Tokens, "<token cache>");
+  g_PreambleCacheStore->Insert(std::move(NewEntry));
+}
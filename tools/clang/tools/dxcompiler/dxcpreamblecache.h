@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// dxcpreamblecache.h                                                        //
+// Copyright (C) Microsoft Corporation. All rights reserved.                 //
+// This file is distributed under the University of Illinois Open Source     //
+// License. See LICENSE.TXT for details.                                     //
+//                                                                           //
+// Provides an in-process cache of pre-tokenized include files.              //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringRef.h"
+#include <memory>
+#include <string>
+
+namespace clang {
+class FileEntry;
+class Preprocessor;
+class PreprocessorOptions;
+} // namespace clang
+
+namespace llvm {
+class MemoryBuffer;
+} // namespace llvm
+
+namespace dxcutil {
+
+struct PreambleCacheEntry;
+
+// Process-wide cache of the tokens of the files read by a compile, shared by
+// later compiles that start with the same preamble (the leading comments and
+// preprocessor directives of the main file, which is where the includes of a
+// shader usually are).
+//
+// Tokens are recorded in the pre-tokenized header (PTH) format before macro
+// expansion, so compiles with different defines share an entry. Each file's
+// tokens are only used if the file the compile reads has the same contents
+// as when the tokens were recorded; other files are lexed as usual. This
+// saves lexing and skipping of inactive blocks, not semantic analysis.
+// With -ftime-report, each cached file a compile reads is counted in the
+// PreambleCacheHit totals, or in PreambleCacheMiss if it has changed.
+//
+// An instance must outlive the CompilerInstance it is applied to.
+class PreambleCache {
+public:
+  // The key is the preamble of pMainSource plus caller-supplied state that
+  // changes how files are found or tokenized.
+  PreambleCache(llvm::StringRef MainSource, llvm::StringRef KeyState);
+  ~PreambleCache();
+
+  // Returns false if the main source has no preamble worth caching.
+  bool IsEnabled() const { return !m_Key.empty(); }
+
+  // Points the preprocessor options at the cached tokens, if any.
+  void Apply(clang::PreprocessorOptions &PPOpts);
+
+  // Records the tokens of the files read by PP for later compiles, unless
+  // the applied entry already had all of them.
+  void Store(clang::Preprocessor &PP);
+
+private:
+  std::string m_Key;
+  std::shared_ptr<PreambleCacheEntry> m_pEntry;
+  llvm::SmallPtrSet<const clang::FileEntry *, 16> m_Reused;
+
+  bool AcceptFile(const clang::FileEntry *FE, const llvm::MemoryBuffer *Buf);
+};
+
+} // namespace dxcutil
@@ -23,6 +23,7 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "dxc/Support/dxcapi.impl.h"
@@ -49,12 +50,17 @@ HRESULT RunInternalValidator(_In_ IDxcValidator *pValidator,
 namespace {
 // AssembleToContainer helper functions.
 
-bool CreateValidator(CComPtr<IDxcValidator> &pValidator) {
-  if (DxilLibIsEnabled()) {
+bool CreateValidator(CComPtr<IDxcValidator> &pValidator,
+                     hlsl::options::ValidatorSelection SelectValidator =
+                         hlsl::options::ValidatorSelection::Auto) {
+  bool bInternalValidator =
+      SelectValidator == hlsl::options::ValidatorSelection::Internal;
+  if (!bInternalValidator && DxilLibIsEnabled()) {
     DxilLibCreateInstance(CLSID_DxcValidator, &pValidator);
   }
-  bool bInternalValidator = false;
   if (pValidator == nullptr) {
+    IFTBOOLMSG(SelectValidator != hlsl::options::ValidatorSelection::External,
+               E_FAIL, "Failed to load validator from DXIL.dll.");
     IFT(CreateDxcValidator(IID_PPV_ARGS(&pValidator)));
     bInternalValidator = true;
   }
@@ -89,12 +95,13 @@ AssembleInputs::AssembleInputs(std::unique_ptr<llvm::Module> &&pM,
     pRootSigOut(pRootSigOut)
 {}
 
-void GetValidatorVersion(unsigned *pMajor, unsigned *pMinor) {
+void GetValidatorVersion(unsigned *pMajor, unsigned *pMinor,
+                         hlsl::options::ValidatorSelection SelectValidator) {
   if (pMajor == nullptr || pMinor == nullptr)
     return;
 
   CComPtr<IDxcValidator> pValidator;
-  CreateValidator(pValidator);
+  CreateValidator(pValidator, SelectValidator);
 
   CComPtr<IDxcVersionInfo> pVersionInfo;
   if (SUCCEEDED(pValidator.QueryInterface(&pVersionInfo))) {
@@ -107,11 +114,13 @@ void GetValidatorVersion(unsigned *pMajor, unsigned *pMinor) {
 }
 
 void AssembleToContainer(AssembleInputs &inputs) {
+  llvm::TimeTraceScope TimeScope("AssembleContainer");
   CComPtr<AbstractMemoryStream> pContainerStream;
   IFT(CreateMemoryStream(inputs.pMalloc, &pContainerStream));
   SerializeDxilContainerForModule(&inputs.pM->GetOrCreateDxilModule(),
                                   inputs.pModuleBitcode, pContainerStream, inputs.DebugName, inputs.SerializeFlags,
-                                  inputs.pShaderHashOut, inputs.pReflectionOut, inputs.pRootSigOut);
+                                  inputs.pShaderHashOut, inputs.pReflectionOut, inputs.pRootSigOut,
+                                  hlsl::NewReflectionTablesWriterForModule);
   inputs.pOutputContainerBlob.Release();
   IFT(pContainerStream.QueryInterface(&inputs.pOutputContainerBlob));
 }
@@ -148,11 +157,12 @@ HRESULT ValidateAndAssembleToContainer(AssembleInputs &inputs) {
   std::unique_ptr<llvm::Module> llvmModuleWithDebugInfo;
 
   CComPtr<IDxcValidator> pValidator;
-  bool bInternalValidator = CreateValidator(pValidator);
-  // Warning on internal Validator
+  bool bInternalValidator = CreateValidator(pValidator, inputs.SelectValidator);
+  // Warning on internal Validator, unless it was explicitly selected.
 
   if (bInternalValidator) {
-    if (inputs.pDiag) {
+    if (inputs.pDiag &&
+        inputs.SelectValidator != hlsl::options::ValidatorSelection::Internal) {
       unsigned diagID =
           inputs.pDiag->getCustomDiagID(clang::DiagnosticsEngine::Level::Warning,
                                "DXIL.dll not found.  Resulting DXIL will not be "
@@ -163,11 +173,14 @@ HRESULT ValidateAndAssembleToContainer(AssembleInputs &inputs) {
     // In this case, we'll want to make a clone to avoid
     // SerializeDxilContainerForModule stripping all the debug info. The debug
     // info will be stripped from the orginal module, but preserved in the cloned
-    // module.
-    if (inputs.bDebugInfo) {
+    // module. Skip the clone if the caller already kept an unstripped copy.
+    if (inputs.bDebugInfo && !inputs.pDebugModule) {
       llvmModuleWithDebugInfo.reset(llvm::CloneModule(inputs.pM.get()));
     }
   }
+  llvm::Module *pDebugModule = inputs.pDebugModule
+                                   ? inputs.pDebugModule
+                                   : llvmModuleWithDebugInfo.get();
 
   // Verify validator version can validate this module
   CComPtr<IDxcVersionInfo> pValidatorVersion;
@@ -194,13 +207,16 @@ HRESULT ValidateAndAssembleToContainer(AssembleInputs &inputs) {
   CComPtr<IDxcOperationResult> pValResult;
   // Important: in-place edit is required so the blob is reused and thus
   // dxil.dll can be released.
-  if (bInternalValidator) {
-    IFT(RunInternalValidator(pValidator, inputs.pM.get(),
-                             llvmModuleWithDebugInfo.get(), inputs.pOutputContainerBlob,
-                             DxcValidatorFlags_InPlaceEdit, &pValResult));
-  } else {
-    IFT(pValidator->Validate(inputs.pOutputContainerBlob, DxcValidatorFlags_InPlaceEdit,
-                             &pValResult));
+  {
+    llvm::TimeTraceScope TimeScope("Validation");
+    if (bInternalValidator) {
+      IFT(RunInternalValidator(pValidator, inputs.pM.get(),
+                               pDebugModule, inputs.pOutputContainerBlob,
+                               DxcValidatorFlags_InPlaceEdit, &pValResult));
+    } else {
+      IFT(pValidator->Validate(inputs.pOutputContainerBlob, DxcValidatorFlags_InPlaceEdit,
+                               &pValResult));
+    }
   }
   IFT(pValResult->GetStatus(&valHR));
   if (inputs.pDiag) {
@@ -35,6 +35,7 @@ class AbstractMemoryStream;
 namespace options {
 class MainArgs;
 class DxcOpts;
+enum class ValidatorSelection : int;
 } // namespace options
 } // namespace hlsl
 
@@ -62,11 +63,17 @@ struct AssembleInputs {
   hlsl::DxilShaderHash *pShaderHashOut = nullptr;
   hlsl::AbstractMemoryStream *pReflectionOut = nullptr;
   hlsl::AbstractMemoryStream *pRootSigOut = nullptr;
+  // Unstripped copy of pM owned by the caller.  When set, the internal
+  // validator uses it for debug locations instead of cloning pM.
+  llvm::Module *pDebugModule = nullptr;
+  // Zero-initialized to ValidatorSelection::Auto.
+  hlsl::options::ValidatorSelection SelectValidator = {};
 };
 HRESULT ValidateAndAssembleToContainer(AssembleInputs &inputs);
 HRESULT ValidateRootSignatureInContainer(
     IDxcBlob *pRootSigContainer, clang::DiagnosticsEngine *pDiag = nullptr);
-void GetValidatorVersion(unsigned *pMajor, unsigned *pMinor);
+void GetValidatorVersion(unsigned *pMajor, unsigned *pMinor,
+                         hlsl::options::ValidatorSelection SelectValidator = {});
 void AssembleToContainer(AssembleInputs &inputs);
 HRESULT Disassemble(IDxcBlob *pProgram, llvm::raw_string_ostream &Stream);
 void ReadOptsAndValidate(hlsl::options::MainArgs &mainArgs,
@@ -20,8 +20,10 @@
 #include "testFiles/testTraversal.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 using namespace dxc;
@@ -53,18 +55,11 @@ void printErrors(CComPtr<IDxcOperationResult> pResult)
   //IFTMSG(status, msg);
 }
 
-void CompileToDxilFromFile(DxcDllSupport& dxcSupport, LPCWSTR pShaderTextFilePath, LPCWSTR pEntryPoint, LPCWSTR pTargetProfile, LPCWSTR* pArgs, UINT32 argCount, const DxcDefine *pDefines, UINT32 defineCount, IDxcBlob **ppBlob)
+void CompileToDxil(DxcDllSupport& dxcSupport, IDxcLibrary* pLibrary, IDxcBlob* pTextBlob, LPCWSTR pShaderTextFilePath, LPCWSTR pEntryPoint, LPCWSTR pTargetProfile, LPCWSTR* pArgs, UINT32 argCount, const DxcDefine *pDefines, UINT32 defineCount, IDxcBlob **ppBlob)
 {
-  CComPtr<IDxcLibrary> pLibrary;
-  IFT(dxcSupport.CreateInstance(CLSID_DxcLibrary, &pLibrary));
-
   CComPtr<IDxcIncludeHandler> dxcIncludeHandler;
   IFT(pLibrary->CreateIncludeHandler(&dxcIncludeHandler));
 
-  UINT32 codePage(0);
-  CComPtr<IDxcBlobEncoding> pTextBlob(nullptr);
-  IFT(pLibrary->CreateBlobFromFile(pShaderTextFilePath, &codePage, &pTextBlob));
-
   CComPtr<IDxcCompiler> pCompiler;
   IFT(dxcSupport.CreateInstance(CLSID_DxcCompiler, &pCompiler));
 
@@ -85,6 +80,31 @@ void CompileToDxilFromFile(DxcDllSupport& dxcSupport, LPCWSTR pShaderTextFilePat
   }
 }
 
+void CompileToDxilFromFile(DxcDllSupport& dxcSupport, LPCWSTR pShaderTextFilePath, LPCWSTR pEntryPoint, LPCWSTR pTargetProfile, LPCWSTR* pArgs, UINT32 argCount, const DxcDefine *pDefines, UINT32 defineCount, IDxcBlob **ppBlob)
+{
+  CComPtr<IDxcLibrary> pLibrary;
+  IFT(dxcSupport.CreateInstance(CLSID_DxcLibrary, &pLibrary));
+
+  UINT32 codePage(0);
+  CComPtr<IDxcBlobEncoding> pTextBlob(nullptr);
+  IFT(pLibrary->CreateBlobFromFile(pShaderTextFilePath, &codePage, &pTextBlob));
+
+  CompileToDxil(dxcSupport, pLibrary, pTextBlob, pShaderTextFilePath, pEntryPoint, pTargetProfile, pArgs, argCount, pDefines, defineCount, ppBlob);
+}
+
+// pShaderTextFilePath names the source for diagnostics and include lookup; the
+// file does not have to exist.
+void CompileToDxilFromText(DxcDllSupport& dxcSupport, const std::string& text, LPCWSTR pShaderTextFilePath, LPCWSTR pEntryPoint, LPCWSTR pTargetProfile, LPCWSTR* pArgs, UINT32 argCount, const DxcDefine *pDefines, UINT32 defineCount, IDxcBlob **ppBlob)
+{
+  CComPtr<IDxcLibrary> pLibrary;
+  IFT(dxcSupport.CreateInstance(CLSID_DxcLibrary, &pLibrary));
+
+  CComPtr<IDxcBlobEncoding> pTextBlob(nullptr);
+  IFT(pLibrary->CreateBlobWithEncodingOnHeapCopy(text.data(), (UINT32)text.size(), CP_UTF8, &pTextBlob));
+
+  CompileToDxil(dxcSupport, pLibrary, pTextBlob, pShaderTextFilePath, pEntryPoint, pTargetProfile, pArgs, argCount, pDefines, defineCount, ppBlob);
+}
+
 bool DxrCompile(
   DxcDllSupport& dxrFallbackSupport,
   const std::string& entryName,
@@ -176,6 +196,16 @@ public:
     }
   }
 
+  // Adds a library compiled from text to the files set with setFiles().
+  void addSource(const std::string& filename, const std::string& text)
+  {
+    CComPtr<IDxcBlob> pInput;
+    LPCWSTR args[] = { L"-O3" };
+    CompileToDxilFromText(m_dxcSupport, text, s2ws(m_path + filename).c_str(), L"", L"lib_6_3", args, _countof(args), nullptr, 0, &pInput);
+    m_inputBlobs.push_back(pInput);
+    m_inputBlobPtrs.push_back(pInput);
+  }
+
 protected:
   DxcDllSupport m_dxcSupport;
   DxcDllSupport m_dxrFallbackSupport;
@@ -308,6 +338,62 @@ public:
   }
 };
 
+// Times linking a generated library with many shaders into one fallback
+// compute shader. Nothing is run on the device.
+class BenchmarkTester : public Tester
+{
+public:
+  BenchmarkTester(const std::string& deviceName, const std::string& path)
+    : Tester(deviceName, path)
+  {}
+
+  void run(unsigned numShaders, unsigned iterations = 3)
+  {
+    // Each shader keeps a few values live across two continuations, one of
+    // them in a branch, so that every transform does some liveness work.
+    std::ostringstream src;
+    src << "#include \"testLib.h\"\n\n"
+        << "SHADER_test\nvoid continuation();\n";
+    std::vector<std::string> shaderNames;
+    for (unsigned i = 0; i < numShaders; ++i)
+    {
+      std::string name = "bench" + std::to_string(i);
+      shaderNames.push_back(name);
+      src << "\nSHADER_test\nvoid " << name << "()\n{\n"
+          << "  int a = load(" << i << ");\n"
+          << "  int b = load(" << i + 1 << ");\n"
+          << "  continuation();\n"
+          << "  if (a > b)\n"
+          << "    continuation();\n"
+          << "  verify(a + b, " << 2 * i + 1 << ");\n"
+          << "  verify(a, " << i << ");\n"
+          << "}\n";
+    }
+    setFiles({ "testShader2.hlsl" });
+    addSource("benchmark.hlsl", src.str());
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration total = Clock::duration::zero();
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+      std::vector<DxcShaderInfo> shaderIds(shaderNames.size());
+      CComPtr<IDxcBlob> pOutput;
+      Clock::time_point start = Clock::now();
+      bool succeeded = DxrCompile(m_dxrFallbackSupport, m_entryName, m_inputBlobPtrs, shaderNames, shaderIds, true, &pOutput);
+      total += Clock::now() - start;
+      if (!succeeded)
+      {
+        std::cout << "Compile failed\n";
+        return;
+      }
+    }
+
+    std::cout << numShaders << " shaders: "
+              << std::chrono::duration<double, std::milli>(total).count() / iterations
+              << " ms per link\n";
+  }
+};
+
 int asint(float v)
 {
   return *(int*)&v;
@@ -808,6 +894,7 @@ void printUsageAndExit()
     << "  -h | --help                     Print this message\n"
     << "  -d | --device <name>            Name of device to use. Can be a prefix, e.g. WARP, AMD, etc.\n"
     << "  -p | --path <directory>         Base path for test input files.\n"
+    << "  -b | --benchmark <count>        Time linking <count> generated shaders instead of testing.\n"
     << std::endl;
 
   exit(1);
@@ -818,6 +905,7 @@ int main(int argc, const char* argv[])
 {
   std::string deviceName = "";
   std::string basePath = DEFAULT_TEST_FILE_PATH;
+  int benchmarkShaders = 0;
 
   // Parse arguments
   std::vector<std::string> args;
@@ -837,6 +925,10 @@ int main(int argc, const char* argv[])
     {
       basePath = args[++i];
     }
+    else if (args[i] == "-b" || args[i] == "--benchmark")
+    {
+      benchmarkShaders = std::stoi(args[++i]);
+    }
     else
     {
       std::cerr << "Bad arg:" << args[i] << std::endl;
@@ -846,6 +938,15 @@ int main(int argc, const char* argv[])
 
   try
   {
+    if (benchmarkShaders > 0)
+    {
+      BenchmarkTester tester(deviceName, basePath);
+      for (int numShaders = 1; numShaders < benchmarkShaders; numShaders *= 4)
+        tester.run(numShaders);
+      tester.run(benchmarkShaders);
+      return 0;
+    }
+
     if (!deviceName.empty())
       std::cout << "Testing on device " << deviceName << std::endl;
 
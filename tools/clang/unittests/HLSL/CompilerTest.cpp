@@ -22,6 +22,11 @@
 #include <sstream>
 #include <algorithm>
 #include <cfloat>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <thread>
 #include "dxc/DxilContainer/DxilContainer.h"
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/dxcapi.h"
@@ -30,6 +35,8 @@
 #include <atlfile.h>
 #include <d3dcompiler.h>
 #include "dia2.h"
+#else
+#include <sys/resource.h>
 #endif
 
 #include "dxc/Test/HLSLTestData.h"
@@ -48,6 +55,7 @@
 #include "llvm/Support/MSFileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
 
 using namespace std;
@@ -123,6 +131,9 @@ public:
   TEST_METHOD(CompileWhenDefinesManyThenApplied)
   TEST_METHOD(CompileWhenEmptyThenFails)
   TEST_METHOD(CompileWhenIncorrectThenFails)
+  TEST_METHOD(CompileBatchThenEachJobReported)
+  TEST_METHOD(CompileWhenTimeReportThenReportReturned)
+  TEST_METHOD(BenchmarkSamplesCompileMatrix)
   TEST_METHOD(CompileWhenWorksThenDisassembleWorks)
   TEST_METHOD(CompileWhenDebugWorksThenStripDebug)
   TEST_METHOD(CompileWhenWorksThenAddRemovePrivate)
@@ -134,6 +145,8 @@ public:
   TEST_METHOD(CompileWithRootSignatureThenStripRootSignature)
 
   TEST_METHOD(CompileWhenIncludeThenLoadInvoked)
+  TEST_METHOD(CompileWhenCacheDirThenResultsReused)
+  TEST_METHOD(CompileWhenPreambleCacheThenIncludeChangesApplied)
   TEST_METHOD(CompileWhenIncludeThenLoadUsed)
   TEST_METHOD(CompileWhenIncludeAbsoluteThenLoadAbsolute)
   TEST_METHOD(CompileWhenIncludeLocalThenLoadRelative)
@@ -158,6 +171,7 @@ public:
     TEST_METHOD_PROPERTY(L"Ignore", L"true")
   END_TEST_METHOD()
 #endif
+  TEST_METHOD(CompileWhenArenaAllocThenFewerAllocations)
   TEST_METHOD(CompileWhenShaderModelMismatchAttributeThenFail)
   TEST_METHOD(CompileBadHlslThenFail)
   TEST_METHOD(CompileLegacyShaderModelThenFail)
@@ -165,6 +179,8 @@ public:
 
   TEST_METHOD(CompileWhenRecursiveThenFail)
 
+  TEST_METHOD(CompileWhenBuiltinObjectTypeNamedThenDeclared)
+
   TEST_METHOD(CompileHlsl2015ThenFail)
   TEST_METHOD(CompileHlsl2016ThenOK)
   TEST_METHOD(CompileHlsl2017ThenOK)
@@ -406,6 +422,10 @@ public:
 
     FileRunTestResult t = FileRunTestResult::RunFromFileCommands(fullPath,
       /*pPluginToolsPaths*/nullptr, dumpPath);
+    if (!t.Log.empty()) {
+      CA2W logWide(t.Log.c_str(), CP_UTF8);
+      WEX::Logging::Log::Comment(logWide);
+    }
     if (t.RunResult != 0) {
       CA2W commentWide(t.ErrorMessage.c_str(), CP_UTF8);
       WEX::Logging::Log::Comment(commentWide);
@@ -427,6 +447,27 @@ public:
     CodeGenTestCheckFullPath(path.c_str(), dumpPath);
   }
 
+  // Reads the FileCheckThreads and FileCheckShard parameters. By default,
+  // batch directories run on one thread per core and are not sharded.
+  static void GetBatchDirParams(unsigned &threadCount, unsigned &shardIndex,
+                                unsigned &shardCount) {
+    using namespace WEX::TestExecution;
+    WEX::Common::String value;
+    threadCount = 0;
+    if (SUCCEEDED(RuntimeParameters::TryGetValue(L"FileCheckThreads", value)))
+      threadCount = wcstoul(value, nullptr, 10);
+    if (threadCount == 0)
+      threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    shardIndex = 0;
+    shardCount = 1;
+    if (SUCCEEDED(RuntimeParameters::TryGetValue(L"FileCheckShard", value))) {
+      VERIFY_IS_TRUE(swscanf(value, L"%u/%u", &shardIndex, &shardCount) == 2 &&
+                         shardIndex < shardCount,
+                     L"FileCheckShard must be given as index/count.");
+    }
+  }
+
   void CodeGenTestCheckBatchDir(std::wstring suitePath, bool implicitDir = true) {
     using namespace llvm;
     using namespace WEX::TestExecution;
@@ -448,8 +489,9 @@ public:
 
     CW2A utf8SuitePath(suitePath.c_str());
 
-    unsigned numTestsRun = 0;
-
+    // Gather and sort the files first, so that every process sees the same
+    // order when the directory is sharded.
+    std::vector<std::string> files;
     std::error_code EC;
     llvm::SmallString<128> DirNative;
     llvm::sys::path::native(utf8SuitePath.m_psz, DirNative);
@@ -460,22 +502,117 @@ public:
       if (!llvm::StringSwitch<bool>(llvm::sys::path::extension(Dir->path()))
           .Cases(".hlsl", ".ll", true).Default(false))
         continue;
-      StringRef filename = Dir->path();
-      CA2W wRelPath(filename.data());
-      std::wstring dumpStr;
+      files.push_back(Dir->path());
+    }
+    VERIFY_IS_TRUE(!files.empty(), L"No test files found in batch directory.");
+    std::sort(files.begin(), files.end());
+
+    unsigned threadCount, shardIndex, shardCount;
+    GetBatchDirParams(threadCount, shardIndex, shardCount);
+
+    struct BatchFile {
+      std::wstring path;
+      std::wstring dumpPath;
+      FileRunTestResult result;
+      double seconds;
+    };
+    std::vector<BatchFile> batch;
+    for (size_t i = shardIndex; i < files.size(); i += shardCount) {
+      CA2W wRelPath(files[i].c_str());
+      BatchFile file;
+      file.path = wRelPath.m_psz;
       if (!dumpPath.empty() && suitePath.compare(0, suitePath.size(), wRelPath.m_psz, suitePath.size()) == 0) {
-        dumpStr = dumpPath + (wRelPath.m_psz + suitePath.size());
+        file.dumpPath = dumpPath + (wRelPath.m_psz + suitePath.size());
       }
+      file.result.RunResult = 1;
+      file.result.ErrorMessage = "Test file was not run";
+      file.seconds = 0;
+      batch.push_back(std::move(file));
+    }
 
-      WEX::Logging::Log::StartGroup(wRelPath);
-      CodeGenTestCheck(wRelPath, /*implicitDir*/ false,
-        dumpStr.empty() ? nullptr : dumpStr.c_str());
-      WEX::Logging::Log::EndGroup(wRelPath);
-
-      numTestsRun++;
+    // RUN lines within a file depend on each other, but files don't, so each
+    // thread takes the next file when it finishes one. Results, including
+    // any output a RUN line asked to log, are logged on this thread once all
+    // threads are done.
+    typedef std::chrono::steady_clock Clock;
+    std::atomic<size_t> nextFile(0);
+    auto worker = [&]() {
+      ::llvm::sys::fs::MSFileSystem *workerMsfPtr;
+      if (FAILED(CreateMSFileSystemForDisk(&workerMsfPtr)))
+        return;
+      std::unique_ptr<::llvm::sys::fs::MSFileSystem> workerMsf(workerMsfPtr);
+      ::llvm::sys::fs::AutoPerThreadSystem workerPts(workerMsf.get());
+      if (workerPts.error_code())
+        return;
+      for (size_t i = nextFile++; i < batch.size(); i = nextFile++) {
+        BatchFile &file = batch[i];
+        Clock::time_point start = Clock::now();
+        try {
+          file.result = FileRunTestResult::RunFromFileCommands(
+              file.path.c_str(), m_dllSupport, /*pPluginToolsPaths*/ nullptr,
+              file.dumpPath.empty() ? nullptr : file.dumpPath.c_str());
+        } catch (const hlsl::Exception &e) {
+          file.result.RunResult = 1;
+          file.result.ErrorMessage =
+              "Exception while running test: " +
+              (e.msg.empty() ? "hr=0x" + llvm::utohexstr((unsigned)e.hr)
+                             : e.msg);
+        } catch (...) {
+          file.result.RunResult = 1;
+          file.result.ErrorMessage = "Exception while running test";
+        }
+        file.seconds =
+            std::chrono::duration<double>(Clock::now() - start).count();
+      }
+    };
+    Clock::time_point batchStart = Clock::now();
+    threadCount = std::min<unsigned>(threadCount, batch.size());
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i)
+      threads.emplace_back(worker);
+    worker();
+    for (auto &th : threads)
+      th.join();
+    double batchSeconds =
+        std::chrono::duration<double>(Clock::now() - batchStart).count();
+
+    double totalSeconds = 0;
+    for (const BatchFile &file : batch) {
+      WEX::Logging::Log::StartGroup(file.path.c_str());
+      WEX::Logging::Log::Comment(
+          FormatToWString(L"%.3f s", file.seconds).c_str());
+      if (!file.result.Log.empty()) {
+        CA2W logWide(file.result.Log.c_str(), CP_UTF8);
+        WEX::Logging::Log::Comment(logWide);
+      }
+      if (file.result.RunResult != 0) {
+        CA2W commentWide(file.result.ErrorMessage.c_str(), CP_UTF8);
+        WEX::Logging::Log::Comment(commentWide);
+        WEX::Logging::Log::Error(L"Run result is not zero");
+      }
+      WEX::Logging::Log::EndGroup(file.path.c_str());
+      totalSeconds += file.seconds;
     }
 
-    VERIFY_IS_GREATER_THAN(numTestsRun, (unsigned)0, L"No test files found in batch directory.");
+    std::vector<const BatchFile *> slowest;
+    for (const BatchFile &file : batch)
+      slowest.push_back(&file);
+    std::sort(slowest.begin(), slowest.end(),
+              [](const BatchFile *a, const BatchFile *b) {
+                return a->seconds > b->seconds;
+              });
+    slowest.resize(std::min<size_t>(slowest.size(), 10));
+    WEX::Logging::Log::Comment(
+        FormatToWString(L"Ran %u of %u files (shard %u/%u) on %u threads in "
+                        L"%.2f s; %.2f s summed over files. Slowest:",
+                        (unsigned)batch.size(), (unsigned)files.size(),
+                        shardIndex, shardCount, threadCount, batchSeconds,
+                        totalSeconds)
+            .c_str());
+    for (const BatchFile *file : slowest)
+      WEX::Logging::Log::Comment(
+          FormatToWString(L"  %.3f s %ls", file->seconds, file->path.c_str())
+              .c_str());
   }
 
   std::string VerifyCompileFailed(LPCSTR pText, LPCWSTR pTargetProfile, LPCSTR pErrorMsg) {
@@ -777,6 +914,541 @@ TEST_F(CompilerTest, CompileWhenIncorrectThenFails) {
   // WEX::Logging::Log::Comment(errorStringW.m_psz);
 }
 
+class TestCompileBatchCallback : public IDxcCompileBatchCallback {
+  DXC_MICROCOM_REF_FIELD(m_dwRef)
+public:
+  DXC_MICROCOM_ADDREF_RELEASE_IMPL(m_dwRef)
+  TestCompileBatchCallback(UINT32 jobCount)
+      : m_dwRef(0), CallCounts(jobCount), Results(jobCount) {}
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void** ppvObject) override {
+    return DoBasicQueryInterface<IDxcCompileBatchCallback>(this, iid, ppvObject);
+  }
+
+  std::mutex Lock;
+  std::vector<unsigned> CallCounts;
+  std::vector<CComPtr<IDxcResult>> Results;
+
+  HRESULT STDMETHODCALLTYPE OnJobCompleted(UINT32 jobIndex, HRESULT hr,
+                                           IDxcResult *pResult) override {
+    std::lock_guard<std::mutex> guard(Lock);
+    if (jobIndex >= CallCounts.size())
+      return E_INVALIDARG;
+    ++CallCounts[jobIndex];
+    if (SUCCEEDED(hr))
+      Results[jobIndex] = pResult;
+    return S_OK;
+  }
+};
+
+TEST_F(CompilerTest, CompileBatchThenEachJobReported) {
+  CComPtr<IDxcCompilerBatch> pBatch;
+  VERIFY_SUCCEEDED(m_dllSupport.CreateInstance(CLSID_DxcCompiler, &pBatch));
+
+  // Odd jobs fail to compile; every job must still be reported exactly once.
+  const char *pGoodSource = "float4 main() : SV_Target { return 0; }";
+  const char *pBadSource = "float4_undefined main() : SV_Target { return 0; }";
+  LPCWSTR args[] = { L"-T", L"ps_6_0" };
+  const UINT32 jobCount = 16;
+  std::vector<DxcCompileJob> jobs(jobCount);
+  for (UINT32 i = 0; i < jobCount; ++i) {
+    const char *pSource = (i % 2) ? pBadSource : pGoodSource;
+    jobs[i].Source.Ptr = pSource;
+    jobs[i].Source.Size = strlen(pSource);
+    jobs[i].Source.Encoding = CP_UTF8;
+    jobs[i].pArguments = args;
+    jobs[i].ArgCount = _countof(args);
+    jobs[i].pIncludeHandler = nullptr;
+  }
+
+  CComPtr<TestCompileBatchCallback> pCallback =
+      new TestCompileBatchCallback(jobCount);
+  VERIFY_SUCCEEDED(pBatch->CompileBatch(jobs.data(), jobCount, 4, pCallback));
+
+  for (UINT32 i = 0; i < jobCount; ++i) {
+    VERIFY_ARE_EQUAL(1U, pCallback->CallCounts[i]);
+    VERIFY_IS_NOT_NULL(pCallback->Results[i].p);
+    HRESULT status;
+    VERIFY_SUCCEEDED(pCallback->Results[i]->GetStatus(&status));
+    if (i % 2) {
+      VERIFY_FAILED(status);
+    } else {
+      VERIFY_SUCCEEDED(status);
+      VERIFY_IS_TRUE(pCallback->Results[i]->HasOutput(DXC_OUT_OBJECT));
+    }
+  }
+}
+
+// The numeric fields of each entry in the "totals" array of a -ftime-report
+// trace, by span name.
+typedef std::map<std::string, std::map<std::string, uint64_t>>
+    TimeReportTotals;
+
+// A small reader for the JSON that -ftime-report writes. Only the "totals"
+// array is kept; the other members are checked for syntax and skipped.
+class TimeReportReader {
+public:
+  explicit TimeReportReader(const std::string &text)
+      : m_p(text.c_str()), m_end(text.c_str() + text.size()) {}
+
+  bool Read(TimeReportTotals &totals) {
+    totals.clear();
+    if (!Consume('{'))
+      return false;
+    do {
+      std::string key;
+      if (!ReadString(key) || !Consume(':'))
+        return false;
+      if (!(key == "totals" ? ReadTotals(totals) : SkipValue()))
+        return false;
+    } while (Consume(','));
+    return Consume('}');
+  }
+
+private:
+  const char *m_p;
+  const char *m_end;
+
+  void SkipSpace() {
+    while (m_p != m_end && isspace((unsigned char)*m_p))
+      ++m_p;
+  }
+  bool Peek(char c) {
+    SkipSpace();
+    return m_p != m_end && *m_p == c;
+  }
+  bool Consume(char c) {
+    if (!Peek(c))
+      return false;
+    ++m_p;
+    return true;
+  }
+
+  // Names are ASCII, so \u escapes are kept as they are.
+  bool ReadString(std::string &s) {
+    s.clear();
+    if (!Consume('"'))
+      return false;
+    while (m_p != m_end && *m_p != '"') {
+      if (*m_p == '\\' && ++m_p == m_end)
+        return false;
+      s += *m_p++;
+    }
+    if (m_p == m_end)
+      return false;
+    ++m_p;
+    return true;
+  }
+
+  bool ReadNumber(uint64_t &n) {
+    SkipSpace();
+    if (m_p == m_end || !isdigit((unsigned char)*m_p))
+      return false;
+    n = 0;
+    while (m_p != m_end && isdigit((unsigned char)*m_p))
+      n = n * 10 + (*m_p++ - '0');
+    return true;
+  }
+
+  bool SkipValue() {
+    SkipSpace();
+    if (m_p == m_end)
+      return false;
+    std::string s;
+    switch (*m_p) {
+    case '"':
+      return ReadString(s);
+    case '{':
+    case '[': {
+      char close = *m_p == '{' ? '}' : ']';
+      ++m_p;
+      if (Consume(close))
+        return true;
+      do {
+        if (close == '}' && (!ReadString(s) || !Consume(':')))
+          return false;
+        if (!SkipValue())
+          return false;
+      } while (Consume(','));
+      return Consume(close);
+    }
+    default: {
+      // Numbers, true, false and null.
+      const char *start = m_p;
+      while (m_p != m_end && (isalnum((unsigned char)*m_p) || *m_p == '-' ||
+                              *m_p == '+' || *m_p == '.'))
+        ++m_p;
+      return m_p != start;
+    }
+    }
+  }
+
+  bool ReadTotals(TimeReportTotals &totals) {
+    if (!Consume('['))
+      return false;
+    if (Consume(']'))
+      return true;
+    do {
+      std::string name, key;
+      std::map<std::string, uint64_t> fields;
+      if (!Consume('{'))
+        return false;
+      do {
+        uint64_t value = 0;
+        if (!ReadString(key) || !Consume(':'))
+          return false;
+        if (key == "name" ? !ReadString(name) : !ReadNumber(value))
+          return false;
+        if (key != "name")
+          fields[key] = value;
+      } while (Consume(','));
+      if (!Consume('}') || name.empty())
+        return false;
+      totals[name] = std::move(fields);
+    } while (Consume(','));
+    return Consume(']');
+  }
+};
+
+// Reads the totals of a -ftime-report trace, failing the test if the trace
+// is not well formed.
+static TimeReportTotals ReadTimeReportTotals(const std::string &report) {
+  TimeReportTotals totals;
+  VERIFY_IS_TRUE(TimeReportReader(report).Read(totals));
+  return totals;
+}
+
+// Returns the given field of the named span, or zero if the span was not
+// recorded.
+static uint64_t GetTimeReportTotal(const TimeReportTotals &totals,
+                                   const std::string &name,
+                                   const std::string &field) {
+  auto entry = totals.find(name);
+  if (entry == totals.end())
+    return 0;
+  auto value = entry->second.find(field);
+  return value == entry->second.end() ? 0 : value->second;
+}
+
+// Quotes a CSV field.
+static std::string QuoteCsvField(const std::string &field) {
+  std::string quoted = "\"";
+  for (char c : field) {
+    if (c == '"')
+      quoted += '"';
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+// Returns the peak resident set size of this process so far, in bytes, for
+// where the time report does not track peak live bytes.
+static uint64_t GetProcessPeakRss() {
+#ifdef _WIN32
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  return (uint64_t)usage.ru_maxrss;
+#else
+  // Linux reports kilobytes.
+  return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+TEST_F(CompilerTest, CompileWhenTimeReportThenReportReturned) {
+  std::string main_source = "float4 main() : SV_Target { return 1; }";
+
+  CComPtr<IDxcCompiler3> pCompiler;
+  VERIFY_SUCCEEDED(m_dllSupport.CreateInstance(CLSID_DxcCompiler, &pCompiler));
+
+  DxcBuffer SourceBuf = {};
+  SourceBuf.Ptr = main_source.c_str();
+  SourceBuf.Size = main_source.size();
+  SourceBuf.Encoding = CP_UTF8;
+
+  std::vector<const WCHAR *> args;
+  args.push_back(L"/Tps_6_0");
+  args.push_back(L"-ftime-report");
+
+  CComPtr<IDxcResult> pResult;
+  VERIFY_SUCCEEDED(pCompiler->Compile(&SourceBuf, args.data(), args.size(),
+                                      nullptr, IID_PPV_ARGS(&pResult)));
+  VerifyOperationSucceeded(pResult);
+  VERIFY_IS_TRUE(pResult->HasOutput(DXC_OUT_TIME_REPORT));
+
+  CComPtr<IDxcBlobUtf8> pReport;
+  VERIFY_SUCCEEDED(pResult->GetOutput(DXC_OUT_TIME_REPORT,
+                                      IID_PPV_ARGS(&pReport), nullptr));
+  std::string report(pReport->GetStringPointer(), pReport->GetStringLength());
+  VERIFY_IS_TRUE(report.find("{\"traceEvents\":[") == 0);
+  TimeReportTotals totals = ReadTimeReportTotals(report);
+  VERIFY_ARE_EQUAL(1u, GetTimeReportTotal(totals, "Compile", "count"));
+  VERIFY_IS_TRUE(GetTimeReportTotal(totals, "Frontend", "count") > 0);
+  VERIFY_IS_TRUE(GetTimeReportTotal(totals, "Validation", "count") > 0);
+
+  // Without the option there is no report.
+  args.pop_back();
+  pResult.Release();
+  VERIFY_SUCCEEDED(pCompiler->Compile(&SourceBuf, args.data(), args.size(),
+                                      nullptr, IID_PPV_ARGS(&pResult)));
+  VERIFY_IS_FALSE(pResult->HasOutput(DXC_OUT_TIME_REPORT));
+}
+
+// Counts the instructions in the function bodies of a disassembled program.
+static unsigned CountDisassembledInstructions(const std::string &text) {
+  std::istringstream lines(text);
+  std::string line;
+  bool inBody = false;
+  unsigned count = 0;
+  while (std::getline(lines, line)) {
+    if (line.compare(0, 7, "define ") == 0)
+      inBody = true;
+    else if (line.compare(0, 1, "}") == 0)
+      inBody = false;
+    else if (inBody && line.compare(0, 2, "  ") == 0 &&
+             line.find_first_not_of(' ') != std::string::npos &&
+             line[line.find_first_not_of(' ')] != ';')
+      ++count;
+  }
+  return count;
+}
+
+typedef std::function<void(LPCWSTR path, const std::string &entry,
+                           const std::string &target, const DxcBuffer &source)>
+    SampleFn;
+
+// Calls the given function for every sample with the entry point and target
+// of its first RUN line. Samples are visited in path order.
+static void ForEachSample(dxc::DxcDllSupport &dllSupport, const SampleFn &fn) {
+  using namespace llvm;
+
+  ::llvm::sys::fs::MSFileSystem *msfPtr;
+  VERIFY_SUCCEEDED(CreateMSFileSystemForDisk(&msfPtr));
+  std::unique_ptr<::llvm::sys::fs::MSFileSystem> msf(msfPtr);
+  ::llvm::sys::fs::AutoPerThreadSystem pts(msf.get());
+  IFTLLVM(pts.error_code());
+
+  std::wstring suitePath =
+      hlsl_test::GetPathToHlslDataFile(L"..\\HLSLFileCheck\\samples");
+  CW2A utf8SuitePath(suitePath.c_str());
+  SmallString<128> DirNative;
+  sys::path::native(utf8SuitePath.m_psz, DirNative);
+
+  std::vector<std::string> paths;
+  std::error_code EC;
+  for (sys::fs::recursive_directory_iterator Dir(DirNative, EC), DirEnd;
+       Dir != DirEnd && !EC; Dir.increment(EC)) {
+    if (sys::path::extension(Dir->path()) == ".hlsl")
+      paths.push_back(Dir->path());
+  }
+  std::sort(paths.begin(), paths.end());
+
+  CComPtr<IDxcLibrary> pLibrary;
+  VERIFY_SUCCEEDED(dllSupport.CreateInstance(CLSID_DxcLibrary, &pLibrary));
+  for (const std::string &path : paths) {
+    CA2W wPath(path.c_str());
+    std::vector<std::string> runLines = hlsl_test::GetRunLines(wPath);
+    if (runLines.empty())
+      continue;
+
+    std::istringstream runLine(runLines.front());
+    std::string word, entry("main"), target;
+    while (runLine >> word) {
+      if (word == "-E")
+        runLine >> entry;
+      else if (word == "-T")
+        runLine >> target;
+    }
+    if (target.empty())
+      continue;
+
+    CComPtr<IDxcBlobEncoding> pSource;
+    VERIFY_SUCCEEDED(pLibrary->CreateBlobFromFile(wPath, nullptr, &pSource));
+    DxcBuffer SourceBuf = {};
+    SourceBuf.Ptr = pSource->GetBufferPointer();
+    SourceBuf.Size = pSource->GetBufferSize();
+    SourceBuf.Encoding = CP_ACP;
+    fn(wPath, entry, target, SourceBuf);
+  }
+}
+
+TEST_F(CompilerTest, BenchmarkSamplesCompileMatrix) {
+  // Each sample is compiled with every configuration. A null target keeps the
+  // one from the sample's RUN line; library targets drop the entry point.
+  struct Config {
+    const char *name;
+    LPCWSTR target;
+    std::vector<LPCWSTR> args;
+  };
+  const Config configs[] = {
+      {"O0", nullptr, {L"-Od"}},
+      {"O3", nullptr, {L"-O3"}},
+      {"O3-Zi", nullptr, {L"-O3", L"-Zi", L"-Qembed_debug"}},
+      {"lib", L"lib_6_3", {L"-O3"}},
+#ifdef ENABLE_SPIRV_CODEGEN
+      // Legalization alone, and legalization and optimization in one
+      // optimizer run, as timed by the SpirvOptimizer phase.
+      {"spirv-O0", nullptr, {L"-Od", L"-spirv"}},
+      {"spirv", nullptr, {L"-O3", L"-spirv"}},
+#endif
+  };
+  const char *phases[] = {"Preprocess",      "Frontend",
+                          "CodeGen",         "Backend",
+                          "SpirvLowering",   "SpirvEmit",
+                          "SpirvOptimizer",  "Validation",
+                          "SpirvValidation", "AssembleContainer",
+                          "WritePDB"};
+  // Passes that have been tuned are reported with their allocations too.
+  // Intrinsics are lowered in DXIL generation; in the O0 configuration the
+  // instruction count shows what lowering leaves behind.
+  const char *passes[] = {"SROA Parameter HLSL", "DXIL Generator"};
+  // The fastest of a few compiles is reported, to keep noise out of the
+  // comparison between runs.
+  const unsigned kIterations = 3;
+
+  // Compiling the corpus this many times takes a while, so the benchmark
+  // only runs when the BenchmarkOutput parameter names a file to write the
+  // results to, as CSV with one row per sample and configuration. Peak live
+  // bytes are only tracked on Windows; elsewhere the column holds the peak
+  // resident set size of the test process so far.
+  WEX::Common::String outputPath;
+  if (FAILED(WEX::TestExecution::RuntimeParameters::TryGetValue(
+          L"BenchmarkOutput", outputPath))) {
+    WEX::Logging::Log::Comment(
+        L"Skipping the benchmark; set BenchmarkOutput to run it.");
+    return;
+  }
+  std::wstring outputPathW = outputPath;
+  std::ofstream csv(CW2A(outputPathW.c_str()).m_psz);
+  VERIFY_IS_TRUE(csv.is_open());
+  csv << "config,sample,succeeded,compile_us";
+  for (const char *phase : phases)
+    csv << "," << phase << "_us";
+  for (const char *pass : passes)
+    csv << "," << pass << "_us," << pass << "_alloc_bytes";
+  csv << ",alloc_bytes,peak_bytes,output_bytes,instructions\n";
+
+  CComPtr<IDxcCompiler3> pCompiler;
+  VERIFY_SUCCEEDED(m_dllSupport.CreateInstance(CLSID_DxcCompiler, &pCompiler));
+
+  for (const Config &config : configs) {
+    unsigned numSucceeded = 0, numFailed = 0;
+    uint64_t compileUs = 0, allocBytes = 0, peakLiveBytes = 0,
+             outputBytes = 0;
+    ForEachSample(m_dllSupport, [&](LPCWSTR wPath, const std::string &entry,
+                                    const std::string &target,
+                                    const DxcBuffer &SourceBuf) {
+      CA2W wEntry(entry.c_str());
+      CA2W wTarget(target.c_str());
+      std::vector<LPCWSTR> args;
+      if (config.target) {
+        args.push_back(L"-T");
+        args.push_back(config.target);
+      } else {
+        args.insert(args.end(), {L"-E", wEntry, L"-T", wTarget});
+      }
+      args.push_back(L"-ftime-report");
+      args.insert(args.end(), config.args.begin(), config.args.end());
+
+      TimeReportTotals report;
+      uint64_t fileCompileUs = UINT64_MAX;
+      size_t fileOutputBytes = 0;
+      unsigned fileInstructions = 0;
+      bool succeeded = true;
+      for (unsigned i = 0; i < kIterations && succeeded; ++i) {
+        CComPtr<IDxcResult> pResult;
+        VERIFY_SUCCEEDED(pCompiler->Compile(&SourceBuf, args.data(),
+                                            args.size(), nullptr,
+                                            IID_PPV_ARGS(&pResult)));
+        HRESULT status;
+        VERIFY_SUCCEEDED(pResult->GetStatus(&status));
+        succeeded = SUCCEEDED(status) &&
+                    pResult->HasOutput(DXC_OUT_TIME_REPORT);
+        if (!succeeded)
+          break;
+
+        CComPtr<IDxcBlobUtf8> pReport;
+        VERIFY_SUCCEEDED(pResult->GetOutput(DXC_OUT_TIME_REPORT,
+                                            IID_PPV_ARGS(&pReport), nullptr));
+        TimeReportTotals iterReport = ReadTimeReportTotals(std::string(
+            pReport->GetStringPointer(), pReport->GetStringLength()));
+        uint64_t iterCompileUs =
+            GetTimeReportTotal(iterReport, "Compile", "dur");
+        if (iterCompileUs < fileCompileUs) {
+          fileCompileUs = iterCompileUs;
+          report = std::move(iterReport);
+        }
+
+        CComPtr<IDxcBlob> pProgram;
+        VERIFY_SUCCEEDED(pResult->GetOutput(DXC_OUT_OBJECT,
+                                            IID_PPV_ARGS(&pProgram), nullptr));
+        fileOutputBytes = pProgram ? pProgram->GetBufferSize() : 0;
+
+        // Every compile produces the same program, so count it once. Only
+        // DXIL disassembles; SPIR-V programs count zero instructions.
+        if (i == 0 && pProgram) {
+          DxcBuffer ProgramBuf = {};
+          ProgramBuf.Ptr = pProgram->GetBufferPointer();
+          ProgramBuf.Size = pProgram->GetBufferSize();
+          CComPtr<IDxcResult> pDisassembly;
+          CComPtr<IDxcBlobUtf8> pText;
+          if (SUCCEEDED(pCompiler->Disassemble(&ProgramBuf,
+                                               IID_PPV_ARGS(&pDisassembly))) &&
+              SUCCEEDED(pDisassembly->GetOutput(
+                  DXC_OUT_DISASSEMBLY, IID_PPV_ARGS(&pText), nullptr)) &&
+              pText)
+            fileInstructions = CountDisassembledInstructions(std::string(
+                pText->GetStringPointer(), pText->GetStringLength()));
+        }
+      }
+
+      if (!succeeded) {
+        ++numFailed;
+        csv << config.name << "," << QuoteCsvField(CW2A(wPath).m_psz)
+            << ",0\n";
+        return;
+      }
+
+      // The outer "Compile" span covers the whole compile.
+      uint64_t fileAllocBytes =
+          GetTimeReportTotal(report, "Compile", "allocBytes");
+      uint64_t filePeakLiveBytes =
+          GetTimeReportTotal(report, "Compile", "peakLiveBytes");
+      if (filePeakLiveBytes == 0)
+        filePeakLiveBytes = GetProcessPeakRss();
+      csv << config.name << "," << QuoteCsvField(CW2A(wPath).m_psz) << ",1,"
+          << fileCompileUs;
+      for (const char *phase : phases)
+        csv << "," << GetTimeReportTotal(report, phase, "dur");
+      for (const char *pass : passes)
+        csv << "," << GetTimeReportTotal(report, pass, "dur") << ","
+            << GetTimeReportTotal(report, pass, "allocBytes");
+      csv << "," << fileAllocBytes << "," << filePeakLiveBytes << ","
+          << fileOutputBytes << "," << fileInstructions << "\n";
+      compileUs += fileCompileUs;
+      allocBytes += fileAllocBytes;
+      peakLiveBytes = std::max(peakLiveBytes, filePeakLiveBytes);
+      outputBytes += fileOutputBytes;
+      ++numSucceeded;
+    });
+
+    CA2W wConfigName(config.name);
+    WEX::Logging::Log::Comment(
+        FormatToWString(L"%ls: %u samples compiled, %u failed; compile %.2f "
+                        L"ms, %llu bytes allocated, %llu bytes peak, %llu "
+                        L"bytes of output",
+                        (const wchar_t *)wConfigName, numSucceeded, numFailed,
+                        compileUs / 1000.0, (unsigned long long)allocBytes,
+                        (unsigned long long)peakLiveBytes,
+                        (unsigned long long)outputBytes)
+            .data());
+    VERIFY_IS_TRUE(numSucceeded > 0);
+  }
+}
+
 TEST_F(CompilerTest, CompileWhenWorksThenDisassembleWorks) {
   CComPtr<IDxcCompiler> pCompiler;
   CComPtr<IDxcOperationResult> pResult;
@@ -1731,6 +2403,152 @@ TEST_F(CompilerTest, CompileWhenIncludeThenLoadInvoked) {
   VERIFY_ARE_EQUAL_WSTR(L"./helper.h;", pInclude->GetAllFileNames().c_str());
 }
 
+// Returns the named counter from the stats file of a -cache-dir directory.
+static uint64_t GetCompileCacheStat(const std::string &dir, const char *name) {
+  std::ifstream stats(dir + "/stats.txt");
+  std::string statName;
+  uint64_t value;
+  while (stats >> statName >> value) {
+    if (statName == name)
+      return value;
+  }
+  return 0;
+}
+
+TEST_F(CompilerTest, CompileWhenCacheDirThenResultsReused) {
+  using namespace llvm;
+
+  ::llvm::sys::fs::MSFileSystem *msfPtr;
+  VERIFY_SUCCEEDED(CreateMSFileSystemForDisk(&msfPtr));
+  std::unique_ptr<::llvm::sys::fs::MSFileSystem> msf(msfPtr);
+  ::llvm::sys::fs::AutoPerThreadSystem pts(msf.get());
+  IFTLLVM(pts.error_code());
+
+  SmallString<128> cacheDirPath;
+  VERIFY_IS_FALSE(
+      (bool)sys::fs::createUniqueDirectory("dxc-cache-test", cacheDirPath));
+  std::string cacheDir = cacheDirPath.str();
+  CA2W wCacheDir(cacheDir.c_str());
+
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcBlobEncoding> pSource;
+  VERIFY_SUCCEEDED(CreateCompiler(&pCompiler));
+  CreateBlobFromText(
+    "#include \"helper.h\"\r\n"
+    "float4 main() : SV_Target { return helper(); }", &pSource);
+
+  LPCWSTR args[] = { L"-cache-dir", wCacheDir, L"-cache-max-size", L"1" };
+  auto compile = [&](const char *pHelper) -> std::string {
+    // A lookup resolves the recorded include once more before a miss
+    // compiles.
+    CComPtr<TestIncludeHandler> pInclude = new TestIncludeHandler(m_dllSupport);
+    pInclude->CallResults.emplace_back(pHelper);
+    pInclude->CallResults.emplace_back(pHelper);
+    CComPtr<IDxcOperationResult> pResult;
+    VERIFY_SUCCEEDED(pCompiler->Compile(pSource, L"source.hlsl", L"main",
+      L"ps_6_0", args, _countof(args), nullptr, 0, pInclude, &pResult));
+    VerifyOperationSucceeded(pResult);
+    CComPtr<IDxcBlob> pProgram;
+    VERIFY_SUCCEEDED(pResult->GetResult(&pProgram));
+    return std::string((const char *)pProgram->GetBufferPointer(),
+                       pProgram->GetBufferSize());
+  };
+
+  const char *pHelper = "float4 helper() { return 1; }";
+  std::string program = compile(pHelper);
+  VERIFY_ARE_EQUAL(0u, GetCompileCacheStat(cacheDir, "hits"));
+  VERIFY_ARE_EQUAL(1u, GetCompileCacheStat(cacheDir, "misses"));
+  VERIFY_ARE_EQUAL(1u, GetCompileCacheStat(cacheDir, "stores"));
+
+  // The same compile is served from the cache.
+  VERIFY_IS_TRUE(program == compile(pHelper));
+  VERIFY_ARE_EQUAL(1u, GetCompileCacheStat(cacheDir, "hits"));
+  VERIFY_ARE_EQUAL(1u, GetCompileCacheStat(cacheDir, "misses"));
+
+  // An edited header invalidates the entry.
+  std::string editedProgram = compile("float4 helper() { return 2; }");
+  VERIFY_IS_FALSE(program == editedProgram);
+  VERIFY_ARE_EQUAL(1u, GetCompileCacheStat(cacheDir, "hits"));
+  VERIFY_ARE_EQUAL(2u, GetCompileCacheStat(cacheDir, "misses"));
+  VERIFY_ARE_EQUAL(2u, GetCompileCacheStat(cacheDir, "stores"));
+
+  // Growing past the size limit evicts entries other than the one just
+  // stored.
+  std::string stalePath = cacheDir + "/stale.dxcc";
+  {
+    std::ofstream stale(stalePath, std::ios::binary);
+    stale << std::string(2 * 1024 * 1024, '\0');
+    VERIFY_IS_TRUE(stale.good());
+  }
+  std::string thirdProgram = compile("float4 helper() { return 3; }");
+  VERIFY_IS_FALSE(sys::fs::exists(stalePath));
+  VERIFY_IS_TRUE(GetCompileCacheStat(cacheDir, "evictions") >= 1);
+  VERIFY_IS_TRUE(thirdProgram == compile("float4 helper() { return 3; }"));
+  VERIFY_ARE_EQUAL(2u, GetCompileCacheStat(cacheDir, "hits"));
+
+  std::error_code EC;
+  std::vector<std::string> files;
+  for (sys::fs::directory_iterator It(cacheDir, EC), End; It != End && !EC;
+       It.increment(EC))
+    files.push_back(It->path());
+  for (const std::string &file : files)
+    sys::fs::remove(file);
+  sys::fs::remove(cacheDir);
+}
+
+TEST_F(CompilerTest, CompileWhenPreambleCacheThenIncludeChangesApplied) {
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcBlobEncoding> pSource;
+
+  VERIFY_SUCCEEDED(CreateCompiler(&pCompiler));
+  CreateBlobFromText(
+    "#include \"helper.h\"\r\n"
+    "float4 main() : SV_Target { return helper() + VALUE; }", &pSource);
+
+  // The time report counts each cached file a compile reads as a hit, or as
+  // a miss if the file has changed since its tokens were recorded. The main
+  // file may be cached as well, so only differences in hits are checked.
+  LPCWSTR args[] = { L"-preamble-cache", L"-ftime-report" };
+  uint64_t hits = 0, misses = 0;
+  auto compile = [&](const char *pHelper, LPCWSTR pValue) -> HRESULT {
+    CComPtr<TestIncludeHandler> pInclude = new TestIncludeHandler(m_dllSupport);
+    pInclude->CallResults.emplace_back(pHelper);
+    DxcDefine define = { L"VALUE", pValue };
+    CComPtr<IDxcOperationResult> pResult;
+    VERIFY_SUCCEEDED(pCompiler->Compile(pSource, L"source.hlsl", L"main",
+      L"ps_6_0", args, _countof(args), &define, 1, pInclude, &pResult));
+    HRESULT status;
+    VERIFY_SUCCEEDED(pResult->GetStatus(&status));
+
+    CComPtr<IDxcResult> pReportResult;
+    CComPtr<IDxcBlobUtf8> pReport;
+    VERIFY_SUCCEEDED(pResult.QueryInterface(&pReportResult));
+    VERIFY_SUCCEEDED(pReportResult->GetOutput(DXC_OUT_TIME_REPORT,
+                                              IID_PPV_ARGS(&pReport), nullptr));
+    TimeReportTotals report = ReadTimeReportTotals(
+        std::string(pReport->GetStringPointer(), pReport->GetStringLength()));
+    hits = GetTimeReportTotal(report, "PreambleCacheHit", "count");
+    misses = GetTimeReportTotal(report, "PreambleCacheMiss", "count");
+    return status;
+  };
+
+  const char *pHelper = "float4 helper() { return 1; }";
+  VERIFY_SUCCEEDED(compile(pHelper, L"1"));
+  // Permutations with different defines reuse the tokens of the header.
+  VERIFY_SUCCEEDED(compile(pHelper, L"2"));
+  const uint64_t allHits = hits;
+  VERIFY_IS_TRUE(allHits >= 1);
+  VERIFY_ARE_EQUAL(0u, misses);
+  // An edited header must be lexed again rather than served from the cache.
+  VERIFY_FAILED(compile("float4_undefined helper() { return 1; }", L"2"));
+  VERIFY_ARE_EQUAL(allHits - 1, hits);
+  VERIFY_ARE_EQUAL(1u, misses);
+  // The failed compile did not replace the entry of the original header.
+  VERIFY_SUCCEEDED(compile(pHelper, L"3"));
+  VERIFY_ARE_EQUAL(allHits, hits);
+  VERIFY_ARE_EQUAL(0u, misses);
+}
+
 TEST_F(CompilerTest, CompileWhenIncludeThenLoadUsed) {
   CComPtr<IDxcCompiler> pCompiler;
   CComPtr<IDxcOperationResult> pResult;
@@ -2313,6 +3131,90 @@ TEST_F(CompilerTest, CompileWhenNoMemThenOOM) {
 }
 #endif
 
+TEST_F(CompilerTest, CompileWhenArenaAllocThenFewerAllocations) {
+  typedef std::chrono::steady_clock Clock;
+  const unsigned kIterations = 5;
+  std::string main_source =
+      "Texture2D<float4> tex : register(t0);\n"
+      "SamplerState samp : register(s0);\n"
+      "cbuffer CB : register(b0) { float4 weights[16]; };\n"
+      "float4 main(float2 uv : TEXCOORD) : SV_Target {\n"
+      "  float4 sum = 0;\n"
+      "  [unroll] for (int i = 0; i < 16; ++i)\n"
+      "    sum += tex.Sample(samp, uv + i * 0.01) * weights[i];\n"
+      "  return sum;\n"
+      "}\n";
+
+  DxcBuffer SourceBuf = {};
+  SourceBuf.Ptr = main_source.c_str();
+  SourceBuf.Size = main_source.size();
+  SourceBuf.Encoding = CP_UTF8;
+
+  InstrumentedHeapMalloc InstrMalloc;
+  InstrMalloc.ResetHeap();
+  VERIFY_IS_TRUE(m_dllSupport.HasCreateWithMalloc());
+  ULONG initialRefCount = InstrMalloc.GetRefCount();
+
+  // Compiles with and without the arena, returning the object, the number of
+  // allocations made from InstrMalloc and the wall time of each compile.
+  auto compile = [&](bool arena, std::string &object, ULONG &allocCount,
+                     double &ms) {
+    std::vector<LPCWSTR> args = {L"/Tps_6_0", L"/O3"};
+    if (arena)
+      args.push_back(L"-arena-alloc");
+    CComPtr<IDxcCompiler3> pCompiler;
+    VERIFY_SUCCEEDED(m_dllSupport.CreateInstance2(&InstrMalloc,
+                                                  CLSID_DxcCompiler,
+                                                  &pCompiler));
+    allocCount = InstrMalloc.GetAllocCount();
+    Clock::time_point start = Clock::now();
+    CComPtr<IDxcResult> pResult;
+    VERIFY_SUCCEEDED(pCompiler->Compile(&SourceBuf, args.data(), args.size(),
+                                        nullptr, IID_PPV_ARGS(&pResult)));
+    ms = std::chrono::duration<double, std::milli>(Clock::now() - start)
+             .count();
+    allocCount = InstrMalloc.GetAllocCount() - allocCount;
+    VerifyOperationSucceeded(pResult);
+    CComPtr<IDxcBlob> pObject;
+    VERIFY_SUCCEEDED(pResult->GetOutput(DXC_OUT_OBJECT,
+                                        IID_PPV_ARGS(&pObject), nullptr));
+    object.assign((const char *)pObject->GetBufferPointer(),
+                  pObject->GetBufferSize());
+  };
+
+  ULONG heapAllocs = 0, arenaAllocs = 0;
+  double heapMs = 0, arenaMs = 0;
+  for (unsigned i = 0; i < kIterations; ++i) {
+    std::string heapObject, arenaObject;
+    ULONG count;
+    double ms;
+    compile(false, heapObject, count, ms);
+    heapAllocs += count;
+    heapMs += ms;
+    compile(true, arenaObject, count, ms);
+    arenaAllocs += count;
+    arenaMs += ms;
+    VERIFY_IS_TRUE(heapObject == arenaObject);
+  }
+
+  // The arena returned its chunks when each compile finished, and the
+  // outputs copied out of it were released with the results.
+  if (InstrMalloc.GetSize() != 0) {
+    WEX::Logging::Log::Comment(L"Memory leak(s) detected");
+    InstrMalloc.DumpLeaks();
+    VERIFY_IS_TRUE(0 == InstrMalloc.GetSize());
+  }
+  VERIFY_ARE_EQUAL(initialRefCount, InstrMalloc.GetRefCount());
+  VERIFY_IS_TRUE(arenaAllocs < heapAllocs);
+
+  WEX::Logging::Log::Comment(
+      FormatToWString(L"Per compile: heap %u allocations, %.2f ms; "
+                      L"arena %u allocations, %.2f ms",
+                      heapAllocs / kIterations, heapMs / kIterations,
+                      arenaAllocs / kIterations, arenaMs / kIterations)
+          .data());
+}
+
 TEST_F(CompilerTest, CompileWhenShaderModelMismatchAttributeThenFail) {
   CComPtr<IDxcCompiler> pCompiler;
   CComPtr<IDxcOperationResult> pResult;
@@ -2396,6 +3298,47 @@ TEST_F(CompilerTest, CompileWhenRecursiveThenFail) {
   VerifyCompileFailed(ShaderTextMissing, L"vs_6_0", "missing entry point definition");
 }
 
+TEST_F(CompilerTest, CompileWhenBuiltinObjectTypeNamedThenDeclared) {
+  // Built-in object types are declared when first named, including through
+  // the 'sampler' alias and the descriptor heap globals.
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcOperationResult> pResult;
+  CComPtr<IDxcBlobEncoding> pSource;
+
+  VERIFY_SUCCEEDED(CreateCompiler(&pCompiler));
+  CreateBlobFromText(
+    "Texture2D t; sampler s;\r\n"
+    "float4 main(float2 uv : TEXCOORD) : SV_Target {\r\n"
+    "  Texture2D<float4> h = ResourceDescriptorHeap[0];\r\n"
+    "  return t.Sample(s, uv) + h.Sample(s, uv);\r\n"
+    "}", &pSource);
+
+  VERIFY_SUCCEEDED(pCompiler->Compile(pSource, L"source.hlsl", L"main",
+    L"ps_6_6", nullptr, 0, nullptr, 0, nullptr, &pResult));
+  HRESULT status;
+  VERIFY_SUCCEEDED(pResult->GetStatus(&status));
+  VERIFY_SUCCEEDED(status);
+
+  // Names qualified with the global scope declare them as well.
+  pSource.Release();
+  pResult.Release();
+  CreateBlobFromText(
+    "::Texture2D<float4> t; ::SamplerState s;\r\n"
+    "float4 main(float2 uv : TEXCOORD) : SV_Target {\r\n"
+    "  ::Texture2D u = t;\r\n"
+    "  return u.Sample(s, uv);\r\n"
+    "}", &pSource);
+  VERIFY_SUCCEEDED(pCompiler->Compile(pSource, L"source.hlsl", L"main",
+    L"ps_6_0", nullptr, 0, nullptr, 0, nullptr, &pResult));
+  VERIFY_SUCCEEDED(pResult->GetStatus(&status));
+  VERIFY_SUCCEEDED(status);
+
+  // Types the shader doesn't otherwise use still can't be redeclared.
+  VerifyCompileFailed(
+    "struct RayDesc { float x; };\r\n"
+    "float4 main() : SV_Target { return 0; }", L"ps_6_0", "RayDesc");
+}
+
 TEST_F(CompilerTest, CompileHlsl2015ThenFail) {
   CComPtr<IDxcCompiler> pCompiler;
   CComPtr<IDxcOperationResult> pResult;
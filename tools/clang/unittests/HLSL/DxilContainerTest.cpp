@@ -100,6 +100,7 @@ public:
   TEST_METHOD(CompileWhenOkThenCheckRDAT2)
   TEST_METHOD(CompileWhenOkThenCheckReflection1)
   TEST_METHOD(DxcUtils_CreateReflection)
+  TEST_METHOD(DxcUtils_CreateReflectionFromTables)
   TEST_METHOD(CompileWhenOKThenIncludesFeatureInfo)
   TEST_METHOD(CompileWhenOKThenIncludesSignatures)
   TEST_METHOD(CompileWhenSigSquareThenIncludeSplit)
@@ -534,6 +535,10 @@ public:
   void CodeGenTestCheck(LPCWSTR name) {
     std::wstring fullPath = hlsl_test::GetPathToHlslDataFile(name);
     FileRunTestResult t = FileRunTestResult::RunFromFileCommands(fullPath.c_str());
+    if (!t.Log.empty()) {
+      CA2W logWide(t.Log.c_str(), CP_UTF8);
+      WEX::Logging::Log::Comment(logWide);
+    }
     if (t.RunResult != 0) {
       CA2W commentWide(t.ErrorMessage.c_str(), CP_UTF8);
       WEX::Logging::Log::Comment(commentWide);
@@ -1548,6 +1553,83 @@ TEST_F(DxilContainerTest, DxcUtils_CreateReflection) {
   }
 }
 
+#ifdef _WIN32 // Reflection unsupported
+TEST_F(DxilContainerTest, DxcUtils_CreateReflectionFromTables) {
+  if (m_ver.SkipDxilVersion(1, 5)) return;
+
+  CComPtr<IDxcUtils> pUtils;
+  VERIFY_SUCCEEDED(m_dllSupport.CreateInstance(CLSID_DxcUtils, &pUtils));
+  CComPtr<IDxcCompiler> pCompiler;
+  VERIFY_SUCCEEDED(CreateCompiler(&pCompiler));
+  CComPtr<IDxcBlobEncoding> pSource;
+  CreateBlobFromText(
+    "struct S { float3 a; uint b[2]; };"
+    "cbuffer CB0 : register(b0) { float4 f4; S s; row_major float2x3 m; }"
+    "ConstantBuffer<S> cbS : register(b1);"
+    "StructuredBuffer<S> sb : register(t0);"
+    "RWStructuredBuffer<float4> rwsb : register(u1);"
+    "Texture2D<float4> tex : register(t1, space1);"
+    "SamplerState samp : register(s2);"
+    "float4 main(float4 pos : SV_Position, float2 uv : TEXCOORD1,"
+    "            nointerpolation uint id : ID) : SV_Target {"
+    "  rwsb[id] = f4;"
+    "  return tex.Sample(samp, uv) + s.a.x + s.b[1] + m._12 + cbS.a.y + sb[id].a.z;"
+    "}", &pSource);
+
+  LPCWSTR options[] = { L"-Qstrip_reflect" };
+  CComPtr<IDxcOperationResult> pResult;
+  VERIFY_SUCCEEDED(pCompiler->Compile(pSource, L"hlsl.hlsl", L"main",
+    L"ps_6_0", options, _countof(options), nullptr, 0, nullptr, &pResult));
+  HRESULT hr;
+  VERIFY_SUCCEEDED(pResult->GetStatus(&hr));
+  VERIFY_SUCCEEDED(hr);
+
+  CComPtr<IDxcResult> pResultV2;
+  CComPtr<IDxcBlob> pReflectionPart;
+  VERIFY_SUCCEEDED(pResult->QueryInterface(&pResultV2));
+  VERIFY_SUCCEEDED(pResultV2->GetOutput(DXC_OUT_REFLECTION, IID_PPV_ARGS(&pReflectionPart), nullptr));
+
+  // The reflection output holds a sequence of parts; keep a copy without the
+  // reflection tables to reflect from the module instead.
+  const char *pData = (const char *)pReflectionPart->GetBufferPointer();
+  size_t size = pReflectionPart->GetBufferSize();
+  std::string moduleOnly;
+  bool bFoundTables = false;
+  for (size_t offset = 0; offset + sizeof(hlsl::DxilPartHeader) <= size;) {
+    const hlsl::DxilPartHeader *pPart = (const hlsl::DxilPartHeader *)(pData + offset);
+    size_t partSize = sizeof(hlsl::DxilPartHeader) + pPart->PartSize;
+    if (pPart->PartFourCC == hlsl::DFCC_ReflectionTables)
+      bFoundTables = true;
+    else
+      moduleOnly.append(pData + offset, partSize);
+    offset += partSize;
+  }
+  VERIFY_IS_TRUE(bFoundTables);
+
+  DxcBuffer tablesBuffer = { pData, size, 0 };
+  CComPtr<ID3D12ShaderReflection> pTablesReflection;
+  VERIFY_SUCCEEDED(pUtils->CreateReflection(&tablesBuffer, IID_PPV_ARGS(&pTablesReflection)));
+  DxcBuffer moduleBuffer = { moduleOnly.data(), moduleOnly.size(), 0 };
+  CComPtr<ID3D12ShaderReflection> pModuleReflection;
+  VERIFY_SUCCEEDED(pUtils->CreateReflection(&moduleBuffer, IID_PPV_ARGS(&pModuleReflection)));
+
+  CompareReflection(pTablesReflection, pModuleReflection);
+  D3D12_SHADER_DESC desc;
+  VERIFY_SUCCEEDED(pTablesReflection->GetDesc(&desc));
+  VERIFY_ARE_EQUAL(desc.ConstantBuffers, 4);
+  VERIFY_ARE_EQUAL(desc.BoundResources, 6);
+  VERIFY_ARE_EQUAL(desc.InputParameters, 3);
+  VERIFY_ARE_EQUAL(pTablesReflection->GetRequiresFlags(),
+                   pModuleReflection->GetRequiresFlags());
+  VERIFY_ARE_EQUAL(pTablesReflection->GetGSInputPrimitive(),
+                   pModuleReflection->GetGSInputPrimitive());
+  VERIFY_IS_NOT_NULL(pTablesReflection->GetConstantBufferByName("CB0")->GetVariableByName("s"));
+  ID3D12ShaderReflectionType *pType =
+    pTablesReflection->GetVariableByName("s")->GetType();
+  VERIFY_ARE_EQUAL_STR(pType->GetMemberTypeName(1), "b");
+}
+#endif // _WIN32 - Reflection unsupported
+
 TEST_F(DxilContainerTest, CompileWhenOKThenIncludesFeatureInfo) {
   CComPtr<IDxcCompiler> pCompiler;
   CComPtr<IDxcBlobEncoding> pSource;
@@ -18,6 +18,7 @@
 #include "dxc/DXIL/DxilInstructions.h"
 #include "dxc/DxilContainer/DxilContainer.h"
 #include "dxc/DXIL/DxilModule.h"
+#include "dxc/DXIL/DxilEntryProps.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/MSFileSystem.h"
 #include "llvm/Support/FileSystem.h"
@@ -66,6 +67,8 @@ public:
   TEST_METHOD(MSGetNumThreads)
   TEST_METHOD(ASGetNumThreads)
 
+  TEST_METHOD(FunctionShaderFlags)
+
   TEST_METHOD(SetValidatorVersion)
 
   void VerifyValidatorVersionFails(
@@ -538,6 +541,63 @@ void DxilModuleTest::VerifyValidatorVersionMatches(
   }
 }
 
+TEST_F(DxilModuleTest, FunctionShaderFlags) {
+  Compiler c(m_dllSupport);
+  c.Compile(
+    "RWBuffer<uint> u;\n"
+    "float4 main(nointerpolation uint2 v : V) : SV_Target {\n"
+    "  double d = asdouble(v.x, v.y);\n"
+    "  u[0] = WaveActiveSum(v.x);\n"
+    "  return (float)(d * d);\n"
+    "}\n"
+    ,
+    L"ps_6_0"
+  );
+
+  DxilModule &DM = c.GetDxilModule();
+  const llvm::Function *F = DM.GetEntryFunction();
+  ShaderFlags flags = DM.GetFunctionShaderFlags(F);
+  VERIFY_IS_TRUE(flags.GetEnableDoublePrecision());
+  VERIFY_IS_TRUE(flags.GetWaveOps());
+  VERIFY_ARE_EQUAL(ShaderFlags::CollectShaderFlags(F, &DM).GetShaderFlagsRaw(),
+                   flags.GetShaderFlagsRaw());
+
+  // Combining the cached function flags matches the declared module flags.
+  const uint64_t mask = ShaderFlags::GetShaderFlagsRawForCollection();
+  ShaderFlags moduleFlags;
+  DM.CollectShaderFlagsForModule(moduleFlags);
+  VERIFY_ARE_EQUAL(DM.m_ShaderFlags.GetShaderFlagsRaw() & mask,
+                   moduleFlags.GetShaderFlagsRaw() & mask);
+
+  // Changing module state the flags depend on collects them again.
+  DM.SetDisableOptimization(!DM.GetDisableOptimization());
+  VERIFY_ARE_NOT_EQUAL(flags.GetDisableOptimizations(),
+                       DM.GetFunctionShaderFlags(F).GetDisableOptimizations());
+  VERIFY_ARE_EQUAL(ShaderFlags::CollectShaderFlags(F, &DM).GetShaderFlagsRaw(),
+                   DM.GetFunctionShaderFlags(F).GetShaderFlagsRaw());
+
+  // So does changing the entry properties.
+  DxilEntryProps &entryProps = DM.GetDxilEntryProps(F);
+  entryProps.props.shaderKind = DXIL::ShaderKind::Vertex;
+  VERIFY_ARE_EQUAL(ShaderFlags::CollectShaderFlags(F, &DM).GetShaderFlagsRaw(),
+                   DM.GetFunctionShaderFlags(F).GetShaderFlagsRaw());
+  entryProps.props.shaderKind = DXIL::ShaderKind::Pixel;
+
+  // A pass that changes the body invalidates the flags of the function.
+  llvm::Function *EntryF = DM.GetEntryFunction();
+  llvm::CallInst *WaveCall = nullptr;
+  for (llvm::BasicBlock &BB : *EntryF)
+    for (llvm::Instruction &I : BB)
+      if (hlsl::OP::IsDxilOpFuncCallInst(&I, DXIL::OpCode::WaveActiveOp))
+        WaveCall = llvm::cast<llvm::CallInst>(&I);
+  VERIFY_IS_NOT_NULL(WaveCall);
+  WaveCall->replaceAllUsesWith(llvm::UndefValue::get(WaveCall->getType()));
+  WaveCall->eraseFromParent();
+  VERIFY_IS_TRUE(DM.GetFunctionShaderFlags(EntryF).GetWaveOps());
+  DM.InvalidateFunctionShaderFlags(EntryF);
+  VERIFY_IS_FALSE(DM.GetFunctionShaderFlags(EntryF).GetWaveOps());
+}
+
 TEST_F(DxilModuleTest, SetValidatorVersion) {
   Compiler c(m_dllSupport);
   if (c.SkipDxil_Test(1, 4)) return;
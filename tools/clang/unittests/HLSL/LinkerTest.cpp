@@ -9,6 +9,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include "llvm/ADT/ArrayRef.h"
@@ -21,6 +22,7 @@
 #include "WexTestClass.h"
 #include "dxc/Test/HlslTestUtils.h"
 #include "dxc/Test/DxcTestUtils.h"
+#include "dxc/Support/microcom.h"
 #include "dxc/dxcapi.h"
 
 using namespace std;
@@ -41,6 +43,7 @@ public:
   TEST_METHOD(RunLinkResource);
   TEST_METHOD(RunLinkResourceWithBinding);
   TEST_METHOD(RunLinkAllProfiles);
+  TEST_METHOD(RunLinkBatch);
   TEST_METHOD(RunLinkFailNoDefine);
   TEST_METHOD(RunLinkFailReDefine);
   TEST_METHOD(RunLinkGlobalInit);
@@ -263,6 +266,87 @@ TEST_F(LinkerTest, RunLinkAllProfiles) {
   Link(L"cs_main", L"cs_6_0", pLinker, {libName, libResName}, {},{});
 }
 
+class TestLinkBatchCallback : public IDxcLinkBatchCallback {
+  DXC_MICROCOM_REF_FIELD(m_dwRef)
+public:
+  DXC_MICROCOM_ADDREF_RELEASE_IMPL(m_dwRef)
+  TestLinkBatchCallback(UINT32 jobCount)
+      : m_dwRef(0), CallCounts(jobCount), Results(jobCount) {}
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID iid, void** ppvObject) override {
+    return DoBasicQueryInterface<IDxcLinkBatchCallback>(this, iid, ppvObject);
+  }
+
+  std::mutex Lock;
+  std::vector<unsigned> CallCounts;
+  std::vector<CComPtr<IDxcOperationResult>> Results;
+
+  HRESULT STDMETHODCALLTYPE OnJobCompleted(UINT32 jobIndex, HRESULT hr,
+                                           IDxcOperationResult *pResult) override {
+    std::lock_guard<std::mutex> guard(Lock);
+    if (jobIndex >= CallCounts.size())
+      return E_INVALIDARG;
+    ++CallCounts[jobIndex];
+    if (SUCCEEDED(hr))
+      Results[jobIndex] = pResult;
+    return S_OK;
+  }
+};
+
+TEST_F(LinkerTest, RunLinkBatch) {
+  CComPtr<IDxcLinker> pLinker;
+  CreateLinker(&pLinker);
+  CComPtr<IDxcLinkerBatch> pBatch;
+  VERIFY_SUCCEEDED(pLinker.QueryInterface(&pBatch));
+
+  CComPtr<IDxcBlob> pEntryLib;
+  CompileLib(L"..\\CodeGenHLSL\\lib_entries2.hlsl", &pEntryLib);
+  LPCWSTR libName = L"entry";
+  RegisterDxcModule(libName, pEntryLib, pLinker);
+  CComPtr<IDxcBlob> pResLib;
+  CompileLib(L"..\\CodeGenHLSL\\lib_resource2.hlsl", &pResLib);
+  LPCWSTR libResName = L"res";
+  RegisterDxcModule(libResName, pResLib, pLinker);
+
+  // The last job links an entry with the wrong profile and must fail; every
+  // job must be reported exactly once.
+  LPCWSTR libNames[] = { libName, libResName };
+  struct { LPCWSTR pEntry, pProfile; } entries[] = {
+    { L"vs_main", L"vs_6_0" }, { L"hs_main", L"hs_6_0" },
+    { L"ds_main", L"ds_6_0" }, { L"gs_main", L"gs_6_0" },
+    { L"ps_main", L"ps_6_0" }, { L"cs_main", L"cs_6_0" },
+    { L"ps_main", L"vs_6_0" },
+  };
+  const UINT32 jobCount = _countof(entries);
+  std::vector<DxcLinkJob> jobs(jobCount);
+  for (UINT32 i = 0; i < jobCount; ++i) {
+    jobs[i].pEntryName = entries[i].pEntry;
+    jobs[i].pTargetProfile = entries[i].pProfile;
+    jobs[i].pLibNames = libNames;
+    jobs[i].LibCount = _countof(libNames);
+    jobs[i].pArguments = nullptr;
+    jobs[i].ArgCount = 0;
+  }
+
+  CComPtr<TestLinkBatchCallback> pCallback =
+      new TestLinkBatchCallback(jobCount);
+  VERIFY_SUCCEEDED(pBatch->LinkBatch(jobs.data(), jobCount, 4, pCallback));
+
+  for (UINT32 i = 0; i < jobCount; ++i) {
+    VERIFY_ARE_EQUAL(1U, pCallback->CallCounts[i]);
+    VERIFY_IS_NOT_NULL(pCallback->Results[i].p);
+    HRESULT status;
+    VERIFY_SUCCEEDED(pCallback->Results[i]->GetStatus(&status));
+    if (i == jobCount - 1) {
+      VERIFY_FAILED(status);
+    } else {
+      VERIFY_SUCCEEDED(status);
+    }
+  }
+
+  // The linker's own context is still usable after a batch.
+  Link(L"ps_main", L"ps_6_0", pLinker, {libName}, {}, {});
+}
+
 TEST_F(LinkerTest, RunLinkFailNoDefine) {
   CComPtr<IDxcBlob> pEntryLib;
   CompileLib(L"..\\CodeGenHLSL\\lib_cs_entry.hlsl", &pEntryLib);
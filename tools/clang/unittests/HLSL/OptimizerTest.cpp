@@ -66,6 +66,7 @@ public:
   TEST_METHOD(OptimizerWhenSlice2ThenOK)
   TEST_METHOD(OptimizerWhenSlice3ThenOK)
   TEST_METHOD(OptimizerWhenSliceWithIntermediateOptionsThenOK)
+  TEST_METHOD(OptimizerWhenSessionThenMatchesRunOptimizer)
 
   void OptimizerWhenSliceNThenOK(int optLevel);
   void OptimizerWhenSliceNThenOK(int optLevel, LPCSTR pText, LPCWSTR pTarget, llvm::ArrayRef<LPCWSTR> args = {});
@@ -259,3 +260,78 @@ void OptimizerTest::OptimizerWhenSliceNThenOK(int optLevel, LPCSTR pText, LPCWST
     }
   }
 }
+
+TEST_F(OptimizerTest, OptimizerWhenSessionThenMatchesRunOptimizer) {
+  LPCSTR SampleProgram =
+    "float4 main(float4 pos : SV_Position, int n : N) : SV_Target {\r\n"
+    "  float4 sum = 0;\r\n"
+    "  for (int i = 0; i < n; ++i)\r\n"
+    "    sum += pos * i;\r\n"
+    "  return sum;\r\n"
+    "}";
+  CComPtr<IDxcCompiler> pCompiler;
+  CComPtr<IDxcOptimizer2> pOptimizer;
+  CComPtr<IDxcOperationResult> pResult;
+  CComPtr<IDxcBlobEncoding> pSource;
+  CComPtr<IDxcBlob> pProgram;
+
+  VERIFY_SUCCEEDED(m_dllSupport.CreateInstance(CLSID_DxcCompiler, &pCompiler));
+  VERIFY_SUCCEEDED(m_dllSupport.CreateInstance(CLSID_DxcOptimizer, &pOptimizer));
+  Utf8ToBlob(m_dllSupport, SampleProgram, &pSource);
+  LPCWSTR compileArgs[] = { L"/Od" };
+  VERIFY_SUCCEEDED(pCompiler->Compile(pSource, L"source.hlsl", L"main", L"ps_6_0",
+    compileArgs, _countof(compileArgs), nullptr, 0, nullptr, &pResult));
+  VerifyOperationSucceeded(pResult);
+  VERIFY_SUCCEEDED(pResult->GetResult(&pProgram));
+
+  // Running two pipelines in one session gives the same module as two
+  // RunOptimizer calls with a bitcode round trip in between.
+  LPCWSTR firstPasses[] = { L"-mem2reg", L"-simplifycfg" };
+  LPCWSTR secondPasses[] = { L"-instcombine", L"-dce" };
+  CComPtr<IDxcBlob> pFirstModule, pExpectedModule;
+  VERIFY_SUCCEEDED(pOptimizer->RunOptimizer(pProgram, firstPasses,
+    _countof(firstPasses), &pFirstModule, nullptr));
+  VERIFY_SUCCEEDED(pOptimizer->RunOptimizer(pFirstModule, secondPasses,
+    _countof(secondPasses), &pExpectedModule, nullptr));
+
+  CComPtr<IDxcOptimizerSession> pSession;
+  VERIFY_SUCCEEDED(pOptimizer->CreateSession(pProgram, &pSession));
+  LPCWSTR secondPassesWithStats[] = { L"-opt-stats", L"-instcombine", L"-dce" };
+  VERIFY_SUCCEEDED(pSession->DefinePipeline(L"first", firstPasses,
+    _countof(firstPasses)));
+  VERIFY_SUCCEEDED(pSession->DefinePipeline(L"second", secondPassesWithStats,
+    _countof(secondPassesWithStats)));
+  VERIFY_ARE_EQUAL(E_INVALIDARG, pSession->RunPipeline(L"undefined", nullptr));
+  VERIFY_SUCCEEDED(pSession->RunPipeline(L"first", nullptr));
+  VERIFY_SUCCEEDED(pSession->RunPipeline(L"second", nullptr));
+
+  CComPtr<IDxcBlob> pSessionModule;
+  CComPtr<IDxcBlobEncoding> pSessionText;
+  VERIFY_SUCCEEDED(pSession->GetModule(&pSessionModule, &pSessionText));
+  VERIFY_ARE_EQUAL(pExpectedModule->GetBufferSize(),
+                   pSessionModule->GetBufferSize());
+  VERIFY_IS_TRUE(0 == memcmp(pExpectedModule->GetBufferPointer(),
+                             pSessionModule->GetBufferPointer(),
+                             pSessionModule->GetBufferSize()));
+  VERIFY_IS_TRUE(BlobToUtf8(pSessionText).find("define void @main()") !=
+                 std::string::npos);
+
+  // A pipeline can run again, and -S output is returned for each run.
+  LPCWSTR printPasses[] = { L"-S" };
+  CComPtr<IDxcBlobEncoding> pPrinted;
+  VERIFY_SUCCEEDED(pSession->DefinePipeline(L"print", printPasses,
+    _countof(printPasses)));
+  VERIFY_SUCCEEDED(pSession->RunPipeline(L"second", nullptr));
+  VERIFY_SUCCEEDED(pSession->RunPipeline(L"print", &pPrinted));
+  VERIFY_IS_TRUE(BlobToUtf8(pPrinted) == BlobToUtf8(pSessionText));
+
+  // Only the pipeline built with -opt-stats reports, once per pass and run.
+  CComPtr<IDxcBlobEncoding> pStats;
+  VERIFY_SUCCEEDED(pSession->GetStatistics(&pStats));
+  std::string stats = BlobToUtf8(pStats);
+  VERIFY_IS_TRUE(stats.find("pipeline\tpass\tms\t") == 0);
+  VERIFY_ARE_EQUAL(5, (int)std::count(stats.begin(), stats.end(), '\n'));
+  VERIFY_IS_TRUE(stats.find("second\tinstcombine\t") != std::string::npos);
+  VERIFY_IS_TRUE(stats.find("second\tdce\t") != std::string::npos);
+  VERIFY_IS_TRUE(stats.find("first\t") == std::string::npos);
+}
@@ -69,6 +69,11 @@ public:
   TEST_METHOD(ReadOptionsWhenJoinedThenOK)
   TEST_METHOD(ReadOptionsWhenNoEntryThenOK)
   TEST_METHOD(ReadOptionsForOutputObject)
+  TEST_METHOD(ReadOptionsForSelectValidator)
+  TEST_METHOD(ReadOptionsForCacheDir)
+  TEST_METHOD(ReadOptionsForTimeReport)
+  TEST_METHOD(ReadOptionsForPreambleCache)
+  TEST_METHOD(ReadOptionsForArenaAlloc)
 
   TEST_METHOD(ReadOptionsForDxcWhenApiArgMissingThenFail)
   TEST_METHOD(ReadOptionsForApiWhenApiArgMissingThenOK)
@@ -136,6 +141,122 @@ TEST_F(OptionsTest, ReadOptionsForOutputObject) {
   VERIFY_ARE_EQUAL_STR("hlsl.dxbc", o->OutputObject.data());  
 }
 
+TEST_F(OptionsTest, ReadOptionsForSelectValidator) {
+  const wchar_t *Args[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl"};
+  MainArgsArr ArgsArr(Args);
+  std::unique_ptr<DxcOpts> o = ReadOptsTest(ArgsArr, DxcFlags);
+  EXPECT_EQ(ValidatorSelection::Auto, o->SelectValidator);
+
+  const wchar_t *ArgsInternal[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl", L"-select-validator", L"internal"};
+  MainArgsArr ArgsInternalArr(ArgsInternal);
+  o = ReadOptsTest(ArgsInternalArr, DxcFlags);
+  EXPECT_EQ(ValidatorSelection::Internal, o->SelectValidator);
+
+  const wchar_t *ArgsExternal[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl", L"/select-validator", L"External"};
+  MainArgsArr ArgsExternalArr(ArgsExternal);
+  o = ReadOptsTest(ArgsExternalArr, DxcFlags);
+  EXPECT_EQ(ValidatorSelection::External, o->SelectValidator);
+
+  const wchar_t *ArgsInvalid[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl", L"-select-validator", L"fastest"};
+  MainArgsArr ArgsInvalidArr(ArgsInvalid);
+  ReadOptsTest(ArgsInvalidArr, DxcFlags,
+               "Unsupported value 'fastest' for -select-validator option.");
+}
+
+TEST_F(OptionsTest, ReadOptionsForCacheDir) {
+  const wchar_t *Args[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl"};
+  MainArgsArr ArgsArr(Args);
+  std::unique_ptr<DxcOpts> o = ReadOptsTest(ArgsArr, DxcFlags);
+  EXPECT_TRUE(o->CacheDir.empty());
+  EXPECT_EQ(1024u, o->CacheMaxSize);
+
+  const wchar_t *ArgsCache[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl", L"-cache-dir", L"shadercache",
+      L"-cache-max-size", L"64"};
+  MainArgsArr ArgsCacheArr(ArgsCache);
+  o = ReadOptsTest(ArgsCacheArr, DxcFlags);
+  VERIFY_ARE_EQUAL_STR("shadercache", o->CacheDir.data());
+  EXPECT_EQ(64u, o->CacheMaxSize);
+
+  const wchar_t *ArgsInvalid[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl", L"-cache-dir", L"shadercache",
+      L"-cache-max-size", L"0"};
+  MainArgsArr ArgsInvalidArr(ArgsInvalid);
+  ReadOptsTest(ArgsInvalidArr, DxcFlags,
+               "Unsupported value '0' for -cache-max-size option.");
+}
+
+TEST_F(OptionsTest, ReadOptionsForTimeReport) {
+  const wchar_t *Args[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl"};
+  MainArgsArr ArgsArr(Args);
+  std::unique_ptr<DxcOpts> o = ReadOptsTest(ArgsArr, DxcFlags);
+  EXPECT_FALSE(o->TimeReport);
+  EXPECT_TRUE(o->OutputTimeReportFile.empty());
+
+  const wchar_t *ArgsReport[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl", L"-ftime-report"};
+  MainArgsArr ArgsReportArr(ArgsReport);
+  o = ReadOptsTest(ArgsReportArr, DxcFlags);
+  EXPECT_TRUE(o->TimeReport);
+  EXPECT_TRUE(o->OutputTimeReportFile.empty());
+
+  // -Ftr implies -ftime-report.
+  const wchar_t *ArgsFile[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl", L"/Ftr",      L"report.json"};
+  MainArgsArr ArgsFileArr(ArgsFile);
+  o = ReadOptsTest(ArgsFileArr, DxcFlags);
+  EXPECT_TRUE(o->TimeReport);
+  VERIFY_ARE_EQUAL_STR("report.json", o->OutputTimeReportFile.data());
+}
+
+TEST_F(OptionsTest, ReadOptionsForPreambleCache) {
+  const wchar_t *Args[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl"};
+  MainArgsArr ArgsArr(Args);
+  std::unique_ptr<DxcOpts> o = ReadOptsTest(ArgsArr, DxcFlags);
+  EXPECT_FALSE(o->PreambleCache);
+
+  const wchar_t *ArgsCache[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl", L"-preamble-cache"};
+  MainArgsArr ArgsCacheArr(ArgsCache);
+  o = ReadOptsTest(ArgsCacheArr, DxcFlags);
+  EXPECT_TRUE(o->PreambleCache);
+}
+
+TEST_F(OptionsTest, ReadOptionsForArenaAlloc) {
+  const wchar_t *Args[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl"};
+  MainArgsArr ArgsArr(Args);
+  std::unique_ptr<DxcOpts> o = ReadOptsTest(ArgsArr, DxcFlags);
+  EXPECT_FALSE(o->ArenaAlloc);
+
+  const wchar_t *ArgsArena[] = {
+      L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
+      L"hlsl.hlsl", L"-arena-alloc"};
+  MainArgsArr ArgsArenaArr(ArgsArena);
+  o = ReadOptsTest(ArgsArenaArr, DxcFlags);
+  EXPECT_TRUE(o->ArenaAlloc);
+}
+
 TEST_F(OptionsTest, ReadOptionsConflict) {
   const wchar_t *matrixArgs[] = {
       L"exe.exe",   L"/E",        L"main",    L"/T",           L"ps_6_0",
@@ -25,6 +25,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cfloat>
+#include <chrono>
 #include "dxc/DxilContainer/DxilContainer.h"
 #include "dxc/Support/WinIncludes.h"
 #include "dxc/dxcapi.h"
@@ -65,6 +66,7 @@
 #include <../lib/DxilDia/DxcPixLiveVariables.h>
 #include <../lib/DxilDia/DxcPixLiveVariables_FragmentIterator.h>
 #include <dxc/DxilPIXPasses/DxilPIXVirtualRegisters.h>
+#include <dxc/DxilPIXPasses/DxilDebugTrace.h>
 
 using namespace std;
 using namespace hlsl;
@@ -190,7 +192,9 @@ public:
   TEST_METHOD(DiaLoadRelocatedBitcode)
   TEST_METHOD(DiaLoadBitcodePlusExtraData)
   TEST_METHOD(DiaCompileArgs)
+  TEST_METHOD(DiaLoadLargeShaderBenchmark)
   TEST_METHOD(PixDebugCompileInfo)
+  TEST_METHOD(PixDebugCompactTraceDecode)
 
   TEST_METHOD(PixStructAnnotation_Simple)
   TEST_METHOD(PixStructAnnotation_CopiedStruct)
@@ -1502,6 +1506,86 @@ TEST_F(PixTest, DiaLoadDebugThenOK) {
   CompileTestAndLoadDia(m_dllSupport, nullptr);
 }
 
+TEST_F(PixTest, DiaLoadLargeShaderBenchmark) {
+  // Like the compile matrix, this only runs when the BenchmarkOutput
+  // parameter is set; the timings are written to the log.
+  WEX::Common::String outputPath;
+  if (FAILED(WEX::TestExecution::RuntimeParameters::TryGetValue(
+          L"BenchmarkOutput", outputPath))) {
+    WEX::Logging::Log::Comment(
+        L"Skipping the benchmark; set BenchmarkOutput to run it.");
+    return;
+  }
+
+  // Many small helpers inlined into one entry point give a debug module with
+  // thousands of instructions, lines and symbols.
+  const unsigned kNumHelpers = 400;
+  std::ostringstream source;
+  source << "RWStructuredBuffer<float4> buf : register(u0);\n";
+  for (unsigned i = 0; i < kNumHelpers; ++i) {
+    source << "float4 helper" << i << "(float4 v, uint idx) {\n"
+           << "  float4 a = v * " << i + 1 << ".0f;\n"
+           << "  float4 b = buf[idx + " << i << "];\n"
+           << "  return a + b;\n"
+           << "}\n";
+  }
+  source << "[numthreads(64,1,1)] void main(uint tid : SV_DispatchThreadID) {\n"
+         << "  float4 v = buf[tid];\n";
+  for (unsigned i = 0; i < kNumHelpers; ++i)
+    source << "  v = helper" << i << "(v, tid);\n";
+  source << "  buf[tid] = v;\n}\n";
+
+  CComPtr<IDxcBlob> pDebugContent;
+  CComPtr<IDxcLibrary> pLib;
+  VERIFY_SUCCEEDED(m_dllSupport.CreateInstance(CLSID_DxcLibrary, &pLib));
+  CompileAndGetDebugPart(m_dllSupport, source.str().c_str(), L"cs_6_0",
+                         &pDebugContent);
+
+  typedef std::chrono::steady_clock Clock;
+  auto ToMs = [](Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+  };
+
+  CComPtr<IStream> pStream;
+  CComPtr<IDiaDataSource> pDiaSource;
+  CComPtr<IDiaSession> pSession;
+  VERIFY_SUCCEEDED(pLib->CreateStreamFromBlobReadOnly(pDebugContent, &pStream));
+  VERIFY_SUCCEEDED(
+      m_dllSupport.CreateInstance(CLSID_DxcDiaDataSource, &pDiaSource));
+
+  Clock::time_point start = Clock::now();
+  VERIFY_SUCCEEDED(pDiaSource->loadDataFromIStream(pStream));
+  VERIFY_SUCCEEDED(pDiaSource->openSession(&pSession));
+  Clock::duration open = Clock::now() - start;
+
+  // The first line lookup builds the instruction index.
+  CComPtr<IDiaEnumLineNumbers> pLines;
+  start = Clock::now();
+  VERIFY_SUCCEEDED(pSession->findLinesByRVA(0, 1, &pLines));
+  Clock::duration index = Clock::now() - start;
+
+  // The first symbol lookup builds the symbols.
+  CComPtr<IDiaSymbol> pGlobalScope;
+  start = Clock::now();
+  VERIFY_SUCCEEDED(pSession->get_globalScope(&pGlobalScope));
+  Clock::duration symbols = Clock::now() - start;
+
+  // Later lookups are served from the index.
+  const DWORD kNumLookups = 1000;
+  start = Clock::now();
+  for (DWORD rva = 0; rva < kNumLookups; ++rva) {
+    CComPtr<IDiaEnumLineNumbers> pRvaLines;
+    if (FAILED(pSession->findLinesByRVA(rva, 1, &pRvaLines)))
+      break;
+  }
+  Clock::duration lookups = Clock::now() - start;
+
+  LogCommentFmt(L"open %.2f ms, instruction index %.2f ms, symbols %.2f ms, "
+                L"%u line lookups %.2f ms",
+                ToMs(open), ToMs(index), ToMs(symbols), kNumLookups,
+                ToMs(lookups));
+}
+
 TEST_F(PixTest, DiaTableIndexThenOK) {
   CComPtr<IDiaDataSource> pDiaSource;
   CComPtr<IDiaSession> pDiaSession;
@@ -1640,6 +1724,112 @@ TEST_F(PixTest, PixDebugCompileInfo) {
   VERIFY_ARE_EQUAL(std::wstring(profile), std::wstring(hlslTarget));
 }
 
+TEST_F(PixTest, PixDebugCompactTraceDecode) {
+  using namespace pix_dxil::CompactDebugTrace;
+
+  const char *hlsl = R"(
+RWStructuredBuffer<float> floatRWUAV: register(u0);
+RWStructuredBuffer<double> doubleRWUAV: register(u1);
+
+[numthreads(1, 1, 1)]
+void main(uint3 tid : SV_DispatchThreadID)
+{
+    float sum = 0;
+    for (uint i = 0; i < tid.x; ++i)
+    {
+        if (i & 1)
+            sum += floatRWUAV[i];
+        else
+            doubleRWUAV[i] = sum * 2.0;
+    }
+    floatRWUAV[0] = sum;
+}
+)";
+
+  auto pOperationResult = Compile(hlsl, L"cs_6_0", {L"-Od"});
+  CComPtr<IDxcBlob> pBlob;
+  CheckOperationSucceeded(pOperationResult, &pBlob);
+  CComPtr<IDxcBlob> pDxil = FindModule(DFCC_ShaderDebugInfoDXIL, pBlob);
+  PassOutput passOutput = RunAnnotationPasses(pDxil);
+
+  CComPtr<IDxcOptimizer> pOptimizer;
+  VERIFY_SUCCEEDED(
+      m_dllSupport.CreateInstance(CLSID_DxcOptimizer, &pOptimizer));
+  std::vector<LPCWSTR> Options;
+  Options.push_back(L"-opt-mod-passes");
+  Options.push_back(L"-hlsl-dxil-debug-instrumentation,compact=1");
+  CComPtr<IDxcBlob> pInstrumented;
+  CComPtr<IDxcBlobEncoding> pText;
+  VERIFY_SUCCEEDED(pOptimizer->RunOptimizer(passOutput.blob, Options.data(),
+                                            Options.size(), &pInstrumented,
+                                            &pText));
+  std::string outputText;
+  if (pText->GetBufferSize() != 0) {
+    outputText = reinterpret_cast<const char *>(pText->GetBufferPointer());
+  }
+
+  BlockTable Blocks;
+  VERIFY_IS_TRUE(ParseBlockTable(outputText, Blocks));
+  VERIFY_IS_TRUE(Blocks.size() > 1);
+
+  // At -Od, "sum = 0" stores a constant, which goes in the table.
+  bool HasConstantStep = false;
+  for (const std::vector<BlockStep> &BlockSteps : Blocks)
+    for (const BlockStep &S : BlockSteps)
+      HasConstantStep |= S.ConstantValue;
+  VERIFY_IS_TRUE(HasConstantStep);
+
+  // Synthesize what the instrumented shader would write for one invocation
+  // that ran through every block: a start marker followed by one record per
+  // block, using each step's instruction number as its value unless the table
+  // holds it.
+  const uint32_t UID = 42;
+  std::vector<uint32_t> Trace = {0, UID};
+  std::vector<Step> Expected;
+  for (uint32_t Block = 0; Block < Blocks.size(); ++Block) {
+    size_t HeaderPos = Trace.size();
+    Trace.insert(Trace.end(),
+                 {0, UID, Block, (uint32_t)Blocks[Block].size() << 16});
+    for (const BlockStep &S : Blocks[Block]) {
+      Step Decoded = {UID, S.InstNum, S.Kind, 0, S.ValueOrdinal};
+      if (S.Kind != StepKindVoid) {
+        if (S.ConstantValue) {
+          Decoded.Value = S.Value;
+        } else {
+          Decoded.Value = S.InstNum;
+          Trace.push_back(S.InstNum);
+          if (ValueDwords(S.Kind) == 2) {
+            Decoded.Value |= (uint64_t)Block << 32;
+            Trace.push_back(Block);
+          }
+        }
+        if (S.DynamicOrdinalIndex) {
+          Decoded.ValueOrdinal = (S.ValueOrdinal & 0xFFFF0000) | Block;
+          Trace.push_back(Block);
+        }
+      }
+      Expected.push_back(Decoded);
+    }
+    Trace[HeaderPos] =
+        (RecordType << 8) | ((uint32_t)(Trace.size() - HeaderPos) << 16);
+  }
+
+  std::vector<Step> Steps;
+  VERIFY_IS_TRUE(Decode(Trace.data(), Trace.size(), Blocks, Steps));
+  VERIFY_ARE_EQUAL(Expected.size(), Steps.size());
+  for (size_t i = 0; i < Steps.size(); ++i) {
+    VERIFY_ARE_EQUAL(Expected[i].UID, Steps[i].UID);
+    VERIFY_ARE_EQUAL(Expected[i].InstNum, Steps[i].InstNum);
+    VERIFY_ARE_EQUAL(Expected[i].Kind, Steps[i].Kind);
+    VERIFY_ARE_EQUAL(Expected[i].Value, Steps[i].Value);
+    VERIFY_ARE_EQUAL(Expected[i].ValueOrdinal, Steps[i].ValueOrdinal);
+  }
+
+  // A record cut short by the end of the UAV doesn't decode.
+  Steps.clear();
+  VERIFY_IS_FALSE(Decode(Trace.data(), Trace.size() - 1, Blocks, Steps));
+}
+
 // This function lives in lib\DxilPIXPasses\DxilAnnotateWithVirtualRegister.cpp
 // Declared here so we can test it.
 uint32_t CountStructMembers(llvm::Type const* pType);
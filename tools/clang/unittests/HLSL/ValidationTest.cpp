@@ -14,6 +14,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <chrono>
 
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Regex.h"
@@ -296,6 +297,8 @@ public:
 
   TEST_METHOD(ValidateRootSigContainer)
   TEST_METHOD(ValidatePrintfNotAllowed)
+  TEST_METHOD(ValidateLargeLibrary)
+  TEST_METHOD(ValidateLargeLibraryWhenErrorsThenInModuleOrder)
 
   dxc::DxcDllSupport m_dllSupport;
   VersionSupportInfo m_ver;
@@ -303,6 +306,10 @@ public:
   void TestCheck(LPCWSTR name) {
     std::wstring fullPath = hlsl_test::GetPathToHlslDataFile(name);
     FileRunTestResult t = FileRunTestResult::RunFromFileCommands(fullPath.c_str());
+    if (!t.Log.empty()) {
+      CA2W logWide(t.Log.c_str(), CP_UTF8);
+      WEX::Logging::Log::Comment(logWide);
+    }
     if (t.RunResult != 0) {
       CA2W commentWide(t.ErrorMessage.c_str(), CP_UTF8);
       WEX::Logging::Log::Comment(commentWide);
@@ -3836,3 +3843,121 @@ TEST_F(ValidationTest, ValidateRootSigContainer) {
 TEST_F(ValidationTest, ValidatePrintfNotAllowed) {
   TestCheck(L"..\\CodeGenHLSL\\printf.hlsl");
 }
+
+TEST_F(ValidationTest, ValidateLargeLibrary) {
+  // Enough function bodies for the validator to spread them across threads;
+  // the time taken is logged for comparison between builds.
+  const unsigned functionCount = 256;
+  std::string source = "RWStructuredBuffer<float4> buf : register(u0);\n";
+  for (unsigned i = 0; i < functionCount; ++i) {
+    std::string n = std::to_string(i);
+    source += "export float4 f" + n + "(uint idx, float4 v) {\n"
+              "  float4 r = buf[idx] * v + " + n + ";\n"
+              "  for (uint j = 0; j < idx % 4; ++j)\n"
+              "    r = sin(r) * buf[idx + j];\n"
+              "  buf[idx] = r;\n"
+              "  return r;\n"
+              "}\n";
+  }
+
+  CComPtr<IDxcBlobEncoding> pSource;
+  Utf8ToBlob(m_dllSupport, source.c_str(), &pSource);
+  LPCWSTR args[] = { L"-Vd" };
+  CComPtr<IDxcBlob> pProgram;
+  if (!CompileSource(pSource, "lib_6_3", args, _countof(args), nullptr, 0,
+                     &pProgram))
+    return;
+
+  auto start = std::chrono::steady_clock::now();
+  CheckValidationMsgs(pProgram, {});
+  auto end = std::chrono::steady_clock::now();
+  auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+  LogCommentFmt(L"Validated %u library functions in %u ms", functionCount,
+                (unsigned)dur.count());
+}
+
+TEST_F(ValidationTest, ValidateLargeLibraryWhenErrorsThenInModuleOrder) {
+  // Bodies of a library this size are validated in parallel, but the
+  // diagnostics must come out as serial validation emits them: deduplicated
+  // and in module order. A library of only the failing functions is small
+  // enough to be validated serially and gives the expected output.
+  const unsigned functionCount = 256;
+  const unsigned failing[] = {3, 70, 71, 140, 255};
+  auto makeSource = [&](bool onlyFailing) {
+    std::string source = "RWStructuredBuffer<float4> buf : register(u0);\n";
+    for (unsigned i = 0; i < functionCount; ++i) {
+      bool fails = std::find(std::begin(failing), std::end(failing), i) !=
+                   std::end(failing);
+      if (onlyFailing && !fails)
+        continue;
+      std::string n = std::to_string(i);
+      source += "export float4 f" + n + "(uint idx, float4 v) {\n"
+                "  float4 r = buf[idx] * v + " + n + ";\n"
+                "  for (uint j = 0; j < idx % 4; ++j)\n"
+                "    r = " + (fails ? "log" : "sin") + "(r) * buf[idx + j];\n"
+                "  buf[idx] = r;\n"
+                "  return r;\n"
+                "}\n";
+    }
+    return source;
+  };
+
+  // Returns the validation errors for the source, with an infinity passed
+  // to every logarithm.
+  auto validate = [&](const std::string &source) -> std::string {
+    CComPtr<IDxcBlobEncoding> pSource;
+    Utf8ToBlob(m_dllSupport, source.c_str(), &pSource);
+    LPCWSTR args[] = { L"-Vd" };
+    CComPtr<IDxcBlob> pProgram;
+    if (!CompileSource(pSource, "lib_6_3", args, _countof(args), nullptr, 0,
+                       &pProgram))
+      return std::string();
+    std::string text;
+    DisassembleProgram(pProgram, &text);
+    llvm::Regex logRE("op\\.unary\\.f32\\(i32 23, float %[^)]+\\)");
+    llvm::SmallVector<llvm::StringRef, 1> matches;
+    while (logRE.match(text, &matches)) {
+      size_t pos = matches[0].data() - text.data();
+      text.replace(pos, matches[0].size(),
+                   "op.unary.f32(i32 23, float 0x7FF0000000000000)");
+    }
+
+    CComPtr<IDxcBlobEncoding> pText;
+    CComPtr<IDxcAssembler> pAssembler;
+    CComPtr<IDxcOperationResult> pAssembleResult;
+    CComPtr<IDxcBlob> pContainer;
+    Utf8ToBlob(m_dllSupport, text.c_str(), &pText);
+    VERIFY_SUCCEEDED(
+        m_dllSupport.CreateInstance(CLSID_DxcAssembler, &pAssembler));
+    VERIFY_SUCCEEDED(pAssembler->AssembleToContainer(pText, &pAssembleResult));
+    VERIFY_SUCCEEDED(pAssembleResult->GetResult(&pContainer));
+
+    CComPtr<IDxcValidator> pValidator;
+    CComPtr<IDxcOperationResult> pResult;
+    CComPtr<IDxcBlobEncoding> pErrors;
+    HRESULT status;
+    VERIFY_SUCCEEDED(
+        m_dllSupport.CreateInstance(CLSID_DxcValidator, &pValidator));
+    VERIFY_SUCCEEDED(pValidator->Validate(pContainer, DxcValidatorFlags_Default,
+                                          &pResult));
+    VERIFY_SUCCEEDED(pResult->GetStatus(&status));
+    VERIFY_FAILED(status);
+    VERIFY_SUCCEEDED(pResult->GetErrorBuffer(&pErrors));
+    return BlobToUtf8(pErrors);
+  };
+
+  std::string serialErrors = validate(makeSource(/*onlyFailing*/ true));
+  if (serialErrors.empty())
+    return;
+  std::string parallelErrors = validate(makeSource(/*onlyFailing*/ false));
+  VERIFY_ARE_EQUAL_STR(serialErrors.c_str(), parallelErrors.c_str());
+
+  // Every failing function is reported, in module order.
+  VERIFY_IS_TRUE(serialErrors.find("No indefinite logarithm") !=
+                 std::string::npos);
+  size_t pos = 0;
+  for (unsigned i : failing) {
+    pos = parallelErrors.find("?f" + std::to_string(i) + "@@", pos);
+    VERIFY_ARE_NOT_EQUAL(std::string::npos, pos);
+  }
+}
@@ -639,25 +639,26 @@ FileRunCommandResult FileRunCommandPart::RunD3DReflect(dxc::DxcDllSupport &DllSu
   }
   IFT(pResult->GetResult(&pContainerBlob));
 
-  VERIFY_SUCCEEDED(DllSupport.CreateInstance(CLSID_DxcContainerReflection, &containerReflection));
-  VERIFY_SUCCEEDED(containerReflection->Load(pContainerBlob));
-  VERIFY_SUCCEEDED(containerReflection->GetPartCount(&partCount));
+  IFT(DllSupport.CreateInstance(CLSID_DxcContainerReflection, &containerReflection));
+  IFT(containerReflection->Load(pContainerBlob));
+  IFT(containerReflection->GetPartCount(&partCount));
 
   for (uint32_t i = 0; i < partCount; ++i) {
     uint32_t kind;
-    VERIFY_SUCCEEDED(containerReflection->GetPartKind(i, &kind));
+    IFT(containerReflection->GetPartKind(i, &kind));
     if (kind == (uint32_t)hlsl::DxilFourCC::DFCC_DXIL) {
       blobFound = true;
       CComPtr<IDxcBlob> pPart;
       IFT(containerReflection->GetPartContent(i, &pPart));
       const hlsl::DxilProgramHeader *pProgramHeader =
         reinterpret_cast<const hlsl::DxilProgramHeader*>(pPart->GetBufferPointer());
-      VERIFY_IS_TRUE(IsValidDxilProgramHeader(pProgramHeader, (uint32_t)pPart->GetBufferSize()));
+      if (!IsValidDxilProgramHeader(pProgramHeader, (uint32_t)pPart->GetBufferSize()))
+        return FileRunCommandResult::Error("Invalid DXIL program header");
       hlsl::DXIL::ShaderKind SK = hlsl::GetVersionShaderType(pProgramHeader->ProgramVersion);
       if (SK == hlsl::DXIL::ShaderKind::Library)
-        VERIFY_SUCCEEDED(containerReflection->GetPartReflection(i, IID_PPV_ARGS(&pLibraryReflection)));
+        IFT(containerReflection->GetPartReflection(i, IID_PPV_ARGS(&pLibraryReflection)));
       else
-        VERIFY_SUCCEEDED(containerReflection->GetPartReflection(i, IID_PPV_ARGS(&pShaderReflection)));
+        IFT(containerReflection->GetPartReflection(i, IID_PPV_ARGS(&pShaderReflection)));
       break;
     }
   }
@@ -730,18 +731,16 @@ FileRunCommandResult FileRunCommandPart::RunTee(const FileRunCommandResult *Prio
     return FileRunCommandResult::Error("tee requires a prior command");
   }
 
-  // Ignore commands for now - simply log out through test framework.
-  {
-    CA2W outWide(Prior->StdOut.c_str(), CP_UTF8);
-    WEX::Logging::Log::Comment(outWide.m_psz);
-  }
+  // Ignore commands for now - simply hand the output to the caller to log
+  // through the test framework, since files may be run on worker threads.
+  FileRunCommandResult result = *Prior;
+  result.Log += Prior->StdOut;
   if (!Prior->StdErr.empty()) {
-    CA2W errWide(Prior->StdErr.c_str(), CP_UTF8);
-    WEX::Logging::Log::Comment(L"<stderr>");
-    WEX::Logging::Log::Comment(errWide.m_psz);
+    result.Log += "\n<stderr>\n";
+    result.Log += Prior->StdErr;
   }
 
-  return *Prior;
+  return result;
 }
 
 void FileRunCommandPart::SubstituteFilenameVars(std::string &args) {
@@ -802,30 +801,28 @@ FileRunCommandResult FileRunCommandPart::RunFileCompareText(const FileRunCommand
   SubstituteFilenameVars(fileName2);
 
   // read file content and compare
-  CA2W fileName1W(fileName1.c_str());
-  CA2W fileName2W(fileName2.c_str());
-  hlsl_test::LogCommentFmt(L"Comparing files %s and %s", fileName1W.m_psz, fileName2W.m_psz);
+  result.Log = "Comparing files " + fileName1 + " and " + fileName2 + "\n";
 
   std::ifstream ifs1(fileName1, std::ifstream::in);
   if (ifs1.fail()) {
-    hlsl_test::LogCommentFmt(L"Failed to open %s", fileName1W.m_psz);
+    result.Log += "Failed to open " + fileName1;
     return result;
   }
   std::string file1Content((std::istreambuf_iterator<char>(ifs1)), (std::istreambuf_iterator<char>()));
 
   std::ifstream ifs2(fileName2, std::ifstream::in);
   if (ifs2.fail()) {
-    hlsl_test::LogCommentFmt(L"Failed to open %s", fileName2W.m_psz);
+    result.Log += "Failed to open " + fileName2;
     return result;
   }
   std::string file2Content((std::istreambuf_iterator<char>(ifs2)), (std::istreambuf_iterator<char>()));
 
   if (file1Content.compare(file2Content) == 0) {
-    hlsl_test::LogCommentFmt(L"No differences found.");
+    result.Log += "No differences found.";
     result.ExitCode = 0;
   }
   else {
-    hlsl_test::LogCommentFmt(L"Files are different!");
+    result.Log += "Files are different!";
   }
   return result;
 }
@@ -972,6 +969,12 @@ class FileRunTestResultImpl : public FileRunTestResult {
     FileRunCommandResult* previousResult = nullptr;
     for (FileRunCommandPart & part : parts) {
       result = part.Run(m_support, previousResult, m_pPluginToolsPaths, dumpName);
+      if (!result.Log.empty()) {
+        if (!this->Log.empty())
+          this->Log += "\n";
+        this->Log += result.Log;
+        result.Log.clear();
+      }
       previousResult = &result;
       if (result.AbortPipeline) break;
     }
@@ -1306,6 +1306,9 @@ TEST_F(FileTest, AttributeMissingNumThreads) {
 TEST_F(FileTest, AttributeMissingNumThreadsLib) {
   runFileTest("attribute.numthreads.lib.missing.hlsl", Expect::Failure);
 }
+TEST_F(FileTest, LibParallelEntryPoints) {
+  runFileTest("spirv.lib.parallel-entry-points.hlsl");
+}
 TEST_F(FileTest, AttributeDomainTri) {
   runFileTest("attribute.domain.tri.hlsl");
 }
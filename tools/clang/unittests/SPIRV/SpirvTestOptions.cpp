@@ -19,6 +19,7 @@ namespace spirv {
 namespace testOptions {
 
 std::string inputDataDir = "";
+std::string benchmarkOutput = "";
 
 } // namespace testOptions
 } // namespace spirv
@@ -30,6 +30,10 @@ namespace testOptions {
 /// for the CodeGen test flow).
 extern std::string inputDataDir;
 
+/// \brief Command line option that specifies the file benchmarks write their
+/// results to. Benchmarks are skipped if it is not given.
+extern std::string benchmarkOutput;
+
 } // namespace testOptions
 } // namespace spirv
 } // namespace clang
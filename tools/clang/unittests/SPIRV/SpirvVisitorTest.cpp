@@ -0,0 +1,237 @@
+//===- unittests/SPIRV/SpirvVisitorTest.cpp ------ Visitor Tests ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "SpirvTestBase.h"
+#include "SpirvTestOptions.h"
+#include "clang/SPIRV/SpirvBuilder.h"
+#include "clang/SPIRV/SpirvInstruction.h"
+#include "clang/SPIRV/SpirvModule.h"
+#include "clang/SPIRV/SpirvVisitor.h"
+#include "gtest/gtest.h"
+
+using namespace clang::spirv;
+
+namespace {
+
+/// Records every instruction it is handed, and stops after the given number
+/// of instructions if a limit is set.
+class RecordingVisitor : public Visitor {
+public:
+  RecordingVisitor(const SpirvCodeGenOptions &opts, SpirvContext &ctx,
+                   size_t limit = 0)
+      : Visitor(opts, ctx), limit(limit), functions(0) {}
+
+  bool visit(SpirvModule *, Phase) override { return true; }
+  bool visit(SpirvFunction *, Phase phase) override {
+    if (phase == Phase::Init)
+      ++functions;
+    return true;
+  }
+  bool visit(SpirvBasicBlock *, Phase) override { return true; }
+
+  bool visitInstruction(SpirvInstruction *instr) override {
+    visited.push_back(instr);
+    return limit == 0 || visited.size() < limit;
+  }
+
+  const std::vector<SpirvInstruction *> &getVisited() const { return visited; }
+  unsigned getNumFunctions() const { return functions; }
+
+private:
+  size_t limit;
+  unsigned functions;
+  std::vector<SpirvInstruction *> visited;
+};
+
+/// Does a small amount of per-instruction work, like the lightweight
+/// propagation visitors run before emitting.
+class OpcodeSumVisitor : public Visitor {
+public:
+  OpcodeSumVisitor(const SpirvCodeGenOptions &opts, SpirvContext &ctx)
+      : Visitor(opts, ctx), sum(0) {}
+
+  bool visit(SpirvModule *, Phase) override { return true; }
+  bool visit(SpirvFunction *, Phase) override { return true; }
+  bool visit(SpirvBasicBlock *, Phase) override { return true; }
+
+  bool visitInstruction(SpirvInstruction *instr) override {
+    sum += static_cast<uint32_t>(instr->getopcode());
+    return true;
+  }
+
+  uint64_t getSum() const { return sum; }
+
+private:
+  uint64_t sum;
+};
+
+class SpirvVisitorTest : public SpirvTestBase {
+public:
+  SpirvVisitorTest()
+      : spirvOptions(), spirvBuilder(getAstContext(), getSpirvContext(),
+                                     spirvOptions) {}
+
+  const SpirvCodeGenOptions &getOptions() const { return spirvOptions; }
+
+  /// Builds a module with the given number of functions, each holding a
+  /// chain of the given number of integer additions.
+  SpirvModule *buildModule(unsigned numFunctions, unsigned numInstructions) {
+    clang::ASTContext &astContext = getAstContext();
+    spirvBuilder.setMemoryModel(spv::AddressingModel::Logical,
+                                spv::MemoryModel::GLSL450);
+    SpirvInstruction *one =
+        spirvBuilder.getConstantInt(astContext.IntTy, llvm::APInt(32, 1));
+    for (unsigned f = 0; f < numFunctions; ++f) {
+      spirvBuilder.beginFunction(astContext.VoidTy, {});
+      spirvBuilder.setInsertPoint(spirvBuilder.createBasicBlock());
+      SpirvInstruction *value = one;
+      for (unsigned i = 0; i < numInstructions; ++i)
+        value = spirvBuilder.createBinaryOp(spv::Op::OpIAdd, astContext.IntTy,
+                                            value, one, {});
+      spirvBuilder.createReturn({});
+      spirvBuilder.endFunction();
+    }
+    return spirvBuilder.getModule();
+  }
+
+private:
+  SpirvCodeGenOptions spirvOptions;
+  SpirvBuilder spirvBuilder;
+};
+
+TEST_F(SpirvVisitorTest, CompositeVisitorMatchesSeparateWalks) {
+  SpirvContext &context = getSpirvContext();
+  SpirvModule *mod = buildModule(3, 4);
+
+  RecordingVisitor separate1(getOptions(), context);
+  RecordingVisitor separate2(getOptions(), context);
+  mod->invokeVisitor(&separate1);
+  mod->invokeVisitor(&separate2);
+
+  RecordingVisitor combined1(getOptions(), context);
+  RecordingVisitor combined2(getOptions(), context);
+  CompositeVisitor composite(getOptions(), context, {&combined1, &combined2});
+  EXPECT_TRUE(mod->invokeVisitor(&composite));
+
+  EXPECT_EQ(combined1.getVisited(), separate1.getVisited());
+  EXPECT_EQ(combined2.getVisited(), separate2.getVisited());
+  EXPECT_EQ(combined1.getNumFunctions(), 3u);
+  EXPECT_EQ(combined2.getNumFunctions(), 3u);
+
+  // Reverse walks are forwarded in the same order as well.
+  RecordingVisitor reverseSeparate(getOptions(), context);
+  mod->invokeVisitor(&reverseSeparate, true);
+  RecordingVisitor reverseCombined(getOptions(), context);
+  CompositeVisitor reverseComposite(getOptions(), context, {&reverseCombined});
+  mod->invokeVisitor(&reverseComposite, true);
+  EXPECT_EQ(reverseCombined.getVisited(), reverseSeparate.getVisited());
+}
+
+TEST_F(SpirvVisitorTest, CompositeVisitorDropsStoppedVisitors) {
+  SpirvContext &context = getSpirvContext();
+  SpirvModule *mod = buildModule(2, 8);
+
+  RecordingVisitor full(getOptions(), context);
+  mod->invokeVisitor(&full);
+
+  RecordingVisitor stopping(getOptions(), context, 5);
+  RecordingVisitor continuing(getOptions(), context);
+  CompositeVisitor composite(getOptions(), context, {&stopping, &continuing});
+  EXPECT_TRUE(mod->invokeVisitor(&composite));
+  EXPECT_EQ(stopping.getVisited().size(), 5u);
+  EXPECT_EQ(continuing.getVisited(), full.getVisited());
+
+  // The walk stops once every visitor has.
+  RecordingVisitor onlyStopping(getOptions(), context, 5);
+  CompositeVisitor stoppingComposite(getOptions(), context, {&onlyStopping});
+  EXPECT_FALSE(mod->invokeVisitor(&stoppingComposite));
+  EXPECT_EQ(onlyStopping.getVisited().size(), 5u);
+}
+
+TEST_F(SpirvVisitorTest, CompositeVisitorSumsMatchSeparateWalks) {
+  const unsigned kNumVisitors = 5;
+
+  SpirvContext &context = getSpirvContext();
+  SpirvModule *mod = buildModule(4, 64);
+
+  std::vector<std::unique_ptr<OpcodeSumVisitor>> separateVisitors;
+  std::vector<std::unique_ptr<OpcodeSumVisitor>> combinedVisitors;
+  std::vector<Visitor *> subVisitors;
+  for (unsigned i = 0; i < kNumVisitors; ++i) {
+    separateVisitors.emplace_back(new OpcodeSumVisitor(getOptions(), context));
+    combinedVisitors.emplace_back(new OpcodeSumVisitor(getOptions(), context));
+    subVisitors.push_back(combinedVisitors.back().get());
+  }
+
+  for (auto &visitor : separateVisitors)
+    mod->invokeVisitor(visitor.get());
+  CompositeVisitor composite(getOptions(), context, subVisitors);
+  mod->invokeVisitor(&composite);
+
+  for (unsigned i = 0; i < kNumVisitors; ++i)
+    EXPECT_EQ(combinedVisitors[i]->getSum(), separateVisitors[i]->getSum());
+}
+
+TEST_F(SpirvVisitorTest, BenchmarkSeparateAndCompositeWalks) {
+  // Only runs when --spirv-benchmark-output names a file to append the
+  // results to, as one line of comma-separated fields.
+  if (testOptions::benchmarkOutput.empty())
+    return;
+
+  typedef std::chrono::steady_clock Clock;
+  const unsigned kIterations = 10;
+  const unsigned kNumVisitors = 5;
+  const unsigned kNumFunctions = 64;
+
+  SpirvContext &context = getSpirvContext();
+  SpirvModule *mod = buildModule(kNumFunctions, 2048);
+
+  Clock::duration separate = Clock::duration::zero();
+  Clock::duration combined = Clock::duration::zero();
+  for (unsigned iter = 0; iter < kIterations; ++iter) {
+    std::vector<std::unique_ptr<OpcodeSumVisitor>> separateVisitors;
+    std::vector<std::unique_ptr<OpcodeSumVisitor>> combinedVisitors;
+    std::vector<Visitor *> subVisitors;
+    for (unsigned i = 0; i < kNumVisitors; ++i) {
+      separateVisitors.emplace_back(
+          new OpcodeSumVisitor(getOptions(), context));
+      combinedVisitors.emplace_back(
+          new OpcodeSumVisitor(getOptions(), context));
+      subVisitors.push_back(combinedVisitors.back().get());
+    }
+
+    Clock::time_point start = Clock::now();
+    for (auto &visitor : separateVisitors)
+      mod->invokeVisitor(visitor.get());
+    separate += Clock::now() - start;
+
+    start = Clock::now();
+    CompositeVisitor composite(getOptions(), context, subVisitors);
+    mod->invokeVisitor(&composite);
+    combined += Clock::now() - start;
+  }
+
+  std::ofstream csv(testOptions::benchmarkOutput, std::ios::app);
+  ASSERT_TRUE(csv.is_open());
+  csv << "SpirvVisitorTest.BenchmarkSeparateAndCompositeWalks,visitors="
+      << kNumVisitors << ",functions=" << kNumFunctions << ",separate_ms="
+      << std::chrono::duration<double, std::milli>(separate).count() /
+             kIterations
+      << ",composite_ms="
+      << std::chrono::duration<double, std::milli>(combined).count() /
+             kIterations
+      << "\n";
+}
+
+} // anonymous namespace
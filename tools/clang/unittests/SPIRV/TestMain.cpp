@@ -107,6 +107,14 @@ int main(int argc, char **argv) {
         fprintf(stderr, "Error: --spirv-test-root requires an argument\n");
         return 1;
       }
+    } else if (std::string("--spirv-benchmark-output") == argv[i]) {
+      if (i + 1 < argc) {
+        clang::spirv::testOptions::benchmarkOutput = argv[++i];
+      } else {
+        fprintf(stderr,
+                "Error: --spirv-benchmark-output requires an argument\n");
+        return 1;
+      }
     }
   }
 
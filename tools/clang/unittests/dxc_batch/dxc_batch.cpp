@@ -33,6 +33,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <comdef.h>
 #include <thread>
@@ -780,27 +781,26 @@ int DxcBatchContext::BatchCompile(bool bMultiThread, bool bLibLink) {
   if (bMultiThread) {
     unsigned int threadNum = std::min<unsigned>(
         std::thread::hardware_concurrency(), commands.size());
-    auto empty_fn = []() {};
     std::vector<std::thread> threads(threadNum);
     std::vector<std::string> errorStrings(threadNum);
+    // Each thread takes the next command when it finishes one, so a few slow
+    // commands do not leave the other threads idle.
+    std::atomic<unsigned> nextCommand(0);
+    auto worker = [&](unsigned threadIdx) {
+      for (unsigned i = nextCommand++; i < commands.size();
+           i = nextCommand++) {
+        // trim to remove /r if exist.
+        llvm::StringRef command = commands[i].trim();
+        if (command.empty())
+          continue;
+        if (command.startswith("//"))
+          continue;
+        ::Compile(command, m_dxcSupport, path.str(), bLibLink,
+                  errorStrings[threadIdx]);
+      }
+    };
     for (unsigned i = 0; i < threadNum; i++)
-      threads[i] = std::thread(empty_fn);
-
-    for (unsigned i = 0; i < commands.size(); i++) {
-      // trim to remove /r if exist.
-      llvm::StringRef command = commands[i].trim();
-      if (command.empty())
-        continue;
-      if (command.startswith("//"))
-        continue;
-
-      unsigned threadIdx = i % threadNum;
-      threads[threadIdx].join();
-
-      threads[threadIdx] = std::thread(
-          ::Compile, command, std::ref(m_dxcSupport), path.str(), bLibLink,
-                     std::ref(errorStrings[threadIdx]));
-    }
+      threads[i] = std::thread(worker, i);
     for (auto &th : threads)
       th.join();
 
@@ -450,4 +450,18 @@ TEST_F(CloneModule, Verify) {
   EXPECT_FALSE(verifyModule(*NewM));
 }
 
+// HLSL Change Starts
+TEST_F(CloneModule, SkipDefinitions) {
+  ValueToValueMapTy VMap;
+  std::unique_ptr<Module> DeclM(
+      llvm::CloneModule(OldM, VMap, [](const Function *) { return false; }));
+  Function *F = DeclM->getFunction("f");
+  ASSERT_TRUE(F != nullptr);
+  EXPECT_TRUE(F->isDeclaration());
+  EXPECT_TRUE(F->hasExternalLinkage());
+  EXPECT_FALSE(F->hasPersonalityFn());
+  EXPECT_FALSE(verifyModule(*DeclM));
+}
+// HLSL Change Ends
+
 }
@@ -672,26 +672,49 @@ def get_hlsl_intrinsic_stats():
     result += "static const int g_MaxIntrinsicParamCount = %d; // Count of parameters (without return) for longest intrinsic argument list - '%s'\n" % (len(longest_arglist_fn.params) - 1, longest_arglist_fn.name)
     return result
 
+def get_hlsl_intrinsic_name_ranges(ns, names):
+    # Entries that share a name are adjacent in the table, since the table is
+    # sorted by key; index each name by its first entry and entry count, in
+    # strcmp order so the names can be binary searched.
+    ranges = {}
+    for idx, name in enumerate(names):
+        if name in ranges:
+            first, count = ranges[name]
+            assert first + count == idx, "entries for %s.%s are not adjacent" % (ns, name)
+            ranges[name] = (first, count + 1)
+        else:
+            ranges[name] = (idx, 1)
+    result = "static const HLSL_INTRINSIC_NAME_RANGE g_%s_Names[] =\n{\n" % (ns)
+    for name in sorted(ranges.keys()):
+        result += "    {\"%s\", %d, %d},\n" % (name, ranges[name][0], ranges[name][1])
+    result += "};\n"
+    return result
+
 def get_hlsl_intrinsics():
     db = get_db_hlsl()
     result = ""
     last_ns = ""
     ns_table = ""
+    ns_names = []
+    all_ns = []
     is_vk_table = False  # SPIRV Change
     id_prefix = ""
     arg_idx = 0
     opcode_namespace = db.opcode_namespace
     for i in sorted(db.intrinsics, key=lambda x: x.key):
         if last_ns != i.ns:
-            last_ns = i.ns
-            id_prefix = "IOP" if last_ns == "Intrinsics" or last_ns == "VkIntrinsics" else "MOP" # SPIRV Change
             if (len(ns_table)):
-                result += ns_table + "};\n"
+                result += ns_table + "};\n\n"
+                result += get_hlsl_intrinsic_name_ranges(last_ns, ns_names)
                 # SPIRV Change Starts
                 if is_vk_table:
                     result += "\n#endif // ENABLE_SPIRV_CODEGEN\n"
                     is_vk_table = False
                 # SPIRV Change Ends
+            last_ns = i.ns
+            id_prefix = "IOP" if last_ns == "Intrinsics" or last_ns == "VkIntrinsics" else "MOP" # SPIRV Change
+            all_ns.append((last_ns, i.vulkanSpecific))
+            ns_names = []
             result += "\n//\n// Start of %s\n//\n\n" % (last_ns)
             # This used to be qualified as __declspec(selectany), but that's no longer necessary.
             ns_table = "static const HLSL_INTRINSIC g_%s[] =\n{\n" % (last_ns)
@@ -709,13 +732,23 @@ def get_hlsl_intrinsics():
                 # First parameter defines intrinsic name for parsing in HLSL.
                 # Prepend '$hidden$' for hidden intrinsic so it can't be used in HLSL.
                 name = "$hidden$" + name
+            if p is i.params[0]:
+                ns_names.append(name)
             result += "    {\"%s\", %s, %s, %s, %s, %s, %s, %s},\n" % (
                 name, p.param_qual, p.template_id, p.template_list,
                 p.component_id, p.component_list, p.rows, p.cols)
         result += "};\n\n"
         arg_idx += 1
-    result += ns_table + "};\n"
+    result += ns_table + "};\n\n"
+    result += get_hlsl_intrinsic_name_ranges(last_ns, ns_names)
     result += "\n#endif // ENABLE_SPIRV_CODEGEN\n" if is_vk_table else ""  # SPIRV Change
+
+    # Map each table to its name index.
+    result += "\nstatic const HLSL_INTRINSIC_NAME_INDEX g_IntrinsicNameIndexes[] =\n{\n"
+    for ns, vk in all_ns:
+        entry = "    {g_%s, g_%s_Names, _countof(g_%s_Names)},\n" % (ns, ns, ns)
+        result += ("#ifdef ENABLE_SPIRV_CODEGEN\n" + entry + "#endif // ENABLE_SPIRV_CODEGEN\n") if vk else entry
+    result += "};\n"
     return result
 
 # SPIRV Change Starts
@@ -164,6 +164,12 @@ if "%1"=="-clean" (
 ) else if "%1"=="-file-check-dump" (
   set ADDITIONAL_OPTS=%ADDITIONAL_OPTS% /p:"FileCheckDumpDir=%~2\HLSL"
   shift /1
+) else if "%1"=="-file-check-threads" (
+  set ADDITIONAL_OPTS=%ADDITIONAL_OPTS% /p:"FileCheckThreads=%~2"
+  shift /1
+) else if "%1"=="-file-check-shard" (
+  set ADDITIONAL_OPTS=%ADDITIONAL_OPTS% /p:"FileCheckShard=%~2"
+  shift /1
 ) else if "%1"=="-dxil-loc" (
   set DXIL_DLL_LOC=%~2
   shift /1
@@ -393,6 +399,8 @@ echo   -custom-bin-set "file [file]..." - custom set of binaries to copy into te
 echo   -dxilconv-loc "dxilconv.dll location" - fetch dxilconv.dll from custom location
 echo   -dxil-loc "dxil.dll location" - fetch dxil.dll from provided location
 echo   -file-check-dump "dump-path" - dump file-check inputs to files under dump-path
+echo   -file-check-threads N - run batch file-check tests on N threads (default: one per core)
+echo   -file-check-shard I/N - run only shard I of N (0-based) of each batch file-check directory
 echo.
 echo current BUILD_ARCH=%BUILD_ARCH%.  Override with:
 echo   -x86 targets an x86 build (aka. Win32)